@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <srf/memory/core/block_manager.hpp>
+#include <srf/memory/core/concurrent_block_manager.hpp>
+#include <srf/memory/core/memory_block.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace srf::memory;
+
+namespace {
+
+constexpr std::size_t block_bytes = 256;  // NOLINT
+
+// address lookup strategy of the previous block_manager: a map keyed on the end address of each block
+class MapBlockManager
+{
+  public:
+    void add_block(memory_block&& block)
+    {
+        auto key = reinterpret_cast<std::uintptr_t>(block.data()) + block.bytes();
+        m_blocks.emplace(key, std::move(block));
+    }
+
+    const memory_block* find_block(const void* ptr) const
+    {
+        auto search = m_blocks.upper_bound(reinterpret_cast<std::uintptr_t>(ptr));
+        if (search != m_blocks.end() && search->second.contains(const_cast<void*>(ptr)))
+        {
+            return &search->second;
+        }
+        return nullptr;
+    }
+
+  private:
+    std::map<std::uintptr_t, memory_block> m_blocks;
+};
+
+// every other block of the arena is registered; probes are random interior addresses of registered blocks
+struct LookupFixture
+{
+    LookupFixture(std::size_t block_count) : arena(block_bytes * block_count * 2)
+    {
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<std::size_t> block_dist(0, block_count - 1);
+        std::uniform_int_distribution<std::size_t> offset_dist(0, block_bytes - 1);
+
+        probes.reserve(4096);
+        for (int i = 0; i < 4096; i++)
+        {
+            probes.push_back(arena.data() + block_dist(rng) * 2 * block_bytes + offset_dist(rng));
+        }
+    }
+
+    template <typename ManagerT>
+    void fill(ManagerT& manager, std::size_t block_count)
+    {
+        for (std::size_t i = 0; i < block_count; i++)
+        {
+            manager.add_block(memory_block(arena.data() + i * 2 * block_bytes, block_bytes));
+        }
+    }
+
+    std::vector<std::byte> arena;
+    std::vector<const void*> probes;
+};
+
+template <typename ManagerT>
+void run_lookups(benchmark::State& state, const ManagerT& manager, const std::vector<const void*>& probes)
+{
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(manager.find_block(probes[i++ & (probes.size() - 1)]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+static void block_manager_map_lookup(benchmark::State& state)
+{
+    LookupFixture fixture(state.range(0));
+    MapBlockManager manager;
+    fixture.fill(manager, state.range(0));
+    run_lookups(state, manager, fixture.probes);
+}
+
+static void block_manager_lookup(benchmark::State& state)
+{
+    LookupFixture fixture(state.range(0));
+    block_manager<memory_block> manager;
+    fixture.fill(manager, state.range(0));
+    run_lookups(state, manager, fixture.probes);
+}
+
+static void concurrent_block_manager_lookup(benchmark::State& state)
+{
+    LookupFixture fixture(state.range(0));
+    concurrent_block_manager<memory_block> manager;
+    fixture.fill(manager, state.range(0));
+    run_lookups(state, manager, fixture.probes);
+}
+
+BENCHMARK(block_manager_map_lookup)->Arg(100)->Arg(10000)->Arg(1000000);
+BENCHMARK(block_manager_lookup)->Arg(100)->Arg(10000)->Arg(1000000);
+BENCHMARK(concurrent_block_manager_lookup)->Arg(100)->Arg(10000)->Arg(1000000);
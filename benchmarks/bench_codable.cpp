@@ -0,0 +1,467 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <srf/protos/codable.pb.h>
+#include <srf/codable/decode.hpp>
+#include <srf/codable/encode.hpp>
+#include <srf/codable/encoded_object.hpp>
+#include <srf/codable/encoding_options.hpp>
+#include <srf/codable/fundamental_types.hpp>
+#include <srf/codable/memory_resources.hpp>
+#include <srf/codable/protobuf_message.hpp>
+#include <srf/memory/adaptors.hpp>
+#include <srf/memory/resources/host/malloc_memory_resource.hpp>
+#include <srf/memory/resources/statistics_resource.hpp>
+#include <srf/utils/thread_local_shared_pointer.hpp>
+
+#include <benchmark/benchmark.h>
+#include <google/protobuf/arena.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+using namespace srf;
+
+namespace {
+
+// every allocation made through the global operator new by any code in this executable
+std::atomic<std::uint64_t> s_heap_allocations{0};  // NOLINT
+
+}  // namespace
+
+// bench_codable is its own executable, so replacing the global allocation functions only affects these benchmarks
+void* operator new(std::size_t bytes)
+{
+    s_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(bytes == 0 ? 1 : bytes))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t bytes)
+{
+    return ::operator new(bytes);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*bytes*/) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*bytes*/) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+
+// payload sizes from 8 B to 64 MiB
+constexpr std::int64_t min_bytes  = 8;          // NOLINT
+constexpr std::int64_t max_bytes  = 64L << 20;  // NOLINT
+constexpr int bytes_multiplier    = 8;          // NOLINT
+constexpr std::size_t eager_bytes = 64;         // NOLINT
+
+using counting_resource_t = memory::statistics_resource<std::shared_ptr<memory::malloc_memory_resource>>;
+
+// codable::MemoryResources whose host allocations are counted; device memory is not exercised
+class CountingMemoryResources final : public codable::MemoryResources
+{
+  public:
+    CountingMemoryResources() :
+      m_host(memory::make_shared_resource<memory::statistics_resource>(
+          std::make_shared<memory::malloc_memory_resource>())),
+      m_host_view(m_host)
+    {}
+
+    host_view_t host_resource_view() final
+    {
+        return m_host_view;
+    }
+
+    device_view_t device_resource_view() final
+    {
+        throw std::runtime_error("bench_codable does not use device memory");
+    }
+
+    std::uint64_t allocations() const
+    {
+        return m_host->statistics().allocations;
+    }
+
+  private:
+    std::shared_ptr<counting_resource_t> m_host;
+    host_view_t m_host_view;
+};
+
+/**
+ * @brief Installs counting memory resources on the benchmark thread and reports throughput and allocations per op
+ *
+ * heap_allocs_per_op counts calls to the global operator new, e.g. protobuf messages, std::string and shared state;
+ * resource_allocs_per_op counts the host allocations made through codable::MemoryResources, i.e. the buffers backing
+ * encoded and decompressed blocks, which do not go through operator new.
+ */
+class CodableBench
+{
+  public:
+    CodableBench() : m_resources(std::make_shared<CountingMemoryResources>())
+    {
+        utils::ThreadLocalSharedPointer<codable::MemoryResources>::set(m_resources);
+    }
+
+    ~CodableBench()
+    {
+        utils::ThreadLocalSharedPointer<codable::MemoryResources>::set(nullptr);
+    }
+
+    // call immediately before the timed loop
+    void start()
+    {
+        m_allocations      = m_resources->allocations();
+        m_heap_allocations = s_heap_allocations.load(std::memory_order_relaxed);
+    }
+
+    // call immediately after the timed loop
+    void report(benchmark::State& state, std::size_t bytes_per_op)
+    {
+        auto heap_allocations = s_heap_allocations.load(std::memory_order_relaxed) - m_heap_allocations;
+        auto allocations      = m_resources->allocations() - m_allocations;
+        if (bytes_per_op > 0)
+        {
+            state.SetBytesProcessed(state.iterations() * bytes_per_op);
+        }
+        state.counters["heap_allocs_per_op"] = benchmark::Counter(heap_allocations, benchmark::Counter::kAvgIterations);
+        state.counters["resource_allocs_per_op"] =
+            benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+    }
+
+  private:
+    std::shared_ptr<CountingMemoryResources> m_resources;
+    std::uint64_t m_allocations{0};
+    std::uint64_t m_heap_allocations{0};
+};
+
+// a control-plane style message of roughly bytes, built from small eager descriptors
+codable::protos::EncodedObject make_message(std::size_t bytes)
+{
+    codable::protos::EncodedObject msg;
+    std::string data(eager_bytes, 'x');
+    for (std::size_t i = 0; i < std::max<std::size_t>(bytes / eager_bytes, 1); i++)
+    {
+        auto* desc = msg.add_descriptors()->mutable_eager_desc();
+        desc->set_data(data);
+        desc->set_memory_kind(codable::protos::MemoryKind::Host);
+    }
+    return msg;
+}
+
+}  // namespace
+
+static void codable_encode_double(benchmark::State& state)
+{
+    CodableBench bench;
+    double value = 3.14159;
+
+    bench.start();
+    for (auto _ : state)
+    {
+        auto encoded = codable::encode(value);
+        benchmark::DoNotOptimize(encoded);
+    }
+    bench.report(state, sizeof(value));
+}
+
+static void codable_decode_double(benchmark::State& state)
+{
+    CodableBench bench;
+    auto encoded = codable::encode(3.14159);
+
+    bench.start();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(codable::decode<double>(*encoded));
+    }
+    bench.report(state, sizeof(double));
+}
+
+static void codable_encode_string_copy(benchmark::State& state)
+{
+    CodableBench bench;
+    std::string str(state.range(0), 'x');
+    codable::EncodingOptions opts;
+    opts.set_force_copy(true);
+
+    bench.start();
+    for (auto _ : state)
+    {
+        auto encoded = codable::encode(str, opts);
+        benchmark::DoNotOptimize(encoded);
+    }
+    bench.report(state, str.size());
+}
+
+static void codable_encode_string_zero_copy(benchmark::State& state)
+{
+    CodableBench bench;
+    std::string str(state.range(0), 'x');
+
+    bench.start();
+    for (auto _ : state)
+    {
+        auto encoded = codable::encode(str);
+        benchmark::DoNotOptimize(encoded);
+    }
+    bench.report(state, str.size());
+}
+
+static void codable_decode_string(benchmark::State& state)
+{
+    CodableBench bench;
+    std::string str(state.range(0), 'x');
+    auto encoded = codable::encode(str);
+
+    bench.start();
+    for (auto _ : state)
+    {
+        auto decoded = codable::decode<std::string>(*encoded);
+        benchmark::DoNotOptimize(decoded);
+    }
+    bench.report(state, str.size());
+}
+
+static void codable_encode_protobuf(benchmark::State& state)
+{
+    CodableBench bench;
+    auto msg = make_message(state.range(0));
+
+    bench.start();
+    for (auto _ : state)
+    {
+        auto encoded = codable::encode(msg);
+        benchmark::DoNotOptimize(encoded);
+    }
+    bench.report(state, msg.ByteSizeLong());
+}
+
+static void codable_decode_protobuf(benchmark::State& state)
+{
+    CodableBench bench;
+    auto msg     = make_message(state.range(0));
+    auto encoded = codable::encode(msg);
+
+    bench.start();
+    for (auto _ : state)
+    {
+        auto decoded = codable::decode<codable::protos::EncodedObject>(*encoded);
+        benchmark::DoNotOptimize(decoded);
+    }
+    bench.report(state, msg.ByteSizeLong());
+}
+
+static void codable_decode_protobuf_arena(benchmark::State& state)
+{
+    CodableBench bench;
+    auto msg     = make_message(state.range(0));
+    auto encoded = codable::encode(msg);
+
+    bench.start();
+    for (auto _ : state)
+    {
+        google::protobuf::Arena arena;
+        benchmark::DoNotOptimize(codable::decode<codable::protos::EncodedObject>(*encoded, arena));
+    }
+    bench.report(state, msg.ByteSizeLong());
+}
+
+// range(0) objects, alternating doubles and 4 KiB strings, encoded into a single EncodedObject
+static void codable_encode_multi_object(benchmark::State& state)
+{
+    CodableBench bench;
+    double value = 3.14159;
+    std::string str(4096, 'x');
+    std::size_t bytes_per_op = 0;
+
+    bench.start();
+    for (auto _ : state)
+    {
+        codable::EncodedObject encoded;
+        for (std::int64_t i = 0; i < state.range(0); i++)
+        {
+            if (i % 2 == 0)
+            {
+                codable::encode(value, encoded);
+            }
+            else
+            {
+                codable::encode(str, encoded);
+            }
+        }
+        benchmark::DoNotOptimize(encoded);
+    }
+
+    for (std::int64_t i = 0; i < state.range(0); i++)
+    {
+        bytes_per_op += (i % 2 == 0 ? sizeof(value) : str.size());
+    }
+    bench.report(state, bytes_per_op);
+}
+
+static void codable_decode_multi_object(benchmark::State& state)
+{
+    CodableBench bench;
+    double value = 3.14159;
+    std::string str(4096, 'x');
+    std::size_t bytes_per_op = 0;
+
+    codable::EncodedObject encoded;
+    for (std::int64_t i = 0; i < state.range(0); i++)
+    {
+        if (i % 2 == 0)
+        {
+            codable::encode(value, encoded);
+            bytes_per_op += sizeof(value);
+        }
+        else
+        {
+            codable::encode(str, encoded);
+            bytes_per_op += str.size();
+        }
+    }
+
+    bench.start();
+    for (auto _ : state)
+    {
+        for (std::int64_t i = 0; i < state.range(0); i++)
+        {
+            if (i % 2 == 0)
+            {
+                benchmark::DoNotOptimize(codable::decode<double>(encoded, i));
+            }
+            else
+            {
+                auto decoded = codable::decode<std::string>(encoded, i);
+                benchmark::DoNotOptimize(decoded);
+            }
+        }
+    }
+    bench.report(state, bytes_per_op);
+}
+
+// construction of an EncodedObject on a recycled arena (range(0) == 1) or on the heap (range(0) == 0)
+static void codable_encoded_object_construct(benchmark::State& state)
+{
+    CodableBench bench;
+
+    bench.start();
+    for (auto _ : state)
+    {
+        if (state.range(0) != 0)
+        {
+            codable::EncodedObject encoded;
+            benchmark::DoNotOptimize(encoded);
+        }
+        else
+        {
+            codable::EncodedObject encoded(std::shared_ptr<google::protobuf::Arena>(nullptr));
+            benchmark::DoNotOptimize(encoded);
+        }
+    }
+    bench.report(state, 0);
+}
+
+// serialization of the protos::EncodedObject of range(0) objects, as performed by the data plane for each send
+static void codable_proto_serialize(benchmark::State& state)
+{
+    CodableBench bench;
+    double value = 3.14159;
+    std::string str(4096, 'x');
+
+    codable::EncodedObject encoded;
+    for (std::int64_t i = 0; i < state.range(0); i++)
+    {
+        codable::encode(value, encoded);
+        codable::encode(str, encoded);
+    }
+
+    const auto& proto = encoded.proto();
+    std::string buffer;
+
+    bench.start();
+    for (auto _ : state)
+    {
+        proto.SerializeToString(&buffer);
+        benchmark::DoNotOptimize(buffer);
+    }
+    bench.report(state, proto.ByteSizeLong());
+}
+
+static void codable_proto_parse(benchmark::State& state)
+{
+    CodableBench bench;
+    double value = 3.14159;
+    std::string str(4096, 'x');
+
+    codable::EncodedObject encoded;
+    for (std::int64_t i = 0; i < state.range(0); i++)
+    {
+        codable::encode(value, encoded);
+        codable::encode(str, encoded);
+    }
+
+    auto buffer = encoded.proto().SerializeAsString();
+
+    bench.start();
+    for (auto _ : state)
+    {
+        codable::protos::EncodedObject proto;
+        benchmark::DoNotOptimize(proto.ParseFromString(buffer));
+    }
+    bench.report(state, buffer.size());
+}
+
+BENCHMARK(codable_encode_double);
+BENCHMARK(codable_decode_double);
+BENCHMARK(codable_encode_string_copy)->RangeMultiplier(bytes_multiplier)->Range(min_bytes, max_bytes);
+BENCHMARK(codable_encode_string_zero_copy)->RangeMultiplier(bytes_multiplier)->Range(min_bytes, max_bytes);
+BENCHMARK(codable_decode_string)->RangeMultiplier(bytes_multiplier)->Range(min_bytes, max_bytes);
+BENCHMARK(codable_encode_protobuf)->RangeMultiplier(bytes_multiplier)->Range(eager_bytes, max_bytes);
+BENCHMARK(codable_decode_protobuf)->RangeMultiplier(bytes_multiplier)->Range(eager_bytes, max_bytes);
+BENCHMARK(codable_decode_protobuf_arena)->RangeMultiplier(bytes_multiplier)->Range(eager_bytes, max_bytes);
+BENCHMARK(codable_encode_multi_object)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(codable_decode_multi_object)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(codable_encoded_object_construct)->Arg(0)->Arg(1);
+BENCHMARK(codable_proto_serialize)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(codable_proto_parse)->RangeMultiplier(4)->Range(1, 256);
@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 
+#include <srf/benchmarking/latency_histogram.hpp>
+#include <srf/benchmarking/load_generator.hpp>
 #include <srf/benchmarking/segment_watcher.hpp>
 #include <srf/benchmarking/tracer.hpp>
 #include <srf/benchmarking/util.hpp>
@@ -42,6 +44,7 @@
 #include <algorithm>  // IWYU pragma: keep
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -412,3 +415,73 @@ BENCHMARK_F(SegmentLongComponentRawLatency, long_pipeline_component_latency)(ben
     }
     add_state_counters(m_watcher->aggregate_tracers(), state);
 }
+
+/** Open-loop latency **/
+
+/**
+ * @brief Drive a src->n1->sink segment with an open-loop source. Latency is measured at the sink from each sample's
+ * intended send time, so queueing delay behind the pipeline is included rather than hidden by a source which waits
+ * for capacity (coordinated omission).
+ */
+static void run_open_loop_segment(const LoadProfile& profile, LatencyRecorder& recorder)
+{
+    auto init = [&profile, &recorder](segment::Builder& segment) {
+        auto src = segment.make_source<OpenLoopSample>("nsrc", create_open_loop_source(profile));
+
+        auto internal = segment.make_node<OpenLoopSample, OpenLoopSample>(
+            "n1", rxcpp::operators::map([](OpenLoopSample sample) { return sample; }));
+        segment.make_edge(src, internal);
+
+        auto sink = segment.make_sink<OpenLoopSample>(
+            "nsink", [&recorder](OpenLoopSample sample) { recorder.record(sample); }, []() {});
+        segment.make_edge(internal, sink);
+    };
+
+    auto pipeline = pipeline::make_pipeline();
+    auto segment  = pipeline->make_segment("bench_open_loop_segment", init);
+
+    Executor executor;
+    executor.register_pipeline(std::move(pipeline));
+    executor.start();
+    executor.join();
+}
+
+/**
+ * @brief Latency-vs-throughput curve collected by sweep_offered_load; range(0) selects constant (0) or Poisson (1)
+ * arrivals. Every offered rate sends the same number of samples, so the low rates dominate the run time. The full
+ * curve is written to stderr as json and the per-rate p99 and achieved rate are reported as counters.
+ *
+ * The pipeline is idle between arrivals at the lowest offered rate, so a p99 above LowRateP99Limit there indicates
+ * that the source or the engine is delaying samples and the benchmark reports an error.
+ */
+static void segment_open_loop_latency(benchmark::State& state)
+{
+    constexpr std::chrono::milliseconds LowRateP99Limit{10};
+    const std::vector<double> offered_rates = {1000, 10000, 50000, 100000, 250000, 500000, 1000000};
+
+    LoadProfile base;
+    base.arrival = state.range(0) == 0 ? ArrivalProcess::Constant : ArrivalProcess::Poisson;
+    base.count   = 5000;
+
+    std::vector<LoadPoint> curve;
+    for (auto _ : state)
+    {
+        curve = sweep_offered_load(base, offered_rates, run_open_loop_segment);
+    }
+
+    for (const auto& point : curve)
+    {
+        auto rate = std::to_string(static_cast<std::int64_t>(point.offered_rate));
+        state.counters["achieved_rate@" + rate] = point.achieved_rate;
+        state.counters["p99_seconds@" + rate]   = point.histogram.value_at_percentile(99.0) * TimeUtil::NsToSec;
+    }
+
+    std::cerr << to_json(curve).dump(2) << std::endl;
+
+    if (!curve.empty() && std::chrono::nanoseconds(curve.front().histogram.value_at_percentile(99.0)) > LowRateP99Limit)
+    {
+        state.SkipWithError("p99 latency at the lowest offered rate exceeds LowRateP99Limit");
+    }
+}
+
+BENCHMARK(segment_open_loop_latency)->Arg(0)->Arg(1)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -138,6 +138,12 @@ rapids_find_package(nlohmann_json REQUIRED
     CONFIG
 )
 
+# lz4 and zstd
+# ============
+# - private dependencies used to compress codable payloads, see cmake/Findlz4.cmake and cmake/Findzstd.cmake
+find_package(lz4 REQUIRED)
+find_package(zstd REQUIRED)
+
 # prometheus
 # =========
 set(PROMETHEUS_CPP_VERSION "1.0.0" CACHE STRING "Version of Prometheus-cpp to use")
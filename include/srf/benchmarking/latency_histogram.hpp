@@ -0,0 +1,94 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace srf::benchmarking {
+
+/**
+ * @brief High dynamic range latency histogram with nanosecond values.
+ *
+ * Values are bucketed log-linearly: each power-of-two range is split into 2^(sub_bucket_bits - 1) linear sub-buckets,
+ * so the relative error of any reported value is bounded by 2^-(sub_bucket_bits - 1) regardless of magnitude. The
+ * default of 11 bits keeps values within ~0.1% while tracking from 1ns up to highest_trackable_ns. Values above the
+ * trackable range are clamped and counted in overflow_count().
+ */
+class LatencyHistogram
+{
+  public:
+    static constexpr std::uint64_t DefaultHighestTrackableNs = 60'000'000'000;  // NOLINT
+    static constexpr unsigned DefaultSubBucketBits           = 11;              // NOLINT
+
+    LatencyHistogram(std::uint64_t highest_trackable_ns = DefaultHighestTrackableNs,
+                     unsigned sub_bucket_bits           = DefaultSubBucketBits);
+
+    void record(std::uint64_t value_ns);
+
+    void record(std::chrono::nanoseconds value)
+    {
+        record(value.count() < 0 ? 0 : static_cast<std::uint64_t>(value.count()));
+    }
+
+    /**
+     * @brief Add all counts from other; both histograms must share the same configuration
+     */
+    void merge(const LatencyHistogram& other);
+
+    void reset();
+
+    std::uint64_t count() const;
+    std::uint64_t overflow_count() const;
+    std::uint64_t min() const;
+    std::uint64_t max() const;
+    double mean() const;
+
+    /**
+     * @brief Value at the given percentile in [0, 100]; reports the highest value equivalent to the selected bucket
+     * so that tail percentiles are never under-reported
+     */
+    std::uint64_t value_at_percentile(double percentile) const;
+
+    std::uint64_t highest_trackable() const;
+
+    /**
+     * @brief Summary in seconds: count, min, mean, max and p50/p90/p99/p99.9/p99.99
+     */
+    nlohmann::json to_json() const;
+
+  private:
+    std::size_t index_for(std::uint64_t value) const;
+    std::uint64_t highest_equivalent_value(std::size_t index) const;
+
+    unsigned m_sub_bucket_bits;
+    std::uint64_t m_sub_bucket_half;
+    std::uint64_t m_highest_trackable;
+    std::vector<std::uint64_t> m_counts;
+    std::uint64_t m_count{0};
+    std::uint64_t m_overflow{0};
+    std::uint64_t m_min;
+    std::uint64_t m_max{0};
+    long double m_sum{0};
+};
+
+}  // namespace srf::benchmarking
@@ -0,0 +1,173 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <srf/benchmarking/latency_histogram.hpp>
+#include <srf/benchmarking/util.hpp>
+
+#include <nlohmann/json_fwd.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace srf::benchmarking {
+
+/**
+ * Open-loop load generation.
+ *
+ * Closed-loop sources emit as fast as the pipeline accepts, so time spent queued behind a slow stage is never observed
+ * (coordinated omission). The open-loop source below follows a fixed arrival schedule and stamps every sample with
+ * its *intended* send time; latency recorded at the sink is measured from that intended time, so any back-pressure
+ * stall shows up in the histogram instead of silently lowering the offered load.
+ */
+
+enum class ArrivalProcess
+{
+    Constant,
+    Poisson,
+};
+
+struct LoadProfile
+{
+    double rate_per_second{1000.0};
+    ArrivalProcess arrival{ArrivalProcess::Constant};
+    std::size_t count{10000};
+    std::uint64_t seed{42};
+};
+
+/**
+ * @brief Generates intended send offsets, relative to the start of a run, for a LoadProfile
+ */
+class ArrivalSchedule
+{
+  public:
+    explicit ArrivalSchedule(const LoadProfile& profile);
+
+    std::chrono::nanoseconds next();
+
+  private:
+    ArrivalProcess m_arrival;
+    double m_interval_ns;
+    double m_elapsed_ns{0.0};
+    std::mt19937_64 m_generator;
+    std::exponential_distribution<double> m_exponential;
+};
+
+struct OpenLoopSample
+{
+    TimeUtil::time_pt_t intended_send;
+    std::size_t sequence;
+};
+
+/**
+ * @brief Wait until the given time point; the calling fiber sleeps for the bulk of the interval then yields in a loop
+ * to hit it precisely, so the OS thread is never blocked and other fibers on the same engine keep making progress
+ */
+void wait_until(TimeUtil::time_pt_t time_point);
+
+/**
+ * @brief Thread-safe sink-side recorder of end-to-end latency measured from each sample's intended send time
+ */
+class LatencyRecorder
+{
+  public:
+    LatencyRecorder() = default;
+    explicit LatencyRecorder(LatencyHistogram histogram);
+
+    void record(TimeUtil::time_pt_t intended_send);
+
+    void record(const OpenLoopSample& sample)
+    {
+        record(sample.intended_send);
+    }
+
+    void reset();
+
+    LatencyHistogram histogram() const;
+
+    std::size_t count() const;
+
+    // seconds from the earliest intended send to the latest completion
+    double elapsed_seconds() const;
+
+  private:
+    mutable std::mutex m_mutex;
+    LatencyHistogram m_histogram;
+    TimeUtil::time_pt_t m_first_intended{TimeUtil::time_pt_t::max()};
+    TimeUtil::time_pt_t m_last_completion{TimeUtil::time_pt_t::min()};
+};
+
+/**
+ * @brief Create an rx source body which emits profile.count items on the profile's arrival schedule.
+ *
+ * make_fn converts each OpenLoopSample into the emitted type; the source never waits for downstream capacity beyond
+ * the blocking on_next call itself, and items that fall behind schedule are emitted immediately with their original
+ * intended send time.
+ */
+template <typename T, typename MakeFnT>
+auto create_open_loop_source(LoadProfile profile, MakeFnT make_fn)
+{
+    return [profile, make_fn = std::move(make_fn)](rxcpp::subscriber<T> subscriber) {
+        ArrivalSchedule schedule(profile);
+        auto start = TimeUtil::get_current_time_point();
+
+        for (std::size_t i = 0; i < profile.count && subscriber.is_subscribed(); ++i)
+        {
+            OpenLoopSample sample{start + schedule.next(), i};
+            wait_until(sample.intended_send);
+            subscriber.on_next(make_fn(sample));
+        }
+        subscriber.on_completed();
+    };
+}
+
+inline auto create_open_loop_source(LoadProfile profile)
+{
+    return create_open_loop_source<OpenLoopSample>(std::move(profile),
+                                                   [](const OpenLoopSample& sample) { return sample; });
+}
+
+struct LoadPoint
+{
+    double offered_rate;
+    double achieved_rate;
+    LatencyHistogram histogram;
+};
+
+using load_run_fn_t = std::function<void(const LoadProfile&, LatencyRecorder&)>;
+
+/**
+ * @brief Run the load described by base at each offered rate and collect a latency-vs-throughput curve.
+ *
+ * run must drive profile.count samples through the system under test and record each of them into the recorder
+ * before returning.
+ */
+std::vector<LoadPoint> sweep_offered_load(const LoadProfile& base,
+                                          const std::vector<double>& rates_per_second,
+                                          const load_run_fn_t& run);
+
+nlohmann::json to_json(const std::vector<LoadPoint>& curve);
+
+}  // namespace srf::benchmarking
@@ -0,0 +1,113 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <srf/codable/decode.hpp>
+#include <srf/codable/encode.hpp>
+#include <srf/codable/encoded_object.hpp>
+#include <srf/codable/encoding_options.hpp>
+#include <srf/codable/fundamental_types.hpp>
+#include <srf/codable/type_traits.hpp>
+
+#include <any>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <typeindex>
+
+namespace srf::codable {
+
+/**
+ * @brief Type-erased encode/decode functions for a single codable type
+ */
+struct Codec
+{
+    using decode_fn_t = std::function<std::any(const EncodedObject&, std::size_t)>;
+    using encode_fn_t = std::function<void(const std::any&, EncodedObject&, const EncodingOptions&)>;
+
+    std::type_index type;
+    decode_fn_t decode;
+    encode_fn_t encode;
+};
+
+/**
+ * @brief CodecRegistry maps the type_index_hash recorded for each object of an EncodedObject to the Codec able to
+ * decode it, allowing a receiver to decode objects whose type is only known at runtime.
+ *
+ * Registered codecs are never removed; references returned by find_codec remain valid for the life of the process.
+ */
+struct CodecRegistry
+{
+    CodecRegistry() = delete;
+
+    // registering the same type more than once is a no-op; a different type with a colliding hash throws
+    static void register_codec(std::type_index type, Codec::decode_fn_t decode_fn, Codec::encode_fn_t encode_fn);
+
+    static bool has_codec(std::size_t type_index_hash);
+
+    static const Codec& find_codec(std::size_t type_index_hash);
+
+    // decode the object at object_idx using the codec registered for its recorded type
+    static std::any decode(const EncodedObject& encoded, std::size_t object_idx = 0);
+
+    // encode obj using the codec registered for the type held by the std::any
+    static void encode(const std::any& obj, EncodedObject& encoded, const EncodingOptions& opts = {});
+};
+
+template <typename T>
+struct is_registrable_codec
+  : std::conditional<(is_codable<T>::value && std::is_copy_constructible_v<T>), std::true_type, std::false_type>::type
+{};
+
+/**
+ * @brief Register the codec for T; the guard is a function-local static of this instantiation, shared by the whole
+ * program, so only the first call for each T reaches CodecRegistry and later calls are a single static check
+ */
+template <typename T>
+void register_codec()
+{
+    static_assert(is_registrable_codec<T>::value, "codec registration requires a copyable codable type");
+
+    static const bool registered = [] {
+        CodecRegistry::register_codec(
+            std::type_index(typeid(T)),
+            [](const EncodedObject& encoded, std::size_t object_idx) -> std::any {
+                return std::any(decode<T>(encoded, object_idx));
+            },
+            [](const std::any& obj, EncodedObject& encoded, const EncodingOptions& opts) {
+                codable::encode<T>(std::any_cast<const T&>(obj), encoded, opts);
+            });
+        return true;
+    }();
+    (void)registered;
+}
+
+/**
+ * @brief Register the codec for T when T is codable; used by segment ports so that any type which may cross the
+ * network is discoverable by its type_index_hash
+ */
+template <typename T>
+void register_codec_if_codable()
+{
+    if constexpr (is_registrable_codec<T>::value)
+    {
+        register_codec<T>();
+    }
+}
+
+}  // namespace srf::codable
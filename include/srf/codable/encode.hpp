@@ -30,7 +30,12 @@ struct Encoder
 {
     static void serialize(const T& t, Encoded<T>& enc, const EncodingOptions& opts = {})
     {
-        return detail::serialize(sfinae::full_concept{}, t, enc, opts);
+        auto object_idx = enc.object_count();
+        detail::serialize(sfinae::full_concept{}, t, enc, opts);
+        if (opts.compression().enabled())
+        {
+            enc.compress(object_idx, opts.compression());
+        }
     }
 };
 
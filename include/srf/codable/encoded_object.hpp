@@ -19,6 +19,7 @@
 
 #include <srf/protos/codable.pb.h>
 #include <srf/codable/codable_protocol.hpp>
+#include <srf/codable/encoding_options.hpp>
 #include <srf/exceptions/runtime_error.hpp>
 #include <srf/memory/blob.hpp>
 #include <srf/memory/block.hpp>
@@ -27,10 +28,13 @@
 #include <srf/utils/macros.hpp>
 
 #include <glog/logging.h>
+#include <google/protobuf/arena.h>
 #include <google/protobuf/message.h>
 
 #include <cstddef>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <typeindex>
 #include <utility>
 #include <vector>
@@ -48,12 +52,42 @@ namespace srf::codable {
  * environment be configured with the SRF Runtime. The SRF Runtime is instantiated on all threads provided by the
  * Executor.
  *
+ * The descriptor tree is allocated on a protobuf arena. By default, the arena is acquired from the calling thread's
+ * pool of recycled arenas; alternatively an EncodedObject may share ownership of a caller's arena, borrow an arena
+ * which must outlive it, or be constructed with a null arena to use the heap.
+ *
  * @note The serialization of an object should create one, and only one, ContextGuard by calling the
  * acquire_encoding_context method from the derived Encoded<T>.
  */
 class EncodedObject
 {
   public:
+    EncodedObject();
+
+    /**
+     * @brief Construct with shared ownership of arena; a nullptr arena allocates the descriptor tree on the heap
+     */
+    explicit EncodedObject(std::shared_ptr<google::protobuf::Arena> arena);
+
+    /**
+     * @brief Construct on a borrowed arena; the arena must outlive the EncodedObject
+     */
+    explicit EncodedObject(google::protobuf::Arena& arena);
+
+    ~EncodedObject();
+
+    EncodedObject(EncodedObject&& other) noexcept;
+    EncodedObject& operator=(EncodedObject&& other) noexcept;
+
+    DELETE_COPYABILITY(EncodedObject);
+
+    /**
+     * @brief The arena on which the descriptor tree is allocated; nullptr if allocated on the heap
+     *
+     * Messages decoded from this object may be placed on the same arena to share its lifetime.
+     */
+    google::protobuf::Arena* arena() const;
+
     /**
      * @brief ObjectDescriptor describing the encoded object.
      * @return const protos::ObjectDescriptor&
@@ -61,11 +95,26 @@ class EncodedObject
     const protos::EncodedObject& proto() const;
 
     /**
-     * @brief Access const memory::block of the RemoteDescriptor at the required index
+     * @brief Access const memory::block of the RemoteDescriptor or EagerDescriptor at the required index
+     *
+     * Compressed blocks are decompressed into a pooled host buffer on first access; the buffer is owned by the
+     * EncodedObject.
+     *
      * @return memory::const_block
      */
     memory::const_block memory_block(std::size_t idx) const;
 
+    /**
+     * @brief Compress the host memory blocks of the object at object_idx according to policy
+     *
+     * Each compressed block is copied into a buffer owned by the EncodedObject and its descriptor is tagged with the
+     * algorithm and uncompressed size. Called by Encoder after an object has been serialized.
+     *
+     * @param object_idx
+     * @param policy
+     */
+    void compress(std::size_t object_idx, const CompressionPolicy& policy);
+
     /**
      * @brief Decode meta data associated the MetaDataDescriptor at the requested index.
      *
@@ -223,10 +272,20 @@ class EncodedObject
      */
     void add_type_index(std::type_index type_index);
 
-    protos::EncodedObject m_proto;
+    /**
+     * @brief Decompress the compressed block of the descriptor at idx, caching the result
+     */
+    memory::const_block decompressed_block(std::size_t idx, memory::const_block compressed) const;
+
+    std::shared_ptr<google::protobuf::Arena> m_arena;
+    protos::EncodedObject* m_proto;
     std::map<std::size_t, memory::blob> m_buffers;
     std::vector<std::pair<int, std::type_index>> m_object_info;  // typeindex and starting descriptor index
     bool m_context_acquired{false};
+
+    mutable std::mutex m_decompressed_mutex;
+    mutable std::map<std::size_t, memory::blob> m_decompressed;
+
     friend ContextGuard;
 };
 
@@ -244,6 +303,10 @@ class Encoded final : public EncodedObject
     friend T;
     friend codable_protocol<T>;
 
+  public:
+    using EncodedObject::EncodedObject;
+
+  private:
     [[nodiscard]] ContextGuard acquire_encoding_context()
     {
         return ContextGuard(*this, std::type_index(typeid(T)));
@@ -256,7 +319,7 @@ template <typename MetaDataT>
 MetaDataT EncodedObject::meta_data(std::size_t idx) const
 {
     DCHECK_LT(idx, descriptor_count());
-    const auto& desc = m_proto.descriptors().at(idx);
+    const auto& desc = m_proto->descriptors().at(idx);
     CHECK(desc.has_meta_data_desc());
 
     MetaDataT meta_data;
@@ -17,8 +17,74 @@
 
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <utility>
+
 namespace srf::codable {
 
+enum class CompressionAlgorithm
+{
+    none,
+    lz4,
+    zstd,
+};
+
+/**
+ * @brief Compression applied to the host memory blocks of an encoded object
+ *
+ * Blocks smaller than min_bytes are left as-is, as is any block which does not compress. For lz4, level is the
+ * acceleration factor (higher is faster with a lower ratio); for zstd, it is the compression level. A level of 0
+ * selects the library default.
+ *
+ * The achieved ratio is sampled: after every sample_window compressed blocks, compression is disabled if the aggregate
+ * ratio fell below min_ratio. While disabled, one in probe_interval eligible blocks is still compressed, and
+ * compression is re-enabled as soon as a probe achieves min_ratio. Copies of a policy share the sampling state, so a
+ * policy should be created once per stream of similar payloads, e.g. per edge, and reused.
+ */
+class CompressionPolicy final
+{
+  public:
+    static constexpr std::size_t default_min_bytes      = 4096;  // NOLINT
+    static constexpr double default_min_ratio           = 1.25;  // NOLINT
+    static constexpr std::size_t default_sample_window  = 64;    // NOLINT
+    static constexpr std::size_t default_probe_interval = 64;    // NOLINT
+
+    CompressionPolicy() = default;
+    CompressionPolicy(CompressionAlgorithm algorithm,
+                      int level                  = 0,
+                      std::size_t min_bytes      = default_min_bytes,
+                      double min_ratio           = default_min_ratio,
+                      std::size_t sample_window  = default_sample_window,
+                      std::size_t probe_interval = default_probe_interval);
+
+    CompressionAlgorithm algorithm() const;
+    int level() const;
+    std::size_t min_bytes() const;
+    double min_ratio() const;
+
+    // true if an algorithm was selected
+    bool enabled() const;
+
+    // false while compression is disabled by poor sampled ratios
+    bool active() const;
+
+    // true if a block of bytes should be compressed given the size threshold and sampling state
+    bool should_compress(std::size_t bytes) const;
+
+    // record the outcome of compressing a block; compressed_bytes of 0 indicates the block did not compress
+    void record(std::size_t uncompressed_bytes, std::size_t compressed_bytes) const;
+
+  private:
+    struct Sampler;
+
+    CompressionAlgorithm m_algorithm{CompressionAlgorithm::none};
+    int m_level{0};
+    std::size_t m_min_bytes{default_min_bytes};
+    double m_min_ratio{default_min_ratio};
+    std::shared_ptr<Sampler> m_sampler;
+};
+
 class EncodingOptions final
 {
   public:
@@ -29,8 +95,26 @@ class EncodingOptions final
         return m_force_copy;
     }
 
+    EncodingOptions& set_force_copy(bool force_copy)
+    {
+        m_force_copy = force_copy;
+        return *this;
+    }
+
+    const CompressionPolicy& compression() const
+    {
+        return m_compression;
+    }
+
+    EncodingOptions& set_compression(CompressionPolicy compression)
+    {
+        m_compression = std::move(compression);
+        return *this;
+    }
+
   private:
     bool m_force_copy{false};
+    CompressionPolicy m_compression;
 };
 
 }  // namespace srf::codable
@@ -17,10 +17,17 @@
 
 #pragma once
 
+#include <srf/memory/blob.hpp>
+#include <srf/memory/buffer_pool.hpp>
 #include <srf/memory/resource_view.hpp>
 
 #include <cuda/memory_resource>
 
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
 namespace srf::codable {
 
 struct MemoryResources
@@ -33,6 +40,24 @@ struct MemoryResources
 
     virtual host_view_t host_resource_view()     = 0;
     virtual device_view_t device_resource_view() = 0;
+
+    /**
+     * @brief Acquire a host blob of at least bytes from size-classed buffer_pools built on host_resource_view
+     *
+     * Size classes are powers of two from 4 KiB to 4 MiB; larger requests, or requests whose pool is exhausted, are
+     * allocated directly from host_resource_view. The returned blob reports the size of its size class.
+     */
+    memory::blob pooled_host_blob(std::size_t bytes);
+
+  private:
+    using host_pool_t = memory::buffer_pool<::cuda::memory_location::host>;
+
+    static constexpr std::size_t min_pooled_bytes = 4096;       // NOLINT
+    static constexpr std::size_t max_pooled_bytes = 4UL << 20;  // NOLINT
+    static constexpr std::size_t size_class_count = 11;         // NOLINT
+
+    std::mutex m_host_pools_mutex;
+    std::array<std::shared_ptr<host_pool_t>, size_class_count> m_host_pools;
 };
 
 }  // namespace srf::codable
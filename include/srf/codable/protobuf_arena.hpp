@@ -0,0 +1,36 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <google/protobuf/arena.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace srf::codable {
+
+/**
+ * @brief Acquire a protobuf arena from the calling thread's pool of recycled arenas
+ *
+ * Each recycled arena carries a preallocated initial block, so small messages built on it do not touch the heap. When
+ * the last reference is dropped, the arena is reset and cached by the releasing thread for its next acquisition.
+ */
+std::shared_ptr<google::protobuf::Arena> acquire_arena();
+
+}  // namespace srf::codable
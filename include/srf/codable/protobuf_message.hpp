@@ -23,8 +23,12 @@
 #include <srf/memory/block.hpp>
 #include <srf/memory/memory_kind.hpp>
 
+#include <glog/logging.h>
+#include <google/protobuf/arena.h>
 #include <google/protobuf/message.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 namespace srf::codable {
@@ -37,7 +41,9 @@ struct codable_protocol<T, std::enable_if_t<std::is_base_of_v<::google::protobuf
         auto guard = encoded.acquire_encoding_context();
         auto index = encoded.add_host_buffer(msg.ByteSizeLong());
         auto block = encoded.mutable_memory_block(index);
-        msg.SerializeToArray(block.data(), block.bytes());
+
+        // ByteSizeLong cached the sizes of all sub-messages; SerializeToArray would compute them a second time
+        msg.SerializeWithCachedSizesToArray(static_cast<std::uint8_t*>(block.data()));
     }
 
     static T deserialize(const EncodedObject& encoded, std::size_t object_idx)
@@ -48,6 +54,30 @@ struct codable_protocol<T, std::enable_if_t<std::is_base_of_v<::google::protobuf
         CHECK(msg.ParseFromArray(block.data(), block.bytes()));
         return msg;
     }
+
+    /**
+     * @brief Decode onto arena; the returned message and all of its fields are owned by the arena
+     */
+    static T* deserialize(const EncodedObject& encoded, std::size_t object_idx, google::protobuf::Arena* arena)
+    {
+        auto* msg         = google::protobuf::Arena::CreateMessage<T>(arena);
+        auto idx          = encoded.start_idx_for_object(object_idx);
+        const auto& block = encoded.memory_block(idx);
+        CHECK(msg->ParseFromArray(block.data(), block.bytes()));
+        return msg;
+    }
 };
 
+/**
+ * @brief Decode a protobuf message onto arena, avoiding a heap allocation per field
+ *
+ * The message is owned by the arena and must not be deleted; passing encoded.arena() ties the lifetime of the message
+ * to the EncodedObject.
+ */
+template <typename T, typename = std::enable_if_t<std::is_base_of_v<::google::protobuf::Message, T>>>
+T* decode(const EncodedObject& encoded, google::protobuf::Arena& arena, std::size_t object_idx = 0)
+{
+    return codable_protocol<T>::deserialize(encoded, object_idx, &arena);
+}
+
 }  // namespace srf::codable
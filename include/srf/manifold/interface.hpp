@@ -38,6 +38,10 @@ struct Interface
     // this ensures downstream segments have started and are immediately capaable of handling data
     virtual void update_inputs()  = 0;
     virtual void update_outputs() = 0;
+
+    // permit a manifold with a single input and a single output to connect them directly, bypassing its progress
+    // engine; evaluated on start, the manifold falls back to its progress engine once the topology changes
+    virtual void permit_direct_binding(bool permitted) = 0;
 };
 
 }  // namespace srf::manifold
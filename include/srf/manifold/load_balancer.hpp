@@ -24,6 +24,7 @@
 #include "srf/node/edge_builder.hpp"
 #include "srf/node/generic_sink.hpp"
 #include "srf/node/operators/muxer.hpp"
+#include "srf/node/operators/operator.hpp"
 #include "srf/node/rx_sink.hpp"
 #include "srf/node/source_channel.hpp"
 #include "srf/pipeline/resources.hpp"
@@ -32,6 +33,11 @@
 #include "srf/runnable/types.hpp"
 #include "srf/types.hpp"
 
+#include <boost/fiber/operations.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 
@@ -61,12 +67,144 @@ class Balancer : public node::GenericSink<T>
     RoundRobinEgress<T>& m_state;
 };
 
+/**
+ * @brief Muxer which forwards data to its downstream edge, i.e. the balancer, or when bound, directly to a single
+ * egress channel in the context of the upstream writer.
+ */
+template <typename T>
+class DirectMuxer final : public node::Operator<T>, public node::SourceChannelWriteable<T>
+{
+  public:
+    // bypass the balancer; on_release is invoked when the upstream completes while the muxer is bound
+    void bind(node::SourceChannelWriteable<T>* channel, std::function<void()> on_release)
+    {
+        CHECK(channel);
+        m_on_release = std::move(on_release);
+        m_direct.store(channel);
+    }
+
+    // forward all subsequent data to the balancer; returns once every write in flight on the direct channel has
+    // completed, so the balancer must only be launched after unbind returns. a muxer is never re-bound once unbound
+    void unbind()
+    {
+        m_direct.store(nullptr);
+        while (m_direct_writers.load() != 0)
+        {
+            boost::this_fiber::yield();
+        }
+        m_unbound = true;
+    }
+
+    bool is_bound() const
+    {
+        return m_direct.load() != nullptr;
+    }
+
+    bool was_unbound() const
+    {
+        return m_unbound;
+    }
+
+  private:
+    // writers announce themselves before reading m_direct; both sides are sequentially consistent, so either unbind
+    // observes the writer or the writer observes the unbound muxer
+    class DirectWriter
+    {
+      public:
+        DirectWriter(DirectMuxer& parent) : m_parent(parent)
+        {
+            m_parent.m_direct_writers.fetch_add(1);
+        }
+        ~DirectWriter()
+        {
+            m_parent.m_direct_writers.fetch_sub(1);
+        }
+
+      private:
+        DirectMuxer& m_parent;
+    };
+
+    // Operator::on_next
+    inline channel::Status on_next(T&& data) final
+    {
+        {
+            DirectWriter writer(*this);
+            auto* direct = m_direct.load();
+            if (direct != nullptr)
+            {
+                return direct->await_write(std::move(data));
+            }
+        }
+        return node::SourceChannelWriteable<T>::await_write(std::move(data));
+    }
+
+    // Operator::on_complete
+    void on_complete() final
+    {
+        {
+            DirectWriter writer(*this);
+            if (is_bound())
+            {
+                m_on_release();
+            }
+        }
+        this->release_channel();
+    }
+
+    std::atomic<node::SourceChannelWriteable<T>*> m_direct{nullptr};
+    std::atomic<std::size_t> m_direct_writers{0};
+    std::function<void()> m_on_release;
+    bool m_unbound{false};
+};
+
+template <typename T>
+class DirectMuxedIngress final : public TypedIngress<T>
+{
+  public:
+    DirectMuxedIngress() : m_muxer(std::make_shared<DirectMuxer<T>>()) {}
+
+    DirectMuxer<T>& muxer()
+    {
+        return *m_muxer;
+    }
+
+    std::size_t input_count() const
+    {
+        return m_input_count;
+    }
+
+  protected:
+    void do_add_input(const SegmentAddress& address, node::SourceProperties<T>& source) final
+    {
+        CHECK(m_muxer);
+        node::make_edge(source, *m_muxer);
+        ++m_input_count;
+    }
+
+  private:
+    node::SinkPropertiesBase& source_base() final
+    {
+        return *m_muxer;
+    }
+
+    std::shared_ptr<DirectMuxer<T>> m_muxer;
+    std::size_t m_input_count{0};
+};
+
 }  // namespace detail
 
+/**
+ * @brief Manifold which muxes all inputs and distributes the data round-robin over all outputs
+ *
+ * The balancer, which pulls from the muxer and writes to the outputs, runs as a fiber on the main task queue. When
+ * direct binding is permitted and the manifold has a single input and a single output, the muxer writes directly to the
+ * output and the balancer is not launched. If the topology later changes, the manifold permanently falls back to the
+ * balancer.
+ */
 template <typename T>
-class LoadBalancer : public CompositeManifold<MuxedIngress<T>, RoundRobinEgress<T>>
+class LoadBalancer : public CompositeManifold<detail::DirectMuxedIngress<T>, RoundRobinEgress<T>>
 {
-    using base_t = CompositeManifold<MuxedIngress<T>, RoundRobinEgress<T>>;
+    using base_t = CompositeManifold<detail::DirectMuxedIngress<T>, RoundRobinEgress<T>>;
 
   public:
     LoadBalancer(PortName port_name, pipeline::Resources& resources) : base_t(std::move(port_name), resources)
@@ -97,6 +235,32 @@ class LoadBalancer : public CompositeManifold<MuxedIngress<T>, RoundRobinEgress<
                     // CHECK(!this->egress().output_channels().empty()) << "no egress channels on manifold";
                     return;
                 }
+
+                auto& muxer = this->ingress().muxer();
+                if (m_direct_binding_permitted && !muxer.was_unbound() && this->ingress().input_count() == 1 &&
+                    this->egress().output_channels().size() == 1)
+                {
+                    if (!muxer.is_bound())
+                    {
+                        DVLOG(10) << this->port_name() << " manifold: binding input directly to output";
+                        muxer.bind(this->egress().output_channels().begin()->second.get(), [this] {
+                            // invoked in the context of the upstream writer; the egress is owned by the main task queue
+                            this->resources().main().enqueue([this] {
+                                this->egress().clear();
+                                m_released.set_value();
+                            });
+                        });
+                    }
+                    return;
+                }
+
+                // in-flight direct writes must land before the balancer starts forwarding data queued behind them
+                if (muxer.is_bound())
+                {
+                    DVLOG(10) << this->port_name() << " manifold: topology changed; falling back to the balancer";
+                    muxer.unbind();
+                }
+
                 CHECK(m_balancer);
                 m_runner = this->resources()
                                .launch_control()
@@ -108,7 +272,19 @@ class LoadBalancer : public CompositeManifold<MuxedIngress<T>, RoundRobinEgress<
 
     void join() final
     {
-        m_runner->await_join();
+        if (m_runner)
+        {
+            m_runner->await_join();
+        }
+        else if (this->ingress().muxer().is_bound())
+        {
+            m_released_future.get();
+        }
+    }
+
+    void permit_direct_binding(bool permitted) final
+    {
+        m_direct_binding_permitted = permitted;
     }
 
     const runnable::LaunchOptions& launch_options() const
@@ -116,6 +292,18 @@ class LoadBalancer : public CompositeManifold<MuxedIngress<T>, RoundRobinEgress<
         return m_launch_options;
     }
 
+    // true if the input is bound directly to the output, bypassing the balancer
+    bool is_direct_bound()
+    {
+        return this->ingress().muxer().is_bound();
+    }
+
+    // true if the balancer has been launched
+    bool is_balancer_launched() const
+    {
+        return m_runner != nullptr;
+    }
+
   private:
     // launch options
     runnable::LaunchOptions m_launch_options;
@@ -125,6 +313,12 @@ class LoadBalancer : public CompositeManifold<MuxedIngress<T>, RoundRobinEgress<
 
     // runner
     std::unique_ptr<runnable::Runner> m_runner{nullptr};
+
+    bool m_direct_binding_permitted{false};
+
+    // fulfilled on the main task queue once a bound input has completed and the egress has been released
+    Promise<void> m_released;
+    SharedFuture<void> m_released_future{m_released.get_future().share()};
 };
 
 }  // namespace srf::manifold
@@ -23,6 +23,7 @@
 #include <cstddef>  // for size_t
 #include <memory>
 #include <type_traits>  // for enable_if_t & remove_reference_t
+#include <utility>
 
 namespace srf::memory {
 
@@ -36,6 +37,9 @@ namespace srf::memory {
  *
  * Ownership is required - either by an explicit move or a capture of a shared_ptr. The held memory will be released
  * when the last blob and/or the last shared_ptr referencing the memory block have been released.
+ *
+ * The data pointer, size and kind of the backing storage are cached in the blob on construction, so the accessors do
+ * not dispatch through IBlobStorage; storage objects must describe the same memory block for their entire lifetime.
  */
 class blob
 {
@@ -43,8 +47,8 @@ class blob
     blob();
     virtual ~blob();
 
-    blob(blob&&) noexcept = default;
-    blob& operator=(blob&&) noexcept = default;
+    blob(blob&& other) noexcept;
+    blob& operator=(blob&& other) noexcept;
 
     blob(const blob&) = default;
     blob& operator=(const blob&) = default;
@@ -76,7 +80,7 @@ class blob
      */
     template <typename StorageT,
               typename = std::enable_if_t<!std::is_base_of_v<blob, std::remove_reference_t<StorageT>>>>
-    blob(StorageT&& storage) : m_storage(std::make_shared<BlobStorage<StorageT>>(std::move(storage)))
+    blob(StorageT&& storage) : blob(make_blob_storage(std::move(storage)))
     {}
 
     /**
@@ -84,28 +88,40 @@ class blob
      *
      * @return void*
      */
-    void* data();
+    void* data()
+    {
+        return m_data;
+    }
 
     /**
      * @brief Constant pointer to the start of the memory block descibed by blob
      *
      * @return const void*
      */
-    const void* data() const;
+    const void* data() const
+    {
+        return m_data;
+    }
 
     /**
      * @brief Number of bytes, i.e. the capacity of the memory block described by blob
      *
      * @return std::size_t
      */
-    std::size_t bytes() const;
+    std::size_t bytes() const
+    {
+        return m_bytes;
+    }
 
     /**
      * @brief Type of memory described by the blob
      *
      * @return memory_kind_type
      */
-    memory_kind_type kind() const;
+    memory_kind_type kind() const
+    {
+        return m_kind;
+    }
 
     /**
      * @brief Value of the internal reference count to the object backing the blob
@@ -126,7 +142,10 @@ class blob
      * @return true
      * @return false
      */
-    bool empty() const;
+    bool empty() const
+    {
+        return not bool(*this);
+    }
 
     /**
      * @brief bool operator, returns true if the view is backed by some storage whose
@@ -135,7 +154,10 @@ class blob
      * @return true
      * @return false
      */
-    operator bool() const;
+    operator bool() const
+    {
+        return m_data != nullptr && m_bytes != 0U;
+    }
 
     /**
      * @brief allocate a new blob
@@ -147,6 +169,11 @@ class blob
 
   private:
     std::shared_ptr<IBlobStorage> m_storage{nullptr};
+
+    // cached from m_storage
+    void* m_data{nullptr};
+    std::size_t m_bytes{0};
+    memory_kind_type m_kind{memory_kind_type::none};
 };
 
 }  // namespace srf::memory
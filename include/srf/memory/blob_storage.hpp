@@ -23,11 +23,219 @@
 
 #include <rmm/device_buffer.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
 #include "rmm/cuda_stream_view.hpp"
 
 namespace srf::memory {
 
+namespace detail {
+
+/**
+ * @brief Per-thread free list of fixed-size nodes backed by a shared depot
+ *
+ * Nodes freed on a thread are cached for reuse by allocations on that thread, up to max_local_cached nodes. When the
+ * local list is full, a batch of nodes is returned to a depot shared by all threads, from which threads with an empty
+ * local list refill, so nodes freed on a different thread than the one which allocated them are reused rather than
+ * hoarded. The depot retains at most max_shared_cached nodes; any excess is returned to the global allocator. The local
+ * lists are built from trivially destructible thread_locals so frees which happen during thread teardown fall through
+ * to the global allocator safely; a thread's cached nodes are handed to the depot when it exits.
+ */
+template <std::size_t NodeSize>
+class node_free_list final
+{
+    struct node  // NOLINT
+    {
+        node* next;
+    };
+
+    // never destroyed, so threads exiting during static destruction may still return nodes
+    struct depot  // NOLINT
+    {
+        std::mutex mutex;
+        node* head{nullptr};
+        std::size_t size{0};
+    };
+
+    struct drain_on_exit  // NOLINT
+    {
+        ~drain_on_exit()
+        {
+            while (s_size != 0)
+            {
+                give(transfer_batch);
+            }
+            s_drained = true;
+        }
+    };
+
+  public:
+    static constexpr std::size_t node_size         = std::max(NodeSize, sizeof(node));  // NOLINT
+    static constexpr std::size_t max_local_cached  = 64;                                // NOLINT
+    static constexpr std::size_t max_shared_cached = 1024;                              // NOLINT
+    static constexpr std::size_t transfer_batch    = max_local_cached / 2;              // NOLINT
+
+    static void* acquire()
+    {
+        if (s_head == nullptr && !s_drained)
+        {
+            take(transfer_batch);
+        }
+        if (s_head != nullptr)
+        {
+            auto* n = s_head;
+            s_head  = n->next;
+            --s_size;
+            return n;
+        }
+        return ::operator new(node_size);
+    }
+
+    static void release(void* ptr)
+    {
+        if (s_drained)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+
+        // odr-use registers the drain for this thread on its first cached node
+        static thread_local drain_on_exit drain;
+        (void)drain;
+
+        if (s_size == max_local_cached)
+        {
+            give(transfer_batch);
+        }
+
+        auto* n = static_cast<node*>(ptr);
+        n->next = s_head;
+        s_head  = n;
+        ++s_size;
+    }
+
+    // number of nodes cached by the calling thread
+    static std::size_t local_cached()
+    {
+        return s_size;
+    }
+
+    // number of nodes held by the shared depot
+    static std::size_t shared_cached()
+    {
+        auto& shared = get_depot();
+        std::lock_guard<decltype(shared.mutex)> lock(shared.mutex);
+        return shared.size;
+    }
+
+  private:
+    static depot& get_depot()
+    {
+        static auto* shared = new depot();
+        return *shared;
+    }
+
+    // move up to count nodes from the depot to the calling thread's list
+    static void take(std::size_t count)
+    {
+        auto& shared = get_depot();
+        std::lock_guard<decltype(shared.mutex)> lock(shared.mutex);
+        while (count-- != 0 && shared.head != nullptr)
+        {
+            auto* n     = shared.head;
+            shared.head = n->next;
+            --shared.size;
+            n->next = s_head;
+            s_head  = n;
+            ++s_size;
+        }
+    }
+
+    // move up to count nodes from the calling thread's list to the depot, freeing those which exceed its capacity
+    static void give(std::size_t count)
+    {
+        auto& shared = get_depot();
+        std::lock_guard<decltype(shared.mutex)> lock(shared.mutex);
+        while (count-- != 0 && s_head != nullptr)
+        {
+            auto* n = s_head;
+            s_head  = n->next;
+            --s_size;
+            if (shared.size == max_shared_cached)
+            {
+                ::operator delete(n);
+                continue;
+            }
+            n->next     = shared.head;
+            shared.head = n;
+            ++shared.size;
+        }
+    }
+
+    static inline thread_local node* s_head{nullptr};
+    static inline thread_local std::size_t s_size{0};
+    static inline thread_local bool s_drained{false};
+};
+
+/**
+ * @brief Allocator which recycles single-object allocations through a per-thread free list sized for T
+ *
+ * Used with std::allocate_shared so the shared control block and BlobStorage object of common blob types are served
+ * from the free list rather than the global heap.
+ */
+template <typename T>
+class storage_pool_allocator final
+{
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned types are not supported");
+
+  public:
+    using value_type = T;
+
+    storage_pool_allocator() = default;
+
+    template <typename U>
+    storage_pool_allocator(const storage_pool_allocator<U>& /*other*/) noexcept
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n != 1)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(node_free_list<sizeof(T)>::acquire());
+    }
+
+    void deallocate(T* ptr, std::size_t n)
+    {
+        if (n != 1)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+        node_free_list<sizeof(T)>::release(ptr);
+    }
+
+    template <typename U>
+    bool operator==(const storage_pool_allocator<U>& /*other*/) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const storage_pool_allocator<U>& /*other*/) const noexcept
+    {
+        return false;
+    }
+};
+
+}  // namespace detail
+
 class IBlobStorage  // NOLINT
 {
   public:
@@ -80,6 +288,37 @@ class IBlobStorage  // NOLINT
 template <typename StorageT>
 class BlobStorage;
 
+// storage types whose BlobStorage is allocated from a per-thread pool; these back most blobs on the data path
+template <typename StorageT>
+struct is_pooled_blob_storage : std::false_type
+{};
+
+template <typename... Properties>
+struct is_pooled_blob_storage<buffer<Properties...>> : std::true_type
+{};
+
+template <typename... Properties>
+struct is_pooled_blob_storage<std::shared_ptr<buffer<Properties...>>> : std::true_type
+{};
+
+/**
+ * @brief Construct the shared BlobStorage for storage, pooling the allocation for common storage types
+ */
+template <typename StorageT>
+std::shared_ptr<IBlobStorage> make_blob_storage(StorageT&& storage)
+{
+    using storage_t = std::remove_cv_t<std::remove_reference_t<StorageT>>;
+    if constexpr (is_pooled_blob_storage<storage_t>::value)
+    {
+        return std::allocate_shared<BlobStorage<storage_t>>(detail::storage_pool_allocator<BlobStorage<storage_t>>(),
+                                                            std::move(storage));
+    }
+    else
+    {
+        return std::make_shared<BlobStorage<storage_t>>(std::move(storage));
+    }
+}
+
 template <typename... Properties>  // NOLINT
 class BlobStorage<buffer<Properties...>> final : public IBlobStorage
 {
@@ -112,7 +351,7 @@ class BlobStorage<buffer<Properties...>> final : public IBlobStorage
     {
         CHECK(stream == nullptr);
         auto b = buffer<Properties...>(bytes, m_buffer.view());
-        return std::make_shared<BlobStorage<buffer<Properties...>>>(std::move(b));
+        return make_blob_storage(std::move(b));
     }
 
     buffer<Properties...> m_buffer;
@@ -149,8 +388,8 @@ class BlobStorage<std::shared_ptr<buffer<Properties...>>> final : public IBlobSt
     std::shared_ptr<IBlobStorage> do_allocate(std::size_t bytes, cudaStream_t stream) const final
     {
         CHECK(stream == nullptr);
-        auto b = buffer<Properties...>(bytes, m_buffer.view());
-        return std::make_shared<BlobStorage<buffer<Properties...>>>(std::move(b));
+        auto b = buffer<Properties...>(bytes, m_buffer->view());
+        return make_blob_storage(std::move(b));
     }
 
     std::shared_ptr<buffer<Properties...>> m_buffer;
@@ -0,0 +1,506 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <srf/memory/blob_storage.hpp>
+#include <srf/memory/buffer.hpp>
+#include <srf/memory/memory_kind.hpp>
+#include <srf/memory/resource_view.hpp>
+#include <srf/utils/macros.hpp>
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace srf::memory {
+
+template <typename... Properties>
+class buffer_pool;
+
+/**
+ * @brief Move-only handle to a buffer owned by a buffer_pool; the buffer is returned to the pool on destruction.
+ */
+template <typename... Properties>
+class pooled_buffer final
+{
+  public:
+    using pool_type   = buffer_pool<Properties...>;
+    using buffer_type = buffer<Properties...>;
+
+    pooled_buffer() = default;
+    ~pooled_buffer()
+    {
+        release();
+    }
+
+    pooled_buffer(pooled_buffer&& other) noexcept :
+      m_pool(std::move(other.m_pool)),
+      m_buffer(std::exchange(other.m_buffer, nullptr))
+    {}
+
+    pooled_buffer& operator=(pooled_buffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            m_pool   = std::move(other.m_pool);
+            m_buffer = std::exchange(other.m_buffer, nullptr);
+        }
+        return *this;
+    }
+
+    DELETE_COPYABILITY(pooled_buffer);
+
+    void* data() noexcept
+    {
+        return (m_buffer != nullptr ? m_buffer->data() : nullptr);
+    }
+
+    const void* data() const noexcept
+    {
+        return (m_buffer != nullptr ? m_buffer->data() : nullptr);
+    }
+
+    std::size_t bytes() const noexcept
+    {
+        return (m_buffer != nullptr ? m_buffer->bytes() : 0);
+    }
+
+    memory_kind_type kind() const noexcept
+    {
+        return (m_buffer != nullptr ? m_buffer->kind() : memory_kind_type::none);
+    }
+
+    // the pool from which this buffer was acquired
+    const std::shared_ptr<pool_type>& pool() const noexcept
+    {
+        return m_pool;
+    }
+
+    // return the buffer to the pool; the handle is empty afterwards
+    void release()
+    {
+        if (m_buffer != nullptr)
+        {
+            m_pool->release(std::exchange(m_buffer, nullptr));
+            m_pool.reset();
+        }
+    }
+
+    bool empty() const
+    {
+        return not bool(*this);
+    }
+
+    operator bool() const
+    {
+        return m_buffer != nullptr;
+    }
+
+  private:
+    pooled_buffer(std::shared_ptr<pool_type> pool, buffer_type* buffer) : m_pool(std::move(pool)), m_buffer(buffer) {}
+
+    std::shared_ptr<pool_type> m_pool{nullptr};
+    buffer_type* m_buffer{nullptr};
+
+    friend pool_type;
+};
+
+/**
+ * @brief Pool of fixed-size buffers which are recycled rather than returned to the upstream resource
+ *
+ * Intended for hot paths which create and destroy same-size buffers at a high rate, e.g. per-message staging buffers.
+ * Each partition should own its own pool constructed from that partition's resource_view.
+ *
+ * Released buffers are cached on the releasing thread and handed back out by acquisitions on that thread without
+ * synchronization. Thread caches exchange buffers with a shared depot in batches of half the cache size, so the depot
+ * lock is taken at most once per cache_size / 2 operations in steady state. When the depot is empty the pool grows by
+ * up to one batch, never exceeding max_buffers. Once the pool has reached max_buffers, idle buffers sitting in the
+ * caches of other threads are drained back to the depot before the pool reports exhaustion; only if no buffer can be
+ * reclaimed does acquire throw std::bad_alloc and try_acquire return an empty handle.
+ *
+ * Each thread cache is guarded by its own mutex, which is uncontended except while a starved thread drains it.
+ *
+ * Buffers are only returned to the upstream resource when the pool is destroyed, which happens after the last
+ * pooled_buffer referencing it has been released.
+ */
+template <typename... Properties>
+class buffer_pool final : public std::enable_shared_from_this<buffer_pool<Properties...>>
+{
+  public:
+    using view_type   = resource_view<Properties...>;
+    using buffer_type = buffer<Properties...>;
+    using handle_type = pooled_buffer<Properties...>;
+
+    static constexpr std::size_t default_cache_size = 64;  // NOLINT
+
+    static std::shared_ptr<buffer_pool> create(view_type view,
+                                               std::size_t buffer_bytes,
+                                               std::size_t initial_buffers,
+                                               std::size_t max_buffers,
+                                               std::size_t cache_size = default_cache_size)
+    {
+        return std::shared_ptr<buffer_pool>(
+            new buffer_pool(std::move(view), buffer_bytes, initial_buffers, max_buffers, cache_size));
+    }
+
+    ~buffer_pool() = default;
+
+    DELETE_COPYABILITY(buffer_pool);
+    DELETE_MOVEABILITY(buffer_pool);
+
+    /**
+     * @brief Acquire a buffer of buffer_bytes
+     *
+     * @throws std::bad_alloc if the pool is exhausted and has reached max_buffers
+     */
+    handle_type acquire()
+    {
+        auto handle = try_acquire();
+        if (!handle)
+        {
+            throw std::bad_alloc{};
+        }
+        return handle;
+    }
+
+    /**
+     * @brief Acquire a buffer of buffer_bytes; returns an empty handle if the pool is exhausted
+     */
+    handle_type try_acquire()
+    {
+        auto* cache = local_cache();
+        std::unique_lock<std::mutex> cache_lock;
+        if (cache != nullptr)
+        {
+            cache_lock = std::unique_lock<std::mutex>(cache->mutex);
+            if (!cache->buffers.empty())
+            {
+                auto* buffer = cache->buffers.back();
+                cache->buffers.pop_back();
+                return handle_type(this->shared_from_this(), buffer);
+            }
+        }
+
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (m_free.empty())
+        {
+            grow();
+        }
+        if (m_free.empty())
+        {
+            drain_peer_caches(cache);
+            if (m_free.empty())
+            {
+                return {};
+            }
+        }
+
+        auto* buffer = m_free.back();
+        m_free.pop_back();
+
+        // refill the local cache with up to a batch so the next acquisitions on this thread skip the depot
+        if (cache != nullptr)
+        {
+            auto count = std::min(m_batch_size, m_free.size());
+            cache->buffers.insert(cache->buffers.end(), m_free.end() - count, m_free.end());
+            m_free.resize(m_free.size() - count);
+        }
+
+        return handle_type(this->shared_from_this(), buffer);
+    }
+
+    // size in bytes of each buffer
+    std::size_t buffer_bytes() const
+    {
+        return m_buffer_bytes;
+    }
+
+    // number of buffers allocated from the upstream resource
+    std::size_t size() const
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    // maximum number of buffers the pool will allocate
+    std::size_t max_size() const
+    {
+        return m_max_buffers;
+    }
+
+    // number of free buffers held by the shared depot; buffers sitting in thread caches are not counted
+    std::size_t depot_size() const
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        return m_free.size();
+    }
+
+    const view_type& view() const
+    {
+        return m_view;
+    }
+
+  private:
+    buffer_pool(view_type view,
+                std::size_t buffer_bytes,
+                std::size_t initial_buffers,
+                std::size_t max_buffers,
+                std::size_t cache_size) :
+      m_view(std::move(view)),
+      m_buffer_bytes(buffer_bytes),
+      m_max_buffers(max_buffers),
+      m_cache_size(cache_size),
+      m_batch_size(std::max<std::size_t>(cache_size / 2, 1)),
+      m_id(next_id())
+    {
+        CHECK_GT(m_buffer_bytes, 0);
+        CHECK_LE(initial_buffers, m_max_buffers);
+
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        while (m_buffers.size() < initial_buffers)
+        {
+            add_buffer();
+        }
+    }
+
+    struct thread_cache  // NOLINT
+    {
+        std::uint64_t id;
+        std::weak_ptr<buffer_pool> pool;
+        std::vector<buffer_type*> buffers;
+
+        // held by the owning thread while it uses the cache and by a starved thread while it drains the cache
+        std::mutex mutex;
+
+        ~thread_cache()
+        {
+            // if the pool is gone, the buffers were freed with it
+            if (auto pool = this->pool.lock())
+            {
+                pool->retire_cache(this);
+            }
+        }
+    };
+
+    struct thread_caches  // NOLINT
+    {
+        std::vector<std::unique_ptr<thread_cache>> caches;
+
+        ~thread_caches()
+        {
+            s_exited = true;
+        }
+    };
+
+    void release(buffer_type* buffer)
+    {
+        auto* cache = local_cache();
+        if (cache == nullptr)
+        {
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            m_free.push_back(buffer);
+            return;
+        }
+
+        std::lock_guard<std::mutex> cache_lock(cache->mutex);
+        cache->buffers.push_back(buffer);
+        if (cache->buffers.size() >= m_cache_size)
+        {
+            return_to_depot(cache->buffers, m_batch_size);
+        }
+    }
+
+    // move the last count buffers of a thread cache back to the depot
+    void return_to_depot(std::vector<buffer_type*>& buffers, std::size_t count)
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_free.insert(m_free.end(), buffers.end() - count, buffers.end());
+        buffers.resize(buffers.size() - count);
+    }
+
+    // return the buffers of an exiting thread's cache to the depot and forget the cache
+    void retire_cache(thread_cache* cache)
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_free.insert(m_free.end(), cache->buffers.begin(), cache->buffers.end());
+        cache->buffers.clear();
+        m_caches.erase(std::remove(m_caches.begin(), m_caches.end(), cache), m_caches.end());
+    }
+
+    // move the buffers cached by other threads to the depot; caller holds m_mutex and, if non-null, the lock of the
+    // calling thread's own cache. caches in use by their owner are skipped, their owner holds the lock only briefly
+    void drain_peer_caches(thread_cache* own)
+    {
+        for (auto* cache : m_caches)
+        {
+            if (cache == own)
+            {
+                continue;
+            }
+            std::unique_lock<std::mutex> cache_lock(cache->mutex, std::try_to_lock);
+            if (cache_lock.owns_lock())
+            {
+                m_free.insert(m_free.end(), cache->buffers.begin(), cache->buffers.end());
+                cache->buffers.clear();
+            }
+        }
+    }
+
+    // grow the pool by up to one batch; caller holds m_mutex
+    void grow()
+    {
+        auto count = std::min(m_batch_size, m_max_buffers - m_buffers.size());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            add_buffer();
+        }
+    }
+
+    // caller holds m_mutex
+    void add_buffer()
+    {
+        m_buffers.push_back(std::make_unique<buffer_type>(m_buffer_bytes, m_view));
+        m_free.push_back(m_buffers.back().get());
+        m_size.store(m_buffers.size(), std::memory_order_relaxed);
+    }
+
+    // the calling thread's cache for this pool; returns nullptr once the thread's caches have been destroyed
+    thread_cache* local_cache()
+    {
+        if (s_exited || m_cache_size == 0)
+        {
+            return nullptr;
+        }
+
+        thread_local thread_caches t_caches;
+        auto& caches = t_caches.caches;
+
+        for (auto& cache : caches)
+        {
+            if (cache->id == m_id)
+            {
+                return cache.get();
+            }
+        }
+
+        // first use of this pool on this thread; drop caches of pools which no longer exist
+        caches.erase(std::remove_if(caches.begin(), caches.end(), [](const auto& c) { return c->pool.expired(); }),
+                     caches.end());
+
+        auto cache = std::make_unique<thread_cache>();
+        cache->id   = m_id;
+        cache->pool = this->weak_from_this();
+        cache->buffers.reserve(m_cache_size);
+        {
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            m_caches.push_back(cache.get());
+        }
+        caches.push_back(std::move(cache));
+        return caches.back().get();
+    }
+
+    static std::uint64_t next_id()
+    {
+        static std::atomic<std::uint64_t> s_next_id{0};
+        return ++s_next_id;
+    }
+
+    view_type m_view;
+    const std::size_t m_buffer_bytes;
+    const std::size_t m_max_buffers;
+    const std::size_t m_cache_size;
+    const std::size_t m_batch_size;
+    const std::uint64_t m_id;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<buffer_type>> m_buffers;
+    std::vector<buffer_type*> m_free;
+
+    // caches of the threads which have used this pool; guarded by m_mutex
+    std::vector<thread_cache*> m_caches;
+    std::atomic<std::size_t> m_size{0};
+
+    static inline thread_local bool s_exited{false};
+
+    friend handle_type;
+};
+
+template <typename... Properties>
+struct is_pooled_blob_storage<pooled_buffer<Properties...>> : std::true_type
+{};
+
+/**
+ * @brief Allows a pooled_buffer to back a memory::blob; the buffer returns to its pool when the last blob is dropped.
+ *
+ * allocate() of a pool-sized block is served from the same pool; other sizes are allocated from the pool's view.
+ */
+template <typename... Properties>
+class BlobStorage<pooled_buffer<Properties...>> final : public IBlobStorage
+{
+  public:
+    BlobStorage(pooled_buffer<Properties...>&& buffer) : m_buffer(std::move(buffer)) {}
+    ~BlobStorage() final = default;
+
+  private:
+    void* do_data() final
+    {
+        return m_buffer.data();
+    }
+
+    const void* do_data() const final
+    {
+        return m_buffer.data();
+    }
+
+    std::size_t do_bytes() const final
+    {
+        return m_buffer.bytes();
+    }
+
+    memory_kind_type do_kind() const final
+    {
+        return m_buffer.kind();
+    }
+
+    std::shared_ptr<IBlobStorage> do_allocate(std::size_t bytes, cudaStream_t stream) const final
+    {
+        const auto& pool = m_buffer.pool();
+        if (bytes == pool->buffer_bytes())
+        {
+            auto pooled = pool->try_acquire();
+            if (pooled)
+            {
+                return make_blob_storage(std::move(pooled));
+            }
+        }
+        return make_blob_storage(buffer<Properties...>(bytes, pool->view()));
+    }
+
+    pooled_buffer<Properties...> m_buffer;
+};
+
+}  // namespace srf::memory
@@ -22,12 +22,23 @@
 #include <glog/logging.h>
 
 #include <cstddef>
-#include <map>
-#include <queue>
+#include <cstdint>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace srf::memory {
 
+/**
+ * @brief Maps addresses to the non-overlapping blocks which contain them.
+ *
+ * Blocks are held in a flat vector sorted by starting address with the starting addresses mirrored in a separate
+ * contiguous array, so a lookup is a branchless binary search over a dense array of integers followed by a single
+ * bounds check on the candidate block. Inserts and removals are O(n), which is the right trade for the mostly static
+ * sets of registered blocks on the network path where lookups vastly outnumber registrations.
+ *
+ * block_manager is not thread safe; see concurrent_block_manager for wait-free lookups with concurrent registrations.
+ */
 template <typename BlockType>
 class block_manager final
 {
@@ -39,11 +50,15 @@ class block_manager final
     block_manager()  = default;
     ~block_manager() = default;
 
-    block_manager(block_manager&& other) noexcept : m_block_map(std::move(other.m_block_map)) {}
+    block_manager(block_manager&& other) noexcept :
+      m_starts(std::move(other.m_starts)),
+      m_blocks(std::move(other.m_blocks))
+    {}
 
     block_manager& operator=(block_manager&& other)
     {
-        m_block_map = std::move(other.m_block_map);
+        m_starts = std::move(other.m_starts);
+        m_blocks = std::move(other.m_blocks);
         return *this;
     }
 
@@ -52,76 +67,100 @@ class block_manager final
 
     const block_type& add_block(block_type&& block)
     {
-        auto key = reinterpret_cast<std::uintptr_t>(block.data()) + block.bytes();
-        DCHECK(!owns(block.data()) && !owns(reinterpret_cast<void*>(key - 1)))
+        auto start = reinterpret_cast<std::uintptr_t>(block.data());
+        auto end   = start + block.bytes();
+        DCHECK(!owns(block.data()) && !owns(reinterpret_cast<void*>(end - 1)))
             << "block manager already owns a block with an overlapping address";
-        DVLOG(1) << "adding block: " << key << " - " << block.data() << "; " << block.bytes();
-        m_block_map[key] = std::move(block);
-        return m_block_map[key];
+        DCHECK(!overlaps_next(start, end)) << "block manager already owns a block with an overlapping address";
+        DVLOG(1) << "adding block: " << block.data() << "; " << block.bytes();
+
+        auto idx = upper_bound(start);
+        m_starts.insert(m_starts.begin() + idx, start);
+        return *m_blocks.insert(m_blocks.begin() + idx, std::move(block));
     }
 
-    const block_type* find_block(void* ptr) const
+    const block_type* find_block(const void* ptr) const
     {
-        auto search = find_entry(ptr);
-        if (search != m_block_map.end() && search->second.contains(ptr))
-        {
-            DVLOG(3) << this << ": block found";
-            return &search->second;
-        }
-        DVLOG(3) << this << ": no block found for " << ptr;
-        return nullptr;
+        auto idx = find_index(ptr);
+        return (idx == npos ? nullptr : &m_blocks[idx]);
     }
 
-    void drop_block(void* ptr)
+    void drop_block(const void* ptr)
     {
         DVLOG(1) << "dropping block: " << ptr;
-        auto search = find_entry(ptr);
-        if (search != m_block_map.end() && search->second.contains(ptr))
+        auto idx = find_index(ptr);
+        if (idx != npos)
         {
-            DVLOG(3) << "found block; dropping block: " << search->first << "; " << search->second.data();
-            m_block_map.erase(search);
+            m_starts.erase(m_starts.begin() + idx);
+            m_blocks.erase(m_blocks.begin() + idx);
         }
     }
 
     auto size() const noexcept
     {
-        return m_block_map.size();
+        return m_blocks.size();
     }
 
     void clear() noexcept
     {
         DVLOG(2) << "clearing block map";
-        m_block_map.clear();
+        m_starts.clear();
+        m_blocks.clear();
+    }
+
+    // blocks sorted by starting address
+    const std::vector<BlockType>& blocks() const noexcept
+    {
+        return m_blocks;
     }
 
-    std::vector<BlockType> blocks() const noexcept
+    bool owns(const void* addr) const
     {
-        DVLOG(2) << "getting a vector of blocks - " << m_block_map.size();
-        std::vector<BlockType> v;
-        v.reserve(m_block_map.size());
-        for (const auto& it : m_block_map)
+        return find_index(addr) != npos;
+    }
+
+  private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);  // NOLINT
+
+    // number of blocks whose starting address is <= key
+    std::size_t upper_bound(std::uintptr_t key) const
+    {
+        std::size_t n = m_starts.size();
+        if (n == 0)
         {
-            v.push_back(it.second.pointer());
+            return 0;
         }
-        return v;
+        const std::uintptr_t* base = m_starts.data();
+        while (n > 1)
+        {
+            auto half = n / 2;
+            // compiles to a conditional move; the loop trip count depends only on the size
+            base = (base[half] <= key ? base + half : base);
+            n -= half;
+        }
+        return static_cast<std::size_t>(base - m_starts.data()) + static_cast<std::size_t>(*base <= key);
     }
 
-    bool owns(void* addr)
+    // index of the block containing ptr, or npos
+    std::size_t find_index(const void* ptr) const
     {
-        auto block = find_block(addr);
-        return (block && block->contains(addr));
+        auto idx = upper_bound(reinterpret_cast<std::uintptr_t>(ptr));
+        if (idx == 0 || !m_blocks[idx - 1].contains(const_cast<void*>(ptr)))
+        {
+            return npos;
+        }
+        return idx - 1;
     }
 
-  private:
-    inline auto find_entry(const void* ptr) const
+    // true if the block following start begins before end
+    bool overlaps_next(std::uintptr_t start, std::uintptr_t end) const
     {
-        DVLOG(3) << "looking for block containing: " << ptr;
-        auto key = reinterpret_cast<std::uintptr_t>(ptr);
-        return m_block_map.upper_bound(key);
+        auto idx = upper_bound(start);
+        return idx < m_starts.size() && m_starts[idx] < end;
     }
 
-    // todo: used a static block allocator here to avoid allocation issues
-    std::map<std::uintptr_t, block_type> m_block_map;
+    std::vector<std::uintptr_t> m_starts;
+    std::vector<block_type> m_blocks;
 };
 
 }  // namespace srf::memory
@@ -0,0 +1,143 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <srf/memory/core/block_manager.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace srf::memory {
+
+/**
+ * @brief block_manager with wait-free lookups which may run concurrently with registrations.
+ *
+ * Implements the left-right concurrency control technique: two block_manager instances are maintained; readers
+ * always search the instance which is not being modified, and never block or retry. Writers are serialized by a mutex,
+ * apply each mutation to the inactive instance, publish it to readers, wait for in-flight readers of the other
+ * instance to drain, then apply the same mutation to the second instance.
+ *
+ * Lookups return the block by value since a reference would not be safe once the reader has departed.
+ */
+template <typename BlockType>
+class concurrent_block_manager final
+{
+  public:
+    using block_type = BlockType;
+
+    concurrent_block_manager()  = default;
+    ~concurrent_block_manager() = default;
+
+    concurrent_block_manager(const concurrent_block_manager&) = delete;
+    concurrent_block_manager& operator=(const concurrent_block_manager&) = delete;
+
+    /**
+     * @brief Find the block containing ptr; wait-free
+     */
+    std::optional<block_type> find_block(const void* ptr) const
+    {
+        auto version = m_version.load();
+        m_readers[version].fetch_add(1);
+        const auto* block = m_instances[m_active.load()].find_block(ptr);
+        std::optional<block_type> result = (block == nullptr ? std::nullopt : std::optional<block_type>(*block));
+        m_readers[version].fetch_sub(1);
+        return result;
+    }
+
+    void add_block(block_type&& block)
+    {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        auto copy = block;
+        write([&block, &copy](block_manager<block_type>& instance, bool first) {
+            instance.add_block(first ? std::move(copy) : std::move(block));
+        });
+    }
+
+    /**
+     * @brief Drop the block containing ptr and return it
+     */
+    std::optional<block_type> drop_block(const void* ptr)
+    {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        const auto* block = m_instances[m_active.load()].find_block(ptr);
+        if (block == nullptr)
+        {
+            return std::nullopt;
+        }
+        std::optional<block_type> dropped(*block);
+        write([ptr](block_manager<block_type>& instance, bool) { instance.drop_block(ptr); });
+        return dropped;
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        return m_instances[m_active.load()].size();
+    }
+
+    std::vector<block_type> blocks() const
+    {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        return m_instances[m_active.load()].blocks();
+    }
+
+  private:
+    // apply a mutation to both instances; the caller must hold the writer mutex
+    template <typename MutationT>
+    void write(MutationT mutation)
+    {
+        auto active   = m_active.load();
+        auto inactive = active ^ 1U;
+
+        // no reader can observe the inactive instance
+        mutation(m_instances[inactive], true);
+
+        // new readers search the updated instance
+        m_active.store(inactive);
+
+        // drain readers which may still be searching the previously active instance
+        auto version = m_version.load();
+        wait_for_readers(version ^ 1U);
+        m_version.store(version ^ 1U);
+        wait_for_readers(version);
+
+        mutation(m_instances[active], false);
+    }
+
+    void wait_for_readers(std::uint32_t version) const
+    {
+        while (m_readers[version].load() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    std::array<block_manager<block_type>, 2> m_instances;
+    std::atomic<std::uint32_t> m_active{0};
+    std::atomic<std::uint32_t> m_version{0};
+    mutable std::array<std::atomic<std::int64_t>, 2> m_readers{};
+    mutable std::mutex m_writer_mutex;
+};
+
+}  // namespace srf::memory
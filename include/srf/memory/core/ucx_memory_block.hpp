@@ -18,59 +18,67 @@
 #pragma once
 
 #include <srf/memory/core/memory_block.hpp>
-//#include "internal/ucx/context.hpp"
 
 #include <glog/logging.h>
+#include <ucp/api/ucp_def.h>
+
+#include <cstddef>
 
 namespace srf::memory {
 
+/**
+ * @brief memory_block which has been registered with ucx; holds the local memory handle and the packed remote key
+ */
 struct ucx_memory_block : public memory_block
 {
-    //   public:
-    //     ucx_memory_block() = default;
-    //     ucx_memory_block(void* data, std::size_t bytes) : memory_block(data, bytes) {}
-    //     ucx_memory_block(
-    //         void* data, std::size_t bytes, ucp_mem_h local_handle, void* remote_handle, std::size_t
-    //         remote_handle_size) :
-    //       memory_block(data, bytes),
-    //       m_local_handle(local_handle),
-    //       m_remote_handle(remote_handle),
-    //       m_remote_handle_size(remote_handle_size)
-    //     {
-    //         if (m_remote_handle || m_remote_handle_size)
-    //             CHECK(m_remote_handle && m_remote_handle_size);
-    //     }
-    //     ucx_memory_block(const memory_block& block,
-    //                      ucp_mem_h local_handle,
-    //                      void* remote_handle,
-    //                      std::size_t remote_handle_size) :
-    //       memory_block(block),
-    //       m_local_handle(local_handle),
-    //       m_remote_handle(remote_handle),
-    //       m_remote_handle_size(remote_handle_size)
-    //     {
-    //         if (m_remote_handle || m_remote_handle_size)
-    //             CHECK(m_remote_handle && m_remote_handle_size);
-    //     }
-    //     ~ucx_memory_block() override = default;
+  public:
+    ucx_memory_block() = default;
+    ucx_memory_block(void* data, std::size_t bytes) : memory_block(data, bytes) {}
+    ucx_memory_block(
+        void* data, std::size_t bytes, ucp_mem_h local_handle, void* remote_handle, std::size_t remote_handle_size) :
+      memory_block(data, bytes),
+      m_local_handle(local_handle),
+      m_remote_handle(remote_handle),
+      m_remote_handle_size(remote_handle_size)
+    {
+        if (m_remote_handle || m_remote_handle_size)
+        {
+            CHECK(m_remote_handle && m_remote_handle_size);
+        }
+    }
+    ucx_memory_block(const memory_block& block,
+                     ucp_mem_h local_handle,
+                     void* remote_handle,
+                     std::size_t remote_handle_size) :
+      memory_block(block),
+      m_local_handle(local_handle),
+      m_remote_handle(remote_handle),
+      m_remote_handle_size(remote_handle_size)
+    {
+        if (m_remote_handle || m_remote_handle_size)
+        {
+            CHECK(m_remote_handle && m_remote_handle_size);
+        }
+    }
+    ~ucx_memory_block() override = default;
 
-    //     ucp_mem_h local_handle() const
-    //     {
-    //         return m_local_handle;
-    //     }
-    //     void* remote_handle() const
-    //     {
-    //         return m_remote_handle;
-    //     }
-    //     std::size_t remote_handle_size() const
-    //     {
-    //         return m_remote_handle_size;
-    //     }
+    ucp_mem_h local_handle() const
+    {
+        return m_local_handle;
+    }
+    void* remote_handle() const
+    {
+        return m_remote_handle;
+    }
+    std::size_t remote_handle_size() const
+    {
+        return m_remote_handle_size;
+    }
 
-    //   private:
-    //     ucp_mem_h m_local_handle{nullptr};
-    //     void* m_remote_handle{nullptr};
-    //     std::size_t m_remote_handle_size{0};
+  private:
+    ucp_mem_h m_local_handle{nullptr};
+    void* m_remote_handle{nullptr};
+    std::size_t m_remote_handle_size{0};
 };
 
 }  // namespace srf::memory
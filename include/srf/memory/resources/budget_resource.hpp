@@ -0,0 +1,231 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <srf/memory/adaptors.hpp>
+#include <srf/metrics/gauge.hpp>
+#include <srf/metrics/registry.hpp>
+#include <srf/utils/bytes_to_string.hpp>
+
+#include <glog/logging.h>
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/mutex.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+
+namespace srf::memory {
+
+/**
+ * @brief Adaptor which bounds the bytes outstanding from its upstream and applies backpressure when the bound is hit
+ *
+ * An allocation which would take the outstanding bytes past the limit is handled by the overflow policy:
+ * - block: the caller waits until enough memory has been returned; if a timeout is set and expires first, the
+ *   allocation is shed
+ * - shed: the allocation fails immediately with std::bad_alloc
+ *
+ * Waiting uses fiber-aware synchronization, so blocked fibers yield their thread to the fibers which will eventually
+ * release memory. An allocation larger than the limit can never succeed and is always shed.
+ *
+ * Place a budget_resource above an arena_resource, with a limit below the arena's maximum size, so that a slow consumer
+ * holding large buffers in deep channels stalls its producers instead of exhausting the arena and aborting.
+ *
+ * The high watermark is an advisory threshold which ingress points may poll via above_high_watermark() to throttle or
+ * shed work before allocations begin to block.
+ */
+template <typename Upstream>
+class budget_resource final : public upstream_resource<Upstream>
+{
+  public:
+    enum class overflow_policy
+    {
+        block,
+        shed,
+    };
+
+    budget_resource(Upstream upstream,
+                    std::size_t limit,
+                    overflow_policy policy           = overflow_policy::block,
+                    std::chrono::milliseconds timeout = std::chrono::milliseconds::zero(),
+                    double high_watermark             = 0.8) :
+      upstream_resource<Upstream>(std::move(upstream), "budget"),
+      m_limit(limit),
+      m_high_watermark(static_cast<std::size_t>(high_watermark * static_cast<double>(limit))),
+      m_policy(policy),
+      m_timeout(timeout)
+    {
+        CHECK_GT(m_limit, 0);
+        CHECK(high_watermark > 0.0 && high_watermark <= 1.0);
+    }
+    ~budget_resource() override = default;
+
+    std::size_t limit() const
+    {
+        return m_limit;
+    }
+
+    std::size_t outstanding_bytes() const
+    {
+        return m_outstanding.load(std::memory_order_relaxed);
+    }
+
+    bool above_high_watermark() const
+    {
+        return outstanding_bytes() >= m_high_watermark;
+    }
+
+    // number of allocations which had to wait for memory to be returned
+    std::uint64_t blocked_allocations() const
+    {
+        return m_blocked.load(std::memory_order_relaxed);
+    }
+
+    // number of allocations rejected with std::bad_alloc
+    std::uint64_t shed_allocations() const
+    {
+        return m_shed.load(std::memory_order_relaxed);
+    }
+
+    void register_metrics(metrics::Registry& registry)
+    {
+        const std::map<std::string, std::string> labels{{"resource", this->tag()}};
+        m_gauges = std::make_unique<gauges>(gauges{registry.make_gauge("srf_memory_budget_limit_bytes", labels),
+                                                   registry.make_gauge("srf_memory_budget_outstanding_bytes", labels),
+                                                   registry.make_gauge("srf_memory_budget_blocked_allocations", labels),
+                                                   registry.make_gauge("srf_memory_budget_shed_allocations", labels)});
+    }
+
+    void update_metrics()
+    {
+        CHECK(m_gauges) << "register_metrics must be called before update_metrics";
+        m_gauges->limit.set(m_limit);
+        m_gauges->outstanding.set(outstanding_bytes());
+        m_gauges->blocked.set(blocked_allocations());
+        m_gauges->shed.set(shed_allocations());
+    }
+
+  private:
+    struct gauges  // NOLINT
+    {
+        metrics::Gauge limit;
+        metrics::Gauge outstanding;
+        metrics::Gauge blocked;
+        metrics::Gauge shed;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) final
+    {
+        if (!try_reserve(bytes) && !await_reserve(bytes))
+        {
+            ++m_shed;
+            throw std::bad_alloc{};
+        }
+
+        try
+        {
+            return this->resource()->allocate(bytes, alignment);
+        } catch (...)
+        {
+            release(bytes);
+            throw;
+        }
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) final
+    {
+        this->resource()->deallocate(ptr, bytes, alignment);
+        release(bytes);
+    }
+
+    bool try_reserve(std::size_t bytes)
+    {
+        // sequentially consistent with release() so a waiter cannot miss a release which races with it going to sleep
+        auto outstanding = m_outstanding.load();
+        while (outstanding + bytes <= m_limit)
+        {
+            if (m_outstanding.compare_exchange_weak(outstanding, outstanding + bytes))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool await_reserve(std::size_t bytes)
+    {
+        if (m_policy == overflow_policy::shed || bytes > m_limit)
+        {
+            return false;
+        }
+
+        ++m_blocked;
+        DVLOG(10) << this->tag() << ": budget of " << bytes_to_string(m_limit) << " exhausted; blocking allocation of "
+                  << bytes_to_string(bytes);
+
+        std::unique_lock<decltype(m_mutex)> lock(m_mutex);
+        ++m_waiters;
+        auto reserved = [this, bytes] { return try_reserve(bytes); };
+        bool ok       = true;
+        if (m_timeout == std::chrono::milliseconds::zero())
+        {
+            m_cv.wait(lock, reserved);
+        }
+        else
+        {
+            ok = m_cv.wait_for(lock, m_timeout, reserved);
+        }
+        --m_waiters;
+        return ok;
+    }
+
+    void release(std::size_t bytes)
+    {
+        m_outstanding.fetch_sub(bytes);
+
+        // only touch the lock when an allocation is waiting
+        if (m_waiters.load() != 0)
+        {
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            m_cv.notify_all();
+        }
+    }
+
+    const std::size_t m_limit;
+    const std::size_t m_high_watermark;
+    const overflow_policy m_policy;
+    const std::chrono::milliseconds m_timeout;
+
+    std::atomic<std::size_t> m_outstanding{0};
+    std::atomic<std::uint64_t> m_blocked{0};
+    std::atomic<std::uint64_t> m_shed{0};
+
+    std::atomic<std::size_t> m_waiters{0};
+    boost::fibers::mutex m_mutex;
+    boost::fibers::condition_variable m_cv;
+
+    std::unique_ptr<gauges> m_gauges;
+};
+
+}  // namespace srf::memory
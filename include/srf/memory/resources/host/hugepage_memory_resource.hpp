@@ -0,0 +1,183 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <srf/memory/resources/memory_resource.hpp>
+
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <set>
+
+namespace srf::memory {
+
+/**
+ * @brief Host memory resource backed by anonymous mappings which request huge pages and optionally pre-fault memory
+ *
+ * - hugetlb: allocations are first attempted with mmap(MAP_HUGETLB) from the explicitly reserved huge page pool; if
+ *   the pool is exhausted or not configured, the allocation falls back to the transparent policy
+ * - transparent: allocations are aligned to the huge page size and advised with madvise(MADV_HUGEPAGE) so the kernel
+ *   may back them with transparent huge pages; if THP is disabled the memory is backed by regular pages
+ *
+ * With prefault enabled, every page of an allocation is touched before it is returned so first-touch page faults are
+ * paid at allocation time rather than in the data path. When used as the upstream of an arena_resource, the arena's
+ * initial size is pre-faulted on construction and each later growth is pre-faulted as it is acquired.
+ *
+ * Allocations are rounded up to a multiple of the huge page size; this resource is intended as an upstream for
+ * suballocators, not for small allocations.
+ */
+class hugepage_memory_resource final : public memory_resource<::cuda::memory_kind::host>
+{
+  public:
+    enum class policy
+    {
+        hugetlb,
+        transparent,
+    };
+
+    static constexpr std::size_t huge_page_size = 2UL << 20;  // NOLINT
+
+    hugepage_memory_resource(policy p = policy::transparent, bool prefault = false) :
+      memory_resource("hugepage"),
+      m_policy(p),
+      m_prefault(prefault)
+    {}
+    ~hugepage_memory_resource() override = default;
+
+    // number of bytes currently mapped from the explicit huge page pool
+    std::size_t hugetlb_bytes() const
+    {
+        return m_hugetlb_bytes;
+    }
+
+  private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) final
+    {
+        if (bytes == 0)
+        {
+            return nullptr;
+        }
+
+        CHECK_LE(alignment, huge_page_size);
+        const auto length = mapped_length(bytes);
+
+        if (m_policy == policy::hugetlb)
+        {
+            auto flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (m_prefault ? MAP_POPULATE : 0);
+            void* ptr  = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (ptr != MAP_FAILED)
+            {
+                std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+                m_hugetlb_regions.insert(ptr);
+                m_hugetlb_bytes += length;
+                return ptr;
+            }
+            DVLOG(10) << "hugetlb mapping of " << length << " bytes failed; falling back to transparent huge pages";
+        }
+
+        return map_transparent(length);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t /*__alignment*/) final
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        const auto length = mapped_length(bytes);
+        if (m_policy == policy::hugetlb)
+        {
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            if (m_hugetlb_regions.erase(ptr) != 0)
+            {
+                m_hugetlb_bytes -= length;
+            }
+        }
+        CHECK_EQ(::munmap(ptr, length), 0);
+    }
+
+    memory_kind_type do_kind() const final
+    {
+        return memory_kind_type::host;
+    }
+
+    static std::size_t mapped_length(std::size_t bytes)
+    {
+        return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+    }
+
+    void* map_transparent(std::size_t length)
+    {
+        // over-map by one huge page so the region can be trimmed to a huge page aligned start
+        const auto padded = length + huge_page_size;
+        void* ptr         = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            throw std::bad_alloc{};
+        }
+
+        auto start   = reinterpret_cast<std::uintptr_t>(ptr);
+        auto aligned = (start + huge_page_size - 1) & ~(huge_page_size - 1);
+        auto head    = aligned - start;
+        auto tail    = padded - head - length;
+        if (head != 0)
+        {
+            CHECK_EQ(::munmap(ptr, head), 0);
+        }
+        if (tail != 0)
+        {
+            CHECK_EQ(::munmap(reinterpret_cast<void*>(aligned + length), tail), 0);
+        }
+
+        auto* region = reinterpret_cast<void*>(aligned);
+        if (::madvise(region, length, MADV_HUGEPAGE) != 0)
+        {
+            DVLOG(10) << "madvise(MADV_HUGEPAGE) failed; memory will be backed by regular pages";
+        }
+
+        if (m_prefault)
+        {
+            // advise before touching so the faults are served with huge pages when available
+            static const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            auto* bytes                 = static_cast<volatile std::byte*>(region);
+            for (std::size_t offset = 0; offset < length; offset += page_size)
+            {
+                bytes[offset] = std::byte{0};
+            }
+        }
+
+        return region;
+    }
+
+    const policy m_policy;
+    const bool m_prefault;
+    std::atomic<std::size_t> m_hugetlb_bytes{0};
+
+    // start addresses of the regions mapped from the explicit huge page pool
+    std::set<void*> m_hugetlb_regions;
+    std::mutex m_mutex;
+};
+
+}  // namespace srf::memory
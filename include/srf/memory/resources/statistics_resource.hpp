@@ -0,0 +1,262 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <srf/memory/adaptors.hpp>
+#include <srf/metrics/gauge.hpp>
+#include <srf/metrics/registry.hpp>
+
+#include <glog/logging.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace srf::memory {
+
+/**
+ * @brief Point-in-time view of the statistics gathered by a statistics_resource
+ *
+ * Histograms are indexed by log2 size class: bin i counts allocations of [2^i, 2^(i+1)) bytes, or for lifetimes,
+ * [2^i, 2^(i+1)) microseconds.
+ */
+struct allocation_statistics
+{
+    static constexpr std::size_t histogram_bins = 64;  // NOLINT
+    using histogram_type                        = std::array<std::uint64_t, histogram_bins>;
+
+    std::uint64_t allocations{0};
+    std::uint64_t deallocations{0};
+    std::uint64_t allocated_bytes{0};
+    std::uint64_t deallocated_bytes{0};
+    std::uint64_t live_bytes{0};
+    std::uint64_t peak_bytes{0};
+    histogram_type size_histogram{};
+
+    std::uint64_t sampled_lifetimes{0};
+    histogram_type lifetime_histogram{};
+};
+
+/**
+ * @brief Adaptor which gathers allocation statistics for its upstream resource without logging each allocation
+ *
+ * Counters and size-class histograms are sharded across cache-line padded slots selected by the calling thread, so
+ * concurrent allocators do not contend. Live and peak bytes are tracked with a single shared counter, which is the
+ * only cross-thread atomic on the allocation path.
+ *
+ * Allocation lifetimes are sampled: an allocation is sampled when the hash of its address selects it, so the
+ * deallocation path can identify sampled pointers without a lookup. A lifetime_sample_rate of N samples roughly one in
+ * N allocations; zero disables lifetime sampling.
+ *
+ * register_metrics() binds the statistics to gauges in a metrics::Registry labeled by the resource's tag;
+ * update_metrics() publishes the current snapshot to those gauges.
+ */
+template <typename Upstream>
+class statistics_resource final : public upstream_resource<Upstream>
+{
+    static constexpr std::size_t shard_count = 32;  // NOLINT
+
+  public:
+    statistics_resource(Upstream upstream, std::size_t lifetime_sample_rate = 1024) :
+      upstream_resource<Upstream>(std::move(upstream), "statistics"),
+      m_lifetime_sample_rate(lifetime_sample_rate)
+    {}
+    ~statistics_resource() override = default;
+
+    allocation_statistics statistics() const
+    {
+        allocation_statistics stats;
+        for (const auto& shard : m_shards)
+        {
+            stats.allocations += shard.allocations.load(std::memory_order_relaxed);
+            stats.deallocations += shard.deallocations.load(std::memory_order_relaxed);
+            stats.allocated_bytes += shard.allocated_bytes.load(std::memory_order_relaxed);
+            stats.deallocated_bytes += shard.deallocated_bytes.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < allocation_statistics::histogram_bins; ++i)
+            {
+                stats.size_histogram[i] += shard.size_histogram[i].load(std::memory_order_relaxed);
+            }
+        }
+        stats.live_bytes = m_live_bytes.load(std::memory_order_relaxed);
+        stats.peak_bytes = m_peak_bytes.load(std::memory_order_relaxed);
+
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        stats.sampled_lifetimes  = m_sampled_lifetimes;
+        stats.lifetime_histogram = m_lifetime_histogram;
+        return stats;
+    }
+
+    void register_metrics(metrics::Registry& registry)
+    {
+        const std::map<std::string, std::string> labels{{"resource", this->tag()}};
+
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_registry = &registry;
+        m_gauges   = std::make_unique<gauges>(gauges{registry.make_gauge("srf_memory_allocations", labels),
+                                                   registry.make_gauge("srf_memory_deallocations", labels),
+                                                   registry.make_gauge("srf_memory_allocated_bytes", labels),
+                                                   registry.make_gauge("srf_memory_live_bytes", labels),
+                                                   registry.make_gauge("srf_memory_peak_bytes", labels)});
+        m_size_class_gauges.clear();
+    }
+
+    void update_metrics()
+    {
+        auto stats = statistics();
+
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        CHECK(m_registry && m_gauges) << "register_metrics must be called before update_metrics";
+
+        m_gauges->allocations.set(stats.allocations);
+        m_gauges->deallocations.set(stats.deallocations);
+        m_gauges->allocated_bytes.set(stats.allocated_bytes);
+        m_gauges->live_bytes.set(stats.live_bytes);
+        m_gauges->peak_bytes.set(stats.peak_bytes);
+
+        // size classes are exported lazily as they are first observed
+        for (std::size_t i = 0; i < allocation_statistics::histogram_bins; ++i)
+        {
+            if (stats.size_histogram[i] == 0)
+            {
+                continue;
+            }
+            auto search = m_size_class_gauges.find(i);
+            if (search == m_size_class_gauges.end())
+            {
+                auto gauge = m_registry->make_gauge(
+                    "srf_memory_size_class_allocations",
+                    {{"resource", this->tag()}, {"size_class", std::to_string(std::uint64_t(1) << i)}});
+                search = m_size_class_gauges.emplace(i, gauge).first;
+            }
+            search->second.set(stats.size_histogram[i]);
+        }
+    }
+
+  private:
+    struct gauges  // NOLINT
+    {
+        metrics::Gauge allocations;
+        metrics::Gauge deallocations;
+        metrics::Gauge allocated_bytes;
+        metrics::Gauge live_bytes;
+        metrics::Gauge peak_bytes;
+    };
+
+    struct alignas(64) shard  // NOLINT
+    {
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> deallocations{0};
+        std::atomic<std::uint64_t> allocated_bytes{0};
+        std::atomic<std::uint64_t> deallocated_bytes{0};
+        std::array<std::atomic<std::uint64_t>, allocation_statistics::histogram_bins> size_histogram{};
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) final
+    {
+        auto* ptr = this->resource()->allocate(bytes, alignment);
+
+        auto& s = local_shard();
+        s.allocations.fetch_add(1, std::memory_order_relaxed);
+        s.allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        s.size_histogram[log2_bin(bytes)].fetch_add(1, std::memory_order_relaxed);
+
+        auto live = m_live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        auto peak = m_peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !m_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+        if (is_sampled(ptr))
+        {
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            m_sampled[ptr] = std::chrono::steady_clock::now();
+        }
+
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) final
+    {
+        if (is_sampled(ptr))
+        {
+            auto now = std::chrono::steady_clock::now();
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            auto search = m_sampled.find(ptr);
+            if (search != m_sampled.end())
+            {
+                auto us = std::chrono::duration_cast<std::chrono::microseconds>(now - search->second).count();
+                ++m_lifetime_histogram[log2_bin(static_cast<std::uint64_t>(us))];
+                ++m_sampled_lifetimes;
+                m_sampled.erase(search);
+            }
+        }
+
+        auto& s = local_shard();
+        s.deallocations.fetch_add(1, std::memory_order_relaxed);
+        s.deallocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        m_live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+
+        this->resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    shard& local_shard()
+    {
+        thread_local const std::size_t index = std::hash<std::thread::id>{}(std::this_thread::get_id()) % shard_count;
+        return m_shards[index];
+    }
+
+    bool is_sampled(void* ptr) const
+    {
+        if (m_lifetime_sample_rate == 0 || ptr == nullptr)
+        {
+            return false;
+        }
+        // fibonacci hashing of the address; the low bits of an address are mostly alignment
+        auto hash = (reinterpret_cast<std::uintptr_t>(ptr) >> 4) * 0x9E3779B97F4A7C15ULL;
+        return ((hash >> 32) % m_lifetime_sample_rate) == 0;
+    }
+
+    static std::size_t log2_bin(std::uint64_t value)
+    {
+        return value == 0 ? 0 : 63 - __builtin_clzll(value);
+    }
+
+    const std::size_t m_lifetime_sample_rate;
+
+    std::array<shard, shard_count> m_shards;
+    std::atomic<std::uint64_t> m_live_bytes{0};
+    std::atomic<std::uint64_t> m_peak_bytes{0};
+
+    // lifetime sampling and metrics export; not on the common allocation path
+    mutable std::mutex m_mutex;
+    std::unordered_map<void*, std::chrono::steady_clock::time_point> m_sampled;
+    std::uint64_t m_sampled_lifetimes{0};
+    allocation_statistics::histogram_type m_lifetime_histogram{};
+    metrics::Registry* m_registry{nullptr};
+    std::unique_ptr<gauges> m_gauges;
+    std::map<std::size_t, metrics::Gauge> m_size_class_gauges;
+};
+
+}  // namespace srf::memory
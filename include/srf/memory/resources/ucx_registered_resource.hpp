@@ -18,7 +18,7 @@
 #pragma once
 
 #include <srf/memory/adaptors.hpp>
-#include <srf/memory/core/block_manager.hpp>
+#include <srf/memory/core/concurrent_block_manager.hpp>
 #include <srf/memory/core/ucx_memory_block.hpp>
 #include "internal/ucx/context.hpp"
 
@@ -26,8 +26,10 @@
 
 #include <glog/logging.h>
 
+#include <cstddef>
 #include <memory>
-#include <mutex>
+#include <optional>
+#include <stdexcept>
 
 namespace srf::memory {
 
@@ -50,66 +52,102 @@ inline ucs_memory_type_t memory_type(const memory_kind_type& type)
     return UCS_MEMORY_TYPE_UNKNOWN;
 }
 
+/**
+ * @brief Lookup of the ucx registration of the memory block containing an address
+ */
 struct ucx_registration_cache
 {
-    virtual ~ucx_registration_cache()                 = default;
-    virtual ucx_memory_block lookup(void* addr) const = 0;
+    virtual ~ucx_registration_cache() = default;
+
+    /**
+     * @brief Registration of the block containing addr, if any
+     */
+    virtual std::optional<ucx_memory_block> find(const void* addr) const = 0;
+
+    /**
+     * @brief Registration of the block containing addr; throws if addr is not owned by a registered block
+     */
+    ucx_memory_block lookup(void* addr) const
+    {
+        auto block = find(addr);
+        if (!block)
+        {
+            throw std::runtime_error("unable to lookup metadata for address");
+        }
+        return *block;
+    }
 };
 
-// template <typename Upstream>
-// class ucx_registered_resource final : public upstream_resource<Upstream>, public ucx_registration_cache
-// {
-//   public:
-//     ucx_registered_resource(Upstream upstream, std::shared_ptr<ucx::Context> context) :
-//       upstream_resource<Upstream>(std::move(upstream), "ucx_registered"),
-//       m_context(std::move(context))
-//     {
-//         CHECK(m_context) << "ucx context cannot be null";
-//     }
-
-//     ucx_memory_block lookup(void* addr) const final
-//     {
-//         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-//         const auto* ptr = m_blocks.find_block(addr);
-//         if (ptr == nullptr)
-//         {
-//             throw std::runtime_error("unable to lookup metadata for address");
-//         }
-//         return *ptr;
-//     }
-
-//   private:
-//     std::shared_ptr<ucx::Context> m_context{nullptr};
-//     block_manager<ucx_memory_block> m_blocks;
-//     mutable std::mutex m_mutex;
-
-//     [[nodiscard]] void* do_allocate(std::size_t bytes, std::size_t alignment) final
-//     {
-//         void* mem = this->resource()->allocate(bytes, alignment);
-
-//         if (mem == nullptr)
-//         {
-//             return nullptr;
-//         }
-
-//         auto [lkey, rkey, rkey_size] = m_context->register_memory_with_rkey(mem, bytes);
-//         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-//         m_blocks.add_block(ucx_memory_block(mem, bytes, lkey, rkey, rkey_size));
-//         return mem;
-//     }
-
-//     void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) final
-//     {
-//         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-//         auto block = m_blocks.find_block(ptr);
-//         if (block == nullptr)
-//         {
-//             LOG(FATAL) << "unable to lookup block";
-//         }
-//         m_context->unregister_memory(block->local_handle(), block->remote_handle());
-//         m_blocks.drop_block(ptr);
-//         this->resource()->deallocate(ptr, bytes, alignment);
-//     }
-// };
+/**
+ * @brief Registers each upstream allocation with ucx exactly once and caches the registration.
+ *
+ * Placed below an arena_resource, each arena superblock is registered once when it is allocated from upstream; all
+ * suballocations from the arena then share the registration of their superblock and can be sent, or exposed for an
+ * rdma get, without registering memory on the fly.
+ *
+ * Allocations are rare compared to lookups; lookups are wait-free with respect to concurrent allocations and
+ * deallocations and are O(log n) in the number of registered blocks.
+ */
+template <typename Upstream>
+class ucx_registered_resource final : public upstream_resource<Upstream>, public ucx_registration_cache
+{
+  public:
+    ucx_registered_resource(Upstream upstream, std::shared_ptr<internal::ucx::Context> context) :
+      upstream_resource<Upstream>(std::move(upstream), "ucx_registered"),
+      m_context(std::move(context))
+    {
+        CHECK(m_context) << "ucx context cannot be null";
+    }
+
+    ~ucx_registered_resource() override
+    {
+        LOG_IF(WARNING, m_blocks.size() != 0)
+            << "ucx_registered_resource destroyed with " << m_blocks.size() << " outstanding registrations";
+        for (auto& block : m_blocks.blocks())
+        {
+            m_context->unregister_memory(block.local_handle(), block.remote_handle());
+        }
+    }
+
+    std::optional<ucx_memory_block> find(const void* addr) const final
+    {
+        return m_blocks.find_block(addr);
+    }
+
+    // number of registered blocks
+    std::size_t size() const
+    {
+        return m_blocks.size();
+    }
+
+  private:
+    [[nodiscard]] void* do_allocate(std::size_t bytes, std::size_t alignment) final
+    {
+        void* mem = this->resource()->allocate(bytes, alignment);
+
+        if (mem == nullptr)
+        {
+            return nullptr;
+        }
+
+        auto [lkey, rkey, rkey_size] = m_context->register_memory_with_rkey(mem, bytes);
+        m_blocks.add_block(ucx_memory_block(mem, bytes, lkey, rkey, rkey_size));
+        return mem;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) final
+    {
+        auto block = m_blocks.drop_block(ptr);
+        if (!block)
+        {
+            LOG(FATAL) << "unable to lookup block";
+        }
+        m_context->unregister_memory(block->local_handle(), block->remote_handle());
+        this->resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    std::shared_ptr<internal::ucx::Context> m_context{nullptr};
+    concurrent_block_manager<ucx_memory_block> m_blocks;
+};
 
 }  // namespace srf::memory
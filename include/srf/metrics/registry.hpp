@@ -18,6 +18,7 @@
 #pragma once
 
 #include <srf/metrics/counter.hpp>
+#include <srf/metrics/gauge.hpp>
 
 #include <functional>
 #include <map>
@@ -46,14 +47,18 @@ class Registry
     Registry();
 
     Counter make_counter(std::string name, std::map<std::string, std::string> labels);
+    Gauge make_gauge(std::string name, std::map<std::string, std::string> labels);
     Counter make_throughput_counter(std::string);
+    Counter make_forced_yield_counter(std::string);
 
     std::vector<CounterReport> collect_throughput_counters() const;
+    std::vector<CounterReport> collect_forced_yield_counters() const;
 
   protected:
   private:
     std::shared_ptr<prometheus::Registry> m_registry;
     prometheus::Family<prometheus::Counter>& m_throughput_counters;
+    prometheus::Family<prometheus::Counter>& m_forced_yield_counters;
 };
 
 }  // namespace srf::metrics
@@ -28,6 +28,7 @@
 #include <srf/node/edge.hpp>
 #include <srf/node/forward.hpp>
 #include <srf/node/sink_channel.hpp>
+#include <srf/runnable/context.hpp>
 #include <srf/utils/type_utils.hpp>
 
 #include <glog/logging.h>
@@ -60,6 +61,9 @@ class RxSinkBase : public SinkChannel<T>, private Watchable
     // this is our channel reader progress engine
     void progress_engine(rxcpp::subscriber<T>& s);
 
+    // reads the next item; when time slicing, the slice is reset only if the read would block
+    channel::Status read(T& data, runnable::Context* context);
+
     // observable
     rxcpp::observable<T> m_observable;
 };
@@ -80,17 +84,47 @@ template <typename T>
 void RxSinkBase<T>::progress_engine(rxcpp::subscriber<T>& s)
 {
     T data;
+
+    // only runnables launched with a time-slice budget pay for the accounting
+    runnable::Context* context = nullptr;
+    if (runnable::Context::has_runtime_context() && runnable::Context::get_runtime_context().time_slice_enabled())
+    {
+        context = &runnable::Context::get_runtime_context();
+    }
+
     this->watcher_prologue(WatchableEvent::channel_read, &data);
-    while (s.is_subscribed() && (SinkChannel<T>::egress().await_read(data) == channel::Status::success))
+    while (s.is_subscribed() && (read(data, context) == channel::Status::success))
     {
         this->watcher_epilogue(WatchableEvent::channel_read, true, &data);
         this->watcher_prologue(WatchableEvent::sink_on_data, &data);
         s.on_next(std::move(data));
+        if (context != nullptr)
+        {
+            context->time_slice_tick();
+        }
         this->watcher_prologue(WatchableEvent::channel_read, &data);
     }
     s.on_completed();
 }
 
+template <typename T>
+channel::Status RxSinkBase<T>::read(T& data, runnable::Context* context)
+{
+    if (context == nullptr)
+    {
+        return SinkChannel<T>::egress().await_read(data);
+    }
+
+    auto status = SinkChannel<T>::egress().try_read(data);
+    if (status == channel::Status::empty)
+    {
+        // the fiber is about to block which yields to other fibers
+        context->time_slice_reset();
+        status = SinkChannel<T>::egress().await_read(data);
+    }
+    return status;
+}
+
 template <typename T>
 void RxSinkBase<T>::sink_add_watcher(std::shared_ptr<WatcherInterface> watcher)
 {
@@ -30,6 +30,7 @@
 #include <srf/node/rx_runnable.hpp>
 #include <srf/node/rx_source_base.hpp>
 #include <srf/node/rx_subscribable.hpp>
+#include <srf/runnable/context.hpp>
 #include <srf/utils/type_utils.hpp>
 
 #include <glog/logging.h>
@@ -90,6 +91,15 @@ template <typename T, typename ContextT>
 void RxSource<T, ContextT>::do_subscribe(rxcpp::composite_subscription& subscription)
 {
     auto observable = this->apply_epilogue_taps(m_observable);
+
+    // sources which emit without blocking are forced to yield when their time-slice budget is exhausted; only
+    // runnables launched with a time-slice budget pay for the accounting
+    if (runnable::Context::has_runtime_context() && runnable::Context::get_runtime_context().time_slice_enabled())
+    {
+        auto& context = runnable::Context::get_runtime_context();
+        observable    = observable.tap([&context](const T& data) { context.time_slice_tick(); });
+    }
+
     observable.subscribe(subscription, RxSourceBase<T>::observer());
 }
 
@@ -0,0 +1,66 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace srf::runnable {
+
+/**
+ * @brief Per-rank exchange slots shared by the Contexts of a Runnable and used to implement collective operations
+ *
+ * Each rank publishes the address of its local operand in its own slot; after a barrier, peers read the operand
+ * directly. Slots are padded to a cache line so ranks publishing concurrently do not false share. The barriers of the
+ * collective algorithms provide the required happens-before ordering.
+ */
+class CollectiveSlots final
+{
+  public:
+    explicit CollectiveSlots(std::size_t size) : m_slots(size) {}
+
+    void publish(std::size_t rank, const void* data)
+    {
+        DCHECK_LT(rank, m_slots.size());
+        m_slots[rank].data = data;
+    }
+
+    const void* peek(std::size_t rank) const
+    {
+        DCHECK_LT(rank, m_slots.size());
+        DCHECK(m_slots[rank].data);
+        return m_slots[rank].data;
+    }
+
+    std::size_t size() const
+    {
+        return m_slots.size();
+    }
+
+  private:
+    struct alignas(64) Slot  // NOLINT
+    {
+        const void* data{nullptr};
+    };
+
+    std::vector<Slot> m_slots;
+};
+
+}  // namespace srf::runnable
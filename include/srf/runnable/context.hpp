@@ -18,11 +18,17 @@
 #pragma once
 
 #include <exception>
+#include <srf/runnable/collective_slots.hpp>
+#include <srf/runnable/launch_options.hpp>
 #include <srf/runnable/types.hpp>
 
 #include <glog/logging.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <functional>
 #include <sstream>
 #include <string>
 
@@ -37,6 +43,16 @@ class Runner;
  * A unique Context is provided by the Launcher for each concurrent instance of Runnable. The Context provides
  * the rank() of the current instances, the number of instances via size() and a barrier() method to collectively
  * synchronize all instances.
+ *
+ * Collective operations (reduce_to_rank0, all_reduce, broadcast_from_rank0 and scan) combine values across all
+ * instances without serializing on the shared mutex. Each rank publishes its operand in a padded per-rank slot and
+ * values are combined along a binary tree in log2(size()) barrier-separated rounds. Every instance must call the same
+ * sequence of collectives. Binary operators are applied as op(lower_rank_value, higher_rank_value) and need only be
+ * associative.
+ *
+ * The Context also tracks the cooperative time-slice budget set by LaunchOptions::time_slice. Progress engines call
+ * time_slice_tick() for each item processed and time_slice_reset() before blocking; when the budget is exhausted a
+ * yield is forced so other fibers sharing the thread are not starved.
  */
 class Context
 {
@@ -55,6 +71,46 @@ class Context
     void barrier();
     void yield();
 
+    /**
+     * @brief Account for one item of work against the time-slice budget; yields if the budget is exhausted
+     * @return true if a yield was forced
+     */
+    bool time_slice_tick();
+
+    /**
+     * @brief Begin a new time slice; call when the runnable is about to block, i.e. implicitly yield
+     */
+    void time_slice_reset();
+
+    bool time_slice_enabled() const;
+
+    // number of yields forced by the time-slice budget
+    std::size_t forced_yields() const;
+
+    /**
+     * @brief Combine value across all instances; the result is returned on rank 0, other ranks receive a partial result
+     */
+    template <typename T, typename BinaryOpT>
+    T reduce_to_rank0(T value, BinaryOpT&& op);
+
+    /**
+     * @brief Combine value across all instances; the result is returned on every rank
+     */
+    template <typename T, typename BinaryOpT>
+    T all_reduce(T value, BinaryOpT&& op);
+
+    /**
+     * @brief Returns the value passed in by rank 0 on every rank
+     */
+    template <typename T>
+    T broadcast_from_rank0(T value);
+
+    /**
+     * @brief Inclusive prefix combination; rank i receives op(value_0, ..., value_i)
+     */
+    template <typename T, typename BinaryOpT>
+    T scan(T value, BinaryOpT&& op);
+
     const std::string& info() const;
 
     template <typename ContextT>
@@ -66,11 +122,13 @@ class Context
     }
 
     static Context& get_runtime_context();
+    static bool has_runtime_context();
 
     void set_exception(std::exception_ptr exception_ptr);
 
   protected:
     void init(const Runner& runner);
+    void init_time_slice(TimeSliceOptions time_slice, std::function<void()> on_forced_yield);
     bool status() const;
     void finish();
     virtual void init_info(std::stringstream& ss);
@@ -82,13 +140,111 @@ class Context
     std::exception_ptr m_exception_ptr{nullptr};
     const Runner* m_runner{nullptr};
 
+    TimeSliceOptions m_time_slice{};
+    std::function<void()> m_on_forced_yield{nullptr};
+    std::size_t m_slice_items{0};
+    std::chrono::steady_clock::time_point m_slice_start;
+    std::atomic<std::size_t> m_forced_yields{0};
+
     virtual void do_lock()                          = 0;
     virtual void do_unlock()                        = 0;
     virtual void do_barrier()                       = 0;
     virtual void do_yield()                         = 0;
     virtual EngineType do_execution_context() const = 0;
+    virtual CollectiveSlots& do_collective_slots()  = 0;
 
     friend class Runner;
 };
 
+template <typename T, typename BinaryOpT>
+T Context::reduce_to_rank0(T value, BinaryOpT&& op)
+{
+    if (m_size == 1)
+    {
+        return value;
+    }
+
+    auto& slots = do_collective_slots();
+    slots.publish(m_rank, &value);
+    do_barrier();
+
+    // binomial tree: in each round, the lower rank of every active pair absorbs the value of its partner
+    for (std::size_t stride = 1; stride < m_size; stride <<= 1)
+    {
+        if (m_rank % (stride << 1) == 0 && m_rank + stride < m_size)
+        {
+            value = op(std::move(value), *static_cast<const T*>(slots.peek(m_rank + stride)));
+        }
+        do_barrier();
+    }
+
+    return value;
+}
+
+template <typename T, typename BinaryOpT>
+T Context::all_reduce(T value, BinaryOpT&& op)
+{
+    return broadcast_from_rank0(reduce_to_rank0(std::move(value), std::forward<BinaryOpT>(op)));
+}
+
+template <typename T>
+T Context::broadcast_from_rank0(T value)
+{
+    if (m_size == 1)
+    {
+        return value;
+    }
+
+    auto& slots = do_collective_slots();
+    if (m_rank == 0)
+    {
+        slots.publish(0, &value);
+    }
+    do_barrier();
+
+    if (m_rank != 0)
+    {
+        value = *static_cast<const T*>(slots.peek(0));
+    }
+
+    // rank 0's value must outlive all reads
+    do_barrier();
+    return value;
+}
+
+template <typename T, typename BinaryOpT>
+T Context::scan(T value, BinaryOpT&& op)
+{
+    if (m_size == 1)
+    {
+        return value;
+    }
+
+    // double buffered so a round's writes never race with its peers' reads
+    std::array<T, 2> buffers{value, std::move(value)};
+    std::size_t current = 0;
+
+    auto& slots = do_collective_slots();
+    slots.publish(m_rank, buffers.data());
+    do_barrier();
+
+    for (std::size_t stride = 1; stride < m_size; stride <<= 1)
+    {
+        const auto next = current ^ 1;
+        if (m_rank >= stride)
+        {
+            const auto* peer = static_cast<const T*>(slots.peek(m_rank - stride));
+            buffers[next]    = op(peer[current], buffers[current]);
+        }
+        else
+        {
+            buffers[next] = buffers[current];
+        }
+        current = next;
+        do_barrier();
+    }
+
+    return std::move(buffers[current]);
+}
+
 }  // namespace srf::runnable
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <srf/forward.hpp>
+#include <srf/runnable/collective_slots.hpp>
 #include <srf/runnable/context.hpp>
 #include <srf/runnable/forward.hpp>
 
@@ -37,7 +38,7 @@ class FiberContextResources
 {
   public:
     FiberContextResources() = delete;
-    FiberContextResources(std::size_t size) : m_barrier(size) {}
+    FiberContextResources(std::size_t size) : m_barrier(size), m_collective_slots(size) {}
     virtual ~FiberContextResources() = default;
 
     void barrier()
@@ -50,9 +51,15 @@ class FiberContextResources
         return m_mutex;
     }
 
+    CollectiveSlots& collective_slots()
+    {
+        return m_collective_slots;
+    }
+
   private:
     boost::fibers::barrier m_barrier;
     boost::fibers::mutex m_mutex;
+    CollectiveSlots m_collective_slots;
 };
 
 /**
@@ -104,6 +111,11 @@ class FiberContext final : public ContextT
         m_fiber_resources->barrier();
     }
 
+    CollectiveSlots& do_collective_slots() final
+    {
+        return m_fiber_resources->collective_slots();
+    }
+
     void do_yield() final
     {
         boost::this_fiber::yield();
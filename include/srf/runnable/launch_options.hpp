@@ -21,11 +21,31 @@
 #include <srf/options/engine_groups.hpp>
 #include <srf/runnable/types.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
 namespace srf::runnable {
 
+/**
+ * @brief Cooperative time-slice budget for a Runnable
+ *
+ * Fibers are never preempted; a progress engine which always has data available will monopolize its thread. When
+ * enabled, the progress engines of Rx nodes force a yield after processing max_items data items or after max_duration
+ * has elapsed without the runnable having blocked. A value of zero disables the respective limit.
+ */
+struct TimeSliceOptions
+{
+    std::size_t max_items{0};
+    std::chrono::microseconds max_duration{0};
+
+    bool enabled() const
+    {
+        return max_items != 0 || max_duration.count() != 0;
+    }
+};
+
 struct LaunchOptions
 {
     LaunchOptions() = default;
@@ -38,6 +58,7 @@ struct LaunchOptions
     std::size_t pe_count{1};
     std::size_t engines_per_pe{1};
     std::string engine_factory_name{default_engine_factory_name()};
+    TimeSliceOptions time_slice{};
 };
 
 struct ServiceLaunchOptions : public LaunchOptions
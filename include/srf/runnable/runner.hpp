@@ -89,6 +89,12 @@ class Runner
      */
     using on_completion_callback_t = std::function<void(bool ok)>;
 
+    /**
+     * @brief Signature for the callback lambda which is executed each time an instance is forced to yield by its
+     * time-slice budget; see LaunchOptions::time_slice
+     */
+    using on_forced_yield_callback_t = std::function<void()>;
+
     /**
      * @brief Callback triggered on State change of individual Runnable context/instance
      *
@@ -104,6 +110,14 @@ class Runner
      */
     void on_completion_callback(on_completion_callback_t callback);
 
+    /**
+     * @brief Callback triggered on the running instance each time it is forced to yield by its time-slice budget.
+     *
+     * Must be set before the Runner is enqueued. This callback is executed inline in the runnable's progress engine and
+     * must be lightweight, e.g. incrementing a metrics counter.
+     */
+    void on_forced_yield_callback(on_forced_yield_callback_t callback);
+
     /**
      * @brief Fiber yielding call which returns when the Runnable is active
      */
@@ -147,6 +161,7 @@ class Runner
         State state() const;
         SharedFuture<void> live_future() const;
         SharedFuture<void> join_future() const;
+        std::size_t forced_yields() const;
 
       private:
         std::size_t m_uid{0};
@@ -187,6 +202,9 @@ class Runner
     // callback lambda executed on completion
     on_completion_callback_t m_completion_callback{nullptr};
 
+    // callback lambda executed when an instance is forced to yield
+    on_forced_yield_callback_t m_forced_yield_callback{nullptr};
+
     std::atomic<bool> m_status{true};
     std::atomic<std::size_t> m_remaining_instances{0};
 
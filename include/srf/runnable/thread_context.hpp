@@ -19,6 +19,7 @@
 
 #include <srf/core/thread_barrier.hpp>
 #include <srf/forward.hpp>
+#include <srf/runnable/collective_slots.hpp>
 #include <srf/runnable/context.hpp>
 #include <srf/runnable/forward.hpp>
 
@@ -38,7 +39,7 @@ class ThreadContextResources
 {
   public:
     ThreadContextResources() = delete;
-    ThreadContextResources(std::size_t size) : m_barrier(size) {}
+    ThreadContextResources(std::size_t size) : m_barrier(size), m_collective_slots(size) {}
     virtual ~ThreadContextResources() = default;
 
     void barrier()
@@ -51,9 +52,15 @@ class ThreadContextResources
         return m_mutex;
     }
 
+    CollectiveSlots& collective_slots()
+    {
+        return m_collective_slots;
+    }
+
   private:
     thread_barrier m_barrier;
     std::mutex m_mutex;
+    CollectiveSlots m_collective_slots;
 };
 
 /**
@@ -105,6 +112,11 @@ class ThreadContext final : public ContextT
         m_resources->barrier();
     }
 
+    CollectiveSlots& do_collective_slots() final
+    {
+        return m_resources->collective_slots();
+    }
+
     void do_yield() final
     {
         std::this_thread::yield();
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <srf/codable/codec_registry.hpp>
 #include <srf/manifold/connectable.hpp>
 #include <srf/manifold/factory.hpp>
 #include <srf/manifold/interface.hpp>
@@ -61,7 +62,9 @@ class EgressPort final : public Object<node::SinkProperties<T>>,
       m_segment_address(address),
       m_port_name(std::move(name)),
       m_sink(std::make_unique<node::RxNode<T>>())
-    {}
+    {
+        codable::register_codec_if_codable<T>();
+    }
 
   private:
     node::SinkProperties<T>* get_object() const final
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <srf/codable/codec_registry.hpp>
 #include <srf/manifold/connectable.hpp>
 #include <srf/manifold/factory.hpp>
 #include <srf/manifold/interface.hpp>
@@ -56,7 +57,9 @@ class IngressPort : public Object<node::SourceProperties<T>>, public IngressPort
       m_segment_address(address),
       m_port_name(std::move(name)),
       m_source(std::make_unique<node::RxNode<T>>())
-    {}
+    {
+        codable::register_codec_if_codable<T>();
+    }
 
   private:
     node::SourceProperties<T>* get_object() const final
@@ -0,0 +1,171 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "internal/codable/compression.hpp"
+
+#include "srf/exceptions/runtime_error.hpp"
+
+#include <glog/logging.h>
+#include <lz4.h>
+#include <zstd.h>
+
+#include <climits>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace srf::internal::codable {
+
+using ::srf::codable::CompressionAlgorithm;
+
+std::size_t max_compressed_bytes(CompressionAlgorithm algorithm, std::size_t bytes)
+{
+    switch (algorithm)
+    {
+    case CompressionAlgorithm::lz4:
+        CHECK_LE(bytes, LZ4_MAX_INPUT_SIZE);
+        return LZ4_compressBound(static_cast<int>(bytes));
+    case CompressionAlgorithm::zstd:
+        return ZSTD_compressBound(bytes);
+    default:
+        LOG(FATAL) << "unhandled CompressionAlgorithm";
+    };
+
+    return 0;
+}
+
+std::size_t compress(
+    CompressionAlgorithm algorithm, int level, const void* src, std::size_t bytes, std::vector<char>& scratch)
+{
+    // lz4 block sizes are limited to int; larger blocks are sent uncompressed
+    if (algorithm == CompressionAlgorithm::lz4 && bytes > LZ4_MAX_INPUT_SIZE)
+    {
+        return 0;
+    }
+
+    auto bound = max_compressed_bytes(algorithm, bytes);
+    if (scratch.size() < bound)
+    {
+        scratch.resize(bound);
+    }
+
+    std::size_t compressed = 0;
+    switch (algorithm)
+    {
+    case CompressionAlgorithm::lz4: {
+        auto rc = LZ4_compress_fast(static_cast<const char*>(src),
+                                    scratch.data(),
+                                    static_cast<int>(bytes),
+                                    static_cast<int>(bound),
+                                    (level > 0 ? level : 1));
+        compressed = (rc > 0 ? static_cast<std::size_t>(rc) : 0);
+        break;
+    }
+    case CompressionAlgorithm::zstd: {
+        auto rc    = ZSTD_compress(scratch.data(), bound, src, bytes, (level != 0 ? level : ZSTD_CLEVEL_DEFAULT));
+        compressed = (ZSTD_isError(rc) != 0U ? 0 : rc);
+        break;
+    }
+    default:
+        LOG(FATAL) << "unhandled CompressionAlgorithm";
+    };
+
+    return (compressed < bytes ? compressed : 0);
+}
+
+void validate_decompressed_bytes(CompressionAlgorithm algorithm,
+                                 const void* src,
+                                 std::size_t src_bytes,
+                                 std::size_t dst_bytes)
+{
+    // each byte of an lz4 block expands to at most 255 bytes of output
+    constexpr std::size_t lz4_max_ratio = 255;  // NOLINT
+
+    if (dst_bytes > max_decompressed_bytes)
+    {
+        throw exceptions::SrfRuntimeError("compressed block claims " + std::to_string(dst_bytes) +
+                                          " uncompressed bytes; the maximum is " +
+                                          std::to_string(max_decompressed_bytes));
+    }
+
+    switch (algorithm)
+    {
+    case CompressionAlgorithm::lz4:
+        if (dst_bytes > src_bytes * lz4_max_ratio)
+        {
+            throw exceptions::SrfRuntimeError("lz4 block of " + std::to_string(src_bytes) +
+                                              " bytes cannot decompress to " + std::to_string(dst_bytes) + " bytes");
+        }
+        return;
+    case CompressionAlgorithm::zstd: {
+        auto content_bytes = ZSTD_getFrameContentSize(src, src_bytes);
+        if (content_bytes == ZSTD_CONTENTSIZE_ERROR)
+        {
+            throw exceptions::SrfRuntimeError("invalid zstd frame header");
+        }
+        if (content_bytes != ZSTD_CONTENTSIZE_UNKNOWN && content_bytes != dst_bytes)
+        {
+            throw exceptions::SrfRuntimeError("zstd frame content size of " + std::to_string(content_bytes) +
+                                              " bytes does not match the " + std::to_string(dst_bytes) +
+                                              " uncompressed bytes of its descriptor");
+        }
+        return;
+    }
+    default:
+        throw exceptions::SrfRuntimeError("unhandled CompressionAlgorithm");
+    };
+}
+
+void decompress(
+    CompressionAlgorithm algorithm, const void* src, std::size_t src_bytes, void* dst, std::size_t dst_bytes)
+{
+    switch (algorithm)
+    {
+    case CompressionAlgorithm::lz4: {
+        if (src_bytes > INT_MAX || dst_bytes > INT_MAX)
+        {
+            throw exceptions::SrfRuntimeError("lz4 block exceeds the maximum block size");
+        }
+        auto rc = LZ4_decompress_safe(static_cast<const char*>(src),
+                                      static_cast<char*>(dst),
+                                      static_cast<int>(src_bytes),
+                                      static_cast<int>(dst_bytes));
+        if (rc < 0 || static_cast<std::size_t>(rc) != dst_bytes)
+        {
+            throw exceptions::SrfRuntimeError("failed to decompress lz4 block");
+        }
+        return;
+    }
+    case CompressionAlgorithm::zstd: {
+        auto rc = ZSTD_decompress(dst, dst_bytes, src, src_bytes);
+        if (ZSTD_isError(rc) != 0U)
+        {
+            throw exceptions::SrfRuntimeError(std::string("failed to decompress zstd block: ") + ZSTD_getErrorName(rc));
+        }
+        if (rc != dst_bytes)
+        {
+            throw exceptions::SrfRuntimeError("zstd block did not decompress to the expected size");
+        }
+        return;
+    }
+    default:
+        throw exceptions::SrfRuntimeError("unhandled CompressionAlgorithm");
+    };
+}
+
+}  // namespace srf::internal::codable
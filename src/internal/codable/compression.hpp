@@ -0,0 +1,72 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "srf/codable/encoding_options.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace srf::internal::codable {
+
+/**
+ * @brief Upper bound on the compressed size of bytes of input
+ */
+std::size_t max_compressed_bytes(::srf::codable::CompressionAlgorithm algorithm, std::size_t bytes);
+
+/**
+ * @brief Compress bytes of src into scratch, which is grown as needed
+ *
+ * @return number of compressed bytes written to scratch; 0 if compression failed or did not reduce the size
+ */
+std::size_t compress(::srf::codable::CompressionAlgorithm algorithm,
+                     int level,
+                     const void* src,
+                     std::size_t bytes,
+                     std::vector<char>& scratch);
+
+// largest block decompress will produce; a descriptor claiming more is rejected before anything is allocated
+constexpr std::size_t max_decompressed_bytes = std::size_t(1) << 31;  // NOLINT
+
+/**
+ * @brief Validate dst_bytes, the uncompressed size claimed by a block's descriptor, against the compressed data in src
+ *
+ * Must be called before the destination of dst_bytes is allocated. dst_bytes must not exceed max_decompressed_bytes.
+ * For zstd it must match the content size recorded in the frame header; for lz4, whose blocks carry no size, it must
+ * be reachable from src_bytes at lz4's maximum compression ratio.
+ *
+ * @throws exceptions::SrfRuntimeError if dst_bytes is not a plausible size for src
+ */
+void validate_decompressed_bytes(::srf::codable::CompressionAlgorithm algorithm,
+                                 const void* src,
+                                 std::size_t src_bytes,
+                                 std::size_t dst_bytes);
+
+/**
+ * @brief Decompress src into exactly dst_bytes of dst
+ *
+ * @throws exceptions::SrfRuntimeError if the data is corrupt or does not decompress to dst_bytes
+ */
+void decompress(::srf::codable::CompressionAlgorithm algorithm,
+                const void* src,
+                std::size_t src_bytes,
+                void* dst,
+                std::size_t dst_bytes);
+
+}  // namespace srf::internal::codable
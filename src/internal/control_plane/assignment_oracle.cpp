@@ -0,0 +1,415 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "internal/control_plane/assignment_oracle.hpp"
+
+#include <google/protobuf/util/message_differencer.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <ostream>
+#include <utility>
+
+namespace srf::internal::control_plane {
+
+std::set<MachineID> AssignmentDelta::participants() const
+{
+    std::set<MachineID> machine_ids;
+    for (const auto& [machine_id, update] : updates)
+    {
+        machine_ids.insert(machine_id);
+    }
+    return machine_ids;
+}
+
+AssignmentDelta compute_assignment_delta(const SegmentAssignments& previous, const SegmentAssignments& current)
+{
+    AssignmentDelta delta;
+
+    // segments which were added, changed or removed
+    std::set<SegmentAddress> modified;
+
+    // per machine record of the segment addresses already included in its update
+    std::map<MachineID, std::set<SegmentAddress>> assigned;
+    std::map<MachineID, std::set<SegmentAddress>> removed;
+
+    auto add_assignment = [&](MachineID machine_id, const protos::SegmentAssignment& assignment) {
+        if (assigned[machine_id].insert(assignment.address()).second)
+        {
+            *delta.updates[machine_id].add_assignments() = assignment;
+        }
+    };
+
+    auto add_removal = [&](MachineID machine_id, SegmentAddress address) {
+        if (removed[machine_id].insert(address).second)
+        {
+            delta.updates[machine_id].add_removed_segment_addresses(address);
+        }
+    };
+
+    for (const auto& [address, assignment] : current)
+    {
+        auto search = previous.find(address);
+        if (search != previous.end() &&
+            google::protobuf::util::MessageDifferencer::Equals(search->second, assignment))
+        {
+            continue;
+        }
+
+        modified.insert(address);
+        add_assignment(assignment.machine_id(), assignment);
+
+        // the segment moved; its previous owner must tear it down
+        if (search != previous.end() && search->second.machine_id() != assignment.machine_id())
+        {
+            add_removal(search->second.machine_id(), address);
+        }
+    }
+
+    for (const auto& [address, assignment] : previous)
+    {
+        if (current.find(address) == current.end())
+        {
+            modified.insert(address);
+            add_removal(assignment.machine_id(), address);
+        }
+    }
+
+    if (modified.empty())
+    {
+        return delta;
+    }
+
+    // owners of segments which egress to a modified segment must learn of its new location or its removal; the owner
+    // of a modified segment must learn the location of every one of its egress targets, modified or not
+    for (const auto& [address, assignment] : current)
+    {
+        const bool source_modified = (modified.count(address) != 0);
+        for (const auto& [port, policy] : assignment.egress_polices())
+        {
+            for (const auto& target : policy.segment_addresses())
+            {
+                const bool target_modified = (modified.count(target) != 0);
+                if (!source_modified && !target_modified)
+                {
+                    continue;
+                }
+
+                auto search = current.find(target);
+                if (search != current.end())
+                {
+                    add_assignment(assignment.machine_id(), search->second);
+                }
+                else if (target_modified)
+                {
+                    add_removal(assignment.machine_id(), target);
+                }
+            }
+        }
+    }
+
+    return delta;
+}
+
+BatchingWindow::BatchingWindow(std::chrono::milliseconds min_window, std::chrono::milliseconds max_window) :
+  m_min_window(min_window),
+  m_max_window(max_window),
+  m_window(min_window)
+{
+    CHECK_GT(m_min_window.count(), 0);
+    CHECK_LE(m_min_window.count(), m_max_window.count());
+}
+
+std::chrono::milliseconds BatchingWindow::window() const
+{
+    return m_window;
+}
+
+void BatchingWindow::on_idle(std::chrono::steady_clock::duration idle)
+{
+    if (idle >= m_max_window)
+    {
+        m_window = m_min_window;
+    }
+}
+
+void BatchingWindow::on_batch(std::size_t event_count)
+{
+    if (event_count > 1)
+    {
+        m_window = std::min(m_window * 2, m_max_window);
+    }
+    else
+    {
+        m_window = std::max(m_window / 2, m_min_window);
+    }
+}
+
+AssignmentOracle::AssignmentOracle(evaluate_fn evaluate, issue_fn issue, BatchingWindow window) :
+  m_evaluate(std::move(evaluate)),
+  m_issue(std::move(issue)),
+  m_window(window)
+{
+    CHECK(m_evaluate);
+    CHECK(m_issue);
+    m_thread = std::thread([this] { oracle(); });
+}
+
+AssignmentOracle::~AssignmentOracle()
+{
+    shutdown();
+}
+
+void AssignmentOracle::enqueue(std::function<void()> event)
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    CHECK(m_running);
+    m_event_queue.push(std::move(event));
+    m_cv.notify_all();
+}
+
+void AssignmentOracle::on_update_start(MachineID machine_id, release_fn release)
+{
+    std::map<MachineID, release_fn> releases;
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (!accept_arrival(machine_id, false))
+        {
+            return;
+        }
+        m_update_state->start_arrivals.emplace(machine_id, std::move(release));
+        releases = advance();
+    }
+    for (auto& [id, fn] : releases)
+    {
+        fn();
+    }
+}
+
+bool AssignmentOracle::on_update_complete(MachineID machine_id, release_fn release)
+{
+    std::map<MachineID, release_fn> releases;
+    bool completed = false;
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (!accept_arrival(machine_id, true))
+        {
+            return false;
+        }
+        m_update_state->complete_arrivals.emplace(machine_id, std::move(release));
+        releases  = advance();
+        completed = (m_update_state == nullptr);
+    }
+    for (auto& [id, fn] : releases)
+    {
+        fn();
+    }
+    return completed;
+}
+
+void AssignmentOracle::remove_machine(MachineID machine_id)
+{
+    std::map<MachineID, release_fn> releases;
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (m_update_state == nullptr || m_update_state->participants.erase(machine_id) == 0)
+        {
+            return;
+        }
+        VLOG(1) << "machine " << machine_id << " removed from the in-flight update";
+        m_update_state->start_arrivals.erase(machine_id);
+        m_update_state->complete_arrivals.erase(machine_id);
+        releases = advance();
+    }
+    for (auto& [id, fn] : releases)
+    {
+        fn();
+    }
+}
+
+bool AssignmentOracle::accept_arrival(MachineID machine_id, bool complete) const
+{
+    // the lock is owned when entering this method
+    const auto* phase = (complete ? "complete" : "start");
+
+    if (m_update_state == nullptr)
+    {
+        LOG(WARNING) << "ignoring update " << phase << " from machine " << machine_id << "; no update is in flight";
+        return false;
+    }
+    if (m_update_state->participants.count(machine_id) == 0)
+    {
+        LOG(WARNING) << "ignoring update " << phase << " from machine " << machine_id
+                     << "; it is not a participant of the current update";
+        return false;
+    }
+    if (m_update_state->started != complete)
+    {
+        LOG(WARNING) << "ignoring update " << phase << " from machine " << machine_id
+                     << "; the current update is in the " << (m_update_state->started ? "complete" : "start")
+                     << " phase";
+        return false;
+    }
+
+    const auto& arrivals = (complete ? m_update_state->complete_arrivals : m_update_state->start_arrivals);
+    if (arrivals.count(machine_id) != 0)
+    {
+        LOG(WARNING) << "ignoring duplicate update " << phase << " from machine " << machine_id;
+        return false;
+    }
+    return true;
+}
+
+std::map<MachineID, AssignmentOracle::release_fn> AssignmentOracle::advance()
+{
+    // the lock is owned when entering this method
+    std::map<MachineID, release_fn> releases;
+    auto& state = *m_update_state;
+
+    if (!state.started && state.start_arrivals.size() == state.participants.size())
+    {
+        state.started = true;
+        std::swap(releases, state.start_arrivals);
+    }
+
+    if (state.started && state.complete_arrivals.size() == state.participants.size())
+    {
+        // as soon as the releases are issued, the participating machines are running again
+        releases.merge(state.complete_arrivals);
+        m_update_state.reset();
+        m_cv.notify_all();
+    }
+
+    return releases;
+}
+
+void AssignmentOracle::shutdown()
+{
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (!m_running)
+        {
+            return;
+        }
+        DVLOG(10) << "triggering oracle to shutdown";
+        m_running = false;
+        m_cv.notify_all();
+    }
+    m_thread.join();
+    DVLOG(10) << "oracle completed";
+}
+
+std::size_t AssignmentOracle::updates_issued() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    return m_updates_issued;
+}
+
+std::chrono::milliseconds AssignmentOracle::batching_window() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    return m_window.window();
+}
+
+void AssignmentOracle::oracle()
+{
+    std::unique_lock<decltype(m_mutex)> lock(m_mutex);
+    auto idle_since = std::chrono::steady_clock::now();
+
+    while (m_running)
+    {
+        m_cv.wait(lock, [this] { return !m_running || !m_event_queue.empty(); });
+        if (!m_running)
+        {
+            break;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        m_window.on_idle(now - idle_since);
+        auto deadline = now + m_window.window();
+
+        DVLOG(10) << "oracle batching window of " << m_window.window().count() << "ms starting - processing events";
+
+        std::size_t event_count = 0;
+        while (m_running && std::chrono::steady_clock::now() < deadline)
+        {
+            while (!m_event_queue.empty())
+            {
+                auto event = std::move(m_event_queue.front());
+                m_event_queue.pop();
+                lock.unlock();
+                event();
+                lock.lock();
+                ++event_count;
+            }
+
+            // yield the lock to let more events get queued
+            m_cv.wait_until(lock, deadline, [this] { return !m_running || !m_event_queue.empty(); });
+        }
+
+        m_window.on_batch(event_count);
+        if (!m_running)
+        {
+            break;
+        }
+
+        DVLOG(10) << "oracle batching window complete - evaluating " << event_count << " events";
+
+        lock.unlock();
+        auto current = m_evaluate();
+        lock.lock();
+
+        if (current)
+        {
+            auto delta     = compute_assignment_delta(m_assignments, *current);
+            m_assignments  = std::move(*current);
+            auto n_updates = delta.updates.size();
+
+            if (n_updates != 0)
+            {
+                // the barrier must exist before the first update is issued
+                CHECK(m_update_state == nullptr);
+                m_update_state               = std::make_unique<UpdateState>();
+                m_update_state->participants = delta.participants();
+                ++m_updates_issued;
+
+                lock.unlock();
+                for (auto& [machine_id, update] : delta.updates)
+                {
+                    DVLOG(10) << "issuing update event for machine " << machine_id;
+                    if (!m_issue(machine_id, std::move(update)))
+                    {
+                        remove_machine(machine_id);
+                    }
+                }
+                lock.lock();
+
+                VLOG(1) << "update events have been issued for " << n_updates << " machines - awaiting responses";
+
+                // do not start the next batch until the participants have completed the current update
+                m_cv.wait(lock, [this] { return !m_running || m_update_state == nullptr; });
+            }
+        }
+
+        idle_since = std::chrono::steady_clock::now();
+    }
+
+    LOG_IF(WARNING, !m_event_queue.empty()) << "oracle shutdown with " << m_event_queue.size() << " unprocessed events";
+}
+
+}  // namespace srf::internal::control_plane
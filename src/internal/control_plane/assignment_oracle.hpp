@@ -0,0 +1,186 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <srf/protos/architect.pb.h>
+#include <srf/types.hpp>  // for MachineID, SegmentAddress
+#include <srf/utils/macros.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <set>
+#include <thread>
+
+namespace srf::internal::control_plane {
+
+using SegmentAssignments = std::map<SegmentAddress, protos::SegmentAssignment>;  // NOLINT
+
+/**
+ * @brief Per-machine incremental updates between two evaluations of the global assignment state
+ */
+struct AssignmentDelta
+{
+    std::map<MachineID, protos::UpdateAssignments> updates;
+
+    // machines which must take part in the update barrier
+    std::set<MachineID> participants() const;
+};
+
+/**
+ * @brief Compute the incremental updates required to move from previous to current
+ *
+ * A machine receives an update if it owns, or previously owned, a segment which was added, changed or removed, or if
+ * it owns a segment with an egress policy targeting such a segment. The update for the owner of an added or changed
+ * segment also carries the assignments of all of that segment's egress targets. Machines which are not affected
+ * receive nothing.
+ */
+AssignmentDelta compute_assignment_delta(const SegmentAssignments& previous, const SegmentAssignments& current);
+
+/**
+ * @brief Adaptive batching window for the oracle
+ *
+ * The window is halved after each batch holding at most a single event and doubled after each batch with several
+ * events, i.e. under churn, bounded by [min_window, max_window]. After being idle for max_window or longer the window
+ * is reset to min_window, so an isolated event is applied with minimal latency.
+ */
+class BatchingWindow final
+{
+  public:
+    static constexpr std::chrono::milliseconds default_min_window{10};    // NOLINT
+    static constexpr std::chrono::milliseconds default_max_window{2000};  // NOLINT
+
+    BatchingWindow(std::chrono::milliseconds min_window = default_min_window,
+                   std::chrono::milliseconds max_window = default_max_window);
+
+    std::chrono::milliseconds window() const;
+
+    // no events were queued for the given duration before the next batch opened
+    void on_idle(std::chrono::steady_clock::duration idle);
+
+    // a batch closed after processing event_count events
+    void on_batch(std::size_t event_count);
+
+  private:
+    std::chrono::milliseconds m_min_window;
+    std::chrono::milliseconds m_max_window;
+    std::chrono::milliseconds m_window;
+};
+
+/**
+ * @brief Transport independent oracle of the control plane
+ *
+ * Events are executed on the oracle thread and batched over an adaptive BatchingWindow. When a batch closes, the global
+ * state is evaluated and only the incremental delta is issued to the affected machines. The affected machines, and
+ * only those, take part in the two-phase ClientUpdateStart / ClientUpdateComplete barrier; machines which are not
+ * affected by an update continue to run undisturbed. The next batch is not evaluated until the update is complete.
+ *
+ * evaluate returns std::nullopt until the global state can be assigned, e.g. until all pipelines are registered.
+ * issue returns false if the machine is no longer reachable, in which case it does not take part in the barrier.
+ * The callbacks are never invoked with the oracle's lock held.
+ */
+class AssignmentOracle final
+{
+  public:
+    using evaluate_fn = std::function<std::optional<SegmentAssignments>()>;          // NOLINT
+    using issue_fn    = std::function<bool(MachineID, protos::UpdateAssignments&&)>;  // NOLINT
+    using release_fn  = std::function<void()>;                                        // NOLINT
+
+    AssignmentOracle(evaluate_fn evaluate, issue_fn issue, BatchingWindow window = BatchingWindow());
+    ~AssignmentOracle();
+
+    DELETE_COPYABILITY(AssignmentOracle);
+    DELETE_MOVEABILITY(AssignmentOracle);
+
+    /**
+     * @brief Queue an event to be executed on the oracle thread within the current or next batching window
+     */
+    void enqueue(std::function<void()> event);
+
+    /**
+     * @brief Barrier arrivals of a participating machine; release is invoked for every participant, possibly on the
+     * calling thread, once all participants have arrived
+     *
+     * An arrival which does not belong to the in-flight update, e.g. a late or duplicate arrival from a machine which
+     * was dropped by remove_machine, is logged and ignored; its release is never invoked.
+     */
+    void on_update_start(MachineID machine_id, release_fn release);
+
+    /**
+     * @copydoc on_update_start
+     * @return true if this arrival completed the update; false if it did not or was ignored
+     */
+    bool on_update_complete(MachineID machine_id, release_fn release);
+
+    /**
+     * @brief Drop a disconnected machine from any in-flight update barrier
+     */
+    void remove_machine(MachineID machine_id);
+
+    /**
+     * @brief Stop the oracle thread; queued events which have not been executed are dropped
+     */
+    void shutdown();
+
+    // number of updates which have been issued
+    std::size_t updates_issued() const;
+
+    std::chrono::milliseconds batching_window() const;
+
+  private:
+    struct UpdateState
+    {
+        std::set<MachineID> participants;
+        std::map<MachineID, release_fn> start_arrivals;
+        std::map<MachineID, release_fn> complete_arrivals;
+        bool started{false};
+    };
+
+    void oracle();
+
+    // true if the arrival belongs to the current phase of the in-flight update; logs and returns false otherwise
+    bool accept_arrival(MachineID machine_id, bool complete) const;
+
+    // advance the in-flight update if all participants have arrived; returns the releases to invoke without the lock
+    std::map<MachineID, release_fn> advance();
+
+    evaluate_fn m_evaluate;
+    issue_fn m_issue;
+    BatchingWindow m_window;
+
+    // only accessed by the oracle thread
+    SegmentAssignments m_assignments;
+
+    std::queue<std::function<void()>> m_event_queue;
+    std::unique_ptr<UpdateState> m_update_state{nullptr};
+    std::size_t m_updates_issued{0};
+    bool m_running{true};
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_thread;
+};
+
+}  // namespace srf::internal::control_plane
@@ -21,13 +21,11 @@
 // #include <srf/types.hpp>                   // for MachineID, InstanceID
 
 // #include <nvrpc/life_cycle_streaming.h>  // StreamingContext is an alias for BaseContext<LifeCycleStreaming>
-// #include <nvrpc/thread_pool.h>
 
 // #include <google/protobuf/any.pb.h>
 
 // #include <algorithm>
-// #include <chrono>
-// #include <condition_variable>
+// #include <optional>
 // #include <ostream>      // needed for logging
 // #include <type_traits>  // for usage of remove_reference which appears to be used implicitly by issue_response
 // #include <vector>
@@ -46,15 +44,7 @@
 
 // void ServerResources::shutdown()
 // {
-//     DVLOG(10) << "triggering oracle to shutdown";
-//     {
-//         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-//         CHECK(m_oracle_running);
-//         m_oracle_running = false;
-//     }
-//     m_oracle_cv.notify_all();
-//     m_oracle_future.get();
-//     DVLOG(10) << "oracle completed";
+//     m_oracle->shutdown();
 // }
 
 // ServerResources::ServerStream& ServerResources::stream(const MachineID& id)
@@ -78,132 +68,49 @@
 
 // void ServerResources::on_client_update_start(protos::Event&& event)
 // {
-//     std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-//     CHECK(m_update_state);
-//     CHECK(m_update_state->update_started == false);
-
-//     m_update_state->start_events.push_back(event);
-
-//     if (m_update_state->start_events.size() == m_streams_by_id.size())
-//     {
-//         m_update_state->update_started = true;
-
-//         // issue unblocking update to all machines
-//         for (const auto& req : m_update_state->start_events)
-//         {
-//             issue_response(req);
-//         }
-
-//         m_update_state->start_events.clear();
-//     }
+//     // only machines affected by the current update take part in the barrier
+//     auto machine_id = event.machine_id();
+//     m_oracle->on_update_start(machine_id, [this, req = std::move(event)] {
+//         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+//         issue_response(req);
+//     });
 // }
 
 // void ServerResources::on_client_update_complete(protos::Event&& event)
 // {
-//     std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-//     CHECK(m_update_state);
-//     CHECK(m_update_state->update_started);
-//     CHECK(m_update_state->update_completed == false);
-
-//     m_update_state->completed_events.push_back(event);
+//     // as soon as the responses are issued, the participating machines are running again
+//     auto machine_id = event.machine_id();
+//     auto completed  = m_oracle->on_update_complete(machine_id, [this, req = std::move(event)] {
+//         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+//         issue_response(req);
+//     });
 
-//     if (m_update_state->completed_events.size() == m_streams_by_id.size())
+//     if (!completed)
 //     {
-//         m_update_state->update_completed = true;
-
-//         // as soon as this is issued, the pipeline are running again
-//         // issue unblocking update to all machines
-//         for (const auto& req : m_update_state->completed_events)
-//         {
-//             issue_response(req);
-//         }
-
-//         // machines marked as stop will be moved from m_stream_by_id to m_streams_marked_to_stop
-//         for (const auto& id : m_machines_marked_to_stop)
-//         {
-//             VLOG(1) << "machine " << id << " marked as stopped; no future updates will issued";
-//             auto stream                  = m_streams_by_id.at(id);
-//             m_streams_marked_to_stop[id] = stream;
-//             m_streams_by_id.erase(id);
-//         }
-//         m_machines_marked_to_stop.clear();
-
-//         m_update_state->completed_events.clear();
-
-//         // when the lock is released, a new updated can be started
-//         m_update_state.reset();
-//         m_oracle_cv.notify_all();
+//         return;
 //     }
-// }
-
-// ServerResources::ServerResources() : m_thread_pool(1), m_oracle_batching_window(std::chrono::seconds(2))
-// {
-//     m_oracle_future = m_thread_pool.enqueue([this] { oracle(); });
-// }
-
-// void ServerResources::oracle()
-// {
-//     std::unique_lock<decltype(m_mutex)> lock(m_mutex);
 
-//     // set_current_thread_name("oracle");
-
-//     bool has_event        = false;
-//     bool pipeline_started = false;
-//     auto deadline         = std::chrono::steady_clock::now() + m_oracle_batching_window;
+//     std::lock_guard<decltype(m_mutex)> lock(m_mutex);
 
-//     while (m_oracle_running)
+//     // machines marked as stop will be moved from m_stream_by_id to m_streams_marked_to_stop
+//     for (const auto& id : m_machines_marked_to_stop)
 //     {
-//         has_event = false;
-//         m_machines_marked_to_stop.clear();
-
-//         m_oracle_cv.wait(lock, [this] { return !m_oracle_running || !m_event_queue.empty(); });
-
-//         if (!m_oracle_running)
-//         {
-//             CHECK_EQ(m_event_queue.size(), 0);
-//             return;
-//         }
-
-//         deadline = std::chrono::steady_clock::now() + m_oracle_batching_window;
-
-//         DVLOG(10) << "oracle batching window starting - processing events";
-
-//         while (std::chrono::steady_clock::now() < deadline)
-//         {
-//             while (!m_event_queue.empty())
-//             {
-//                 has_event = true;
-//                 process_event(m_event_queue.front());
-//                 m_event_queue.pop();
-//             }
-
-//             // yield the lock to let more events get queued
-//             m_oracle_cv.wait_until(lock, deadline, [this] { return m_event_queue.size(); });
-//         }
-
-//         DVLOG(10) << "oracle batching window complete - issuing update";
-
-//         if (has_event && m_oracle_running)
-//         {
-//             if (pipeline_started || m_assignment_manager.can_start())
-//             {
-//                 // the first time this executed means the pipeline will start executing after
-//                 // the update is complete
-//                 pipeline_started = true;
-
-//                 // this evaluates the global state and issue updates to all registered machines
-//                 CHECK(m_update_state == nullptr);
-//                 evaluate_pipeline_state();
-
-//                 // block the oracle thread from making further progress on the event queue
-//                 // until the architect has completed the the current update
-//                 CHECK(m_update_state != nullptr);
-//                 m_oracle_cv.wait(lock, [this] { return m_update_state == nullptr; });
-//             }
-//         }
+//         VLOG(1) << "machine " << id << " marked as stopped; no future updates will issued";
+//         auto stream                  = m_streams_by_id.at(id);
+//         m_streams_marked_to_stop[id] = stream;
+//         m_streams_by_id.erase(id);
 //     }
+//     m_machines_marked_to_stop.clear();
 // }
 
+// ServerResources::ServerResources(BatchingWindow batching_window) :
+//   m_oracle(std::make_unique<AssignmentOracle>([this] { return evaluate_pipeline_state(); },
+//                                               [this](MachineID machine_id, protos::UpdateAssignments&& update) {
+//                                                   return issue_update(machine_id, std::move(update));
+//                                               },
+//                                               batching_window))
+// {}
+
 // bool ServerResources::process_event(const protos::Event& request)
 // {
 //     // the global state lock is owned when entering this method
@@ -254,15 +161,15 @@
 
 // void ServerResources::enqueue_event(protos::Event&& event)
 // {
-//     std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-//     CHECK(m_oracle_running);
-//     m_event_queue.push(std::move(event));
-//     m_oracle_cv.notify_one();
+//     // events are processed on the oracle thread and batched over its adaptive batching window
+//     m_oracle->enqueue([this, request = std::move(event)] {
+//         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+//         process_event(request);
+//     });
 // }
 
 // void ServerResources::stop(const MachineID& machine_id)
 // {
-//     CHECK(m_update_state == nullptr);
 //     m_assignment_manager.remove_machine(machine_id);
 // }
 
@@ -296,6 +203,9 @@
 
 // void ServerResources::remove_machine(const MachineID& machine_id)
 // {
+//     // a disconnected machine will never respond; drop it from any in-flight update barrier
+//     m_oracle->remove_machine(machine_id);
+
 //     std::lock_guard<decltype(m_mutex)> lock(m_mutex);
 
 //     auto instances = m_machine_id_to_instance_ids.find(machine_id);
@@ -389,31 +299,43 @@
 //     return true;
 // }
 
-// void ServerResources::evaluate_pipeline_state()
+// std::optional<SegmentAssignments> ServerResources::evaluate_pipeline_state()
 // {
-//     // CHECK(m_assignment_manager.can_start());
-//     CHECK(m_update_state == nullptr);
-//     m_update_state = std::make_unique<UpdateState>();
+//     std::lock_guard<decltype(m_mutex)> lock(m_mutex);
 
-//     protos::UpdateAssignments update_message;
-//     auto assignments = m_assignment_manager.evaluate_state();
+//     // the first time the pipeline can start, the pipeline will start executing after the update is complete
+//     if (!m_pipeline_started && !m_assignment_manager.can_start())
+//     {
+//         return std::nullopt;
+//     }
+//     m_pipeline_started = true;
 
-//     for (const auto& [segment_address, assignment] : assignments)
+//     SegmentAssignments assignments;
+//     for (auto& [segment_address, assignment] : m_assignment_manager.evaluate_state())
 //     {
-//         *update_message.add_assignments() = assignment;
+//         assignments[segment_address] = std::move(assignment);
 //     }
+//     return assignments;
+// }
 
-//     for (const auto& [machine_id, stream] : m_streams_by_id)
+// bool ServerResources::issue_update(const MachineID& machine_id, protos::UpdateAssignments&& update)
+// {
+//     std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+
+//     auto search = m_streams_by_id.find(machine_id);
+//     if (search == m_streams_by_id.end())
 //     {
-//         protos::Event event;
-//         event.set_event(protos::EventType::ServerUpdateAssignments);
-//         event.set_machine_id(machine_id);
-//         event.mutable_message()->PackFrom(update_message);
-//         DVLOG(10) << "issuing update event for machine " << machine_id;
-//         stream->WriteResponse(std::move(event));
+//         LOG(WARNING) << "unable to issue update to machine " << machine_id << "; machine is no longer connected";
+//         return false;
 //     }
 
-//     VLOG(1) << "updates events have been issued for all machines - awaiting responses";
+//     protos::Event event;
+//     event.set_event(protos::EventType::ServerUpdateAssignments);
+//     event.set_machine_id(machine_id);
+//     event.mutable_message()->PackFrom(update);
+//     DVLOG(10) << "issuing update event for machine " << machine_id;
+//     search->second->WriteResponse(std::move(event));
+//     return true;
 // }
 
 // bool ServerResources::lookup_workers(const protos::LookupWorkersRequest& request,
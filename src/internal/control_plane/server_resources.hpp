@@ -17,47 +17,33 @@
 
 #pragma once
 
+#include "internal/control_plane/assignment_oracle.hpp"
+
 #include <nvrpc/context.h>
 #include <nvrpc/interfaces.h>            // for Resources
 #include <nvrpc/life_cycle_streaming.h>  // StreamingContext is an alias for BaseContext<LifeCycleStreaming>
-#include <nvrpc/thread_pool.h>
 
 #include <srf/protos/architect.pb.h>
 #include <srf/types.hpp>  // for MachineID, InstanceID
 
 #include <glog/logging.h>
 
-#include <chrono>  // for milliseconds
-#include <condition_variable>
-#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>  // for move
-#include <vector>
 
 namespace srf::internal::control_plane {
 
-struct UpdateState
-{
-    std::vector<protos::Event> start_events;
-    std::vector<protos::Event> completed_events;
-
-    bool update_started{false};
-    bool update_completed{false};
-
-    bool shutdown{false};
-};
-
 struct ServerResources : public nvrpc::Resources
 {
     using ServerStream =  // NOLINT
         typename nvrpc::StreamingContext<protos::Event, protos::Event, ServerResources>::ServerStream;
 
-    ServerResources();
+    ServerResources(BatchingWindow batching_window = BatchingWindow());
 
     void stop(const MachineID& machine_id);
 
@@ -86,16 +72,16 @@ struct ServerResources : public nvrpc::Resources
     void issue_response(const protos::Event& request, protos::Event&& response = protos::Event());
 
   protected:
-    void evaluate_pipeline_state();
+    // evaluates the global state; std::nullopt until the pipeline can be started
+    std::optional<SegmentAssignments> evaluate_pipeline_state();
+
+    // issues an incremental update to a machine; false if the machine is no longer connected
+    bool issue_update(const MachineID&, protos::UpdateAssignments&&);
 
     ServerStream& stream(const MachineID&);
 
     void remove_machine(const MachineID&);
 
-    bool can_start();
-
-    void oracle();
-
     bool process_event(const protos::Event&);
 
   private:
@@ -118,33 +104,23 @@ struct ServerResources : public nvrpc::Resources
     std::map<MachineID, std::shared_ptr<ServerStream>> m_streams_by_id;
     std::map<MachineID, std::shared_ptr<ServerStream>> m_streams_marked_to_stop;
 
-    // update state
-    std::unique_ptr<UpdateState> m_update_state{nullptr};
-
     // machines marked for removal in this batching window
     std::set<MachineID> m_machines_marked_to_stop;
 
-    std::map<MachineID, protos::UpdateAssignments> m_current_assignments;
-
     std::string m_graphviz;
 
     // assignment manager
     // AssignmentManager m_assignment_manager;
 
-    // thread pool for oob evaluator / oracle
-    ::nvrpc::ThreadPool m_thread_pool;
-
-    // queue for pushing events that require the evaluator / oracle
-    std::queue<protos::Event> m_event_queue;
-
-    // future that will be completed when the orcale finishes
-    std::future<void> m_oracle_future;
-    std::condition_variable m_oracle_cv;
-    std::chrono::milliseconds m_oracle_batching_window;
-    bool m_oracle_running{true};
+    // set once the pipeline is first assigned; from then on every batch is evaluated
+    bool m_pipeline_started{false};
 
     // primary lock for global state
     mutable std::mutex m_mutex;
+
+    // batches events and issues incremental updates to the affected machines; declared last so the oracle thread is
+    // stopped before any state it may access is destroyed
+    std::unique_ptr<AssignmentOracle> m_oracle;
 };
 
 template <typename Response>  // NOLINT
@@ -0,0 +1,332 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/data_plane/buffer_pool.hpp"
+
+#include "internal/ucx/context.hpp"
+
+#include <srf/utils/bytes_to_string.hpp>
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+#include <utility>
+
+namespace srf::internal::data_plane {
+
+namespace {
+
+constexpr std::size_t slab_alignment = 4096;  // NOLINT
+
+std::size_t align_up(std::size_t bytes, std::size_t alignment)
+{
+    return (bytes + alignment - 1) & ~(alignment - 1);
+}
+
+bool is_power_of_two(std::size_t value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+std::size_t log2_floor(std::size_t value)
+{
+    DCHECK_GT(value, 0);
+    return (sizeof(std::size_t) * 8 - 1) - __builtin_clzl(value);
+}
+
+std::size_t next_power_of_two(std::size_t value)
+{
+    if (value <= 1)
+    {
+        return 1;
+    }
+    return std::size_t(1) << (log2_floor(value - 1) + 1);
+}
+
+void* aligned_allocate(std::size_t alignment, std::size_t bytes)
+{
+    void* ptr = std::aligned_alloc(alignment, align_up(bytes, alignment));
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+}  // namespace
+
+// PooledBuffer
+
+PooledBuffer::PooledBuffer(std::shared_ptr<BufferPool> pool,
+                             void* slot,
+                             std::size_t bytes,
+                             std::size_t size_class) :
+  m_pool(std::move(pool)),
+  m_slot(slot),
+  m_bytes(bytes),
+  m_size_class(size_class)
+{}
+
+PooledBuffer::~PooledBuffer()
+{
+    release();
+}
+
+PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept :
+  m_pool(std::move(other.m_pool)),
+  m_slot(std::exchange(other.m_slot, nullptr)),
+  m_bytes(std::exchange(other.m_bytes, 0)),
+  m_size_class(std::exchange(other.m_size_class, 0))
+{}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept
+{
+    release();
+    m_pool       = std::move(other.m_pool);
+    m_slot       = std::exchange(other.m_slot, nullptr);
+    m_bytes      = std::exchange(other.m_bytes, 0);
+    m_size_class = std::exchange(other.m_size_class, 0);
+    return *this;
+}
+
+void* PooledBuffer::data()
+{
+    return (m_slot != nullptr ? static_cast<std::byte*>(m_slot) + BufferPool::context_bytes : nullptr);
+}
+
+const void* PooledBuffer::data() const
+{
+    return (m_slot != nullptr ? static_cast<const std::byte*>(m_slot) + BufferPool::context_bytes : nullptr);
+}
+
+std::size_t PooledBuffer::bytes() const
+{
+    return m_bytes;
+}
+
+std::size_t PooledBuffer::capacity() const
+{
+    if (m_slot == nullptr)
+    {
+        return 0;
+    }
+    if (m_size_class == BufferPool::unpooled)
+    {
+        return m_bytes;
+    }
+    return m_pool->size_class_bytes(m_size_class);
+}
+
+void PooledBuffer::resize(std::size_t bytes)
+{
+    CHECK_LE(bytes, capacity());
+    if (m_size_class != BufferPool::unpooled)
+    {
+        m_bytes = bytes;
+    }
+}
+
+void* PooledBuffer::context()
+{
+    return m_slot;
+}
+
+const std::shared_ptr<BufferPool>& PooledBuffer::pool() const
+{
+    return m_pool;
+}
+
+void PooledBuffer::release()
+{
+    if (m_slot != nullptr)
+    {
+        DCHECK(m_pool);
+        m_pool->release(m_slot, m_size_class);
+        m_slot  = nullptr;
+        m_bytes = 0;
+    }
+    m_pool.reset();
+}
+
+PooledBuffer::operator bool() const
+{
+    return m_slot != nullptr;
+}
+
+// BufferPool
+
+std::shared_ptr<BufferPool> BufferPool::create(std::shared_ptr<ucx::Context> context,
+                                                             std::size_t min_bytes,
+                                                             std::size_t max_bytes,
+                                                             std::size_t slab_bytes)
+{
+    return std::shared_ptr<BufferPool>(
+        new BufferPool(std::move(context), min_bytes, max_bytes, slab_bytes));
+}
+
+BufferPool::BufferPool(std::shared_ptr<ucx::Context> context,
+                                     std::size_t min_bytes,
+                                     std::size_t max_bytes,
+                                     std::size_t slab_bytes) :
+  m_context(std::move(context)),
+  m_min_bytes(min_bytes),
+  m_max_bytes(max_bytes),
+  m_slab_bytes(slab_bytes)
+{
+    CHECK(is_power_of_two(m_min_bytes)) << "min_bytes must be a power of two";
+    CHECK(is_power_of_two(m_max_bytes)) << "max_bytes must be a power of two";
+    CHECK_LE(m_min_bytes, m_max_bytes);
+
+    for (std::size_t bytes = m_min_bytes; bytes <= m_max_bytes; bytes <<= 1)
+    {
+        auto size_class        = std::make_unique<SizeClass>();
+        size_class->bytes      = bytes;
+        size_class->slot_bytes = context_bytes + align_up(bytes, context_bytes);
+        m_size_classes.push_back(std::move(size_class));
+    }
+
+    DVLOG(10) << "buffer pool created with " << m_size_classes.size() << " size classes from "
+              << bytes_to_string(m_min_bytes) << " to " << bytes_to_string(m_max_bytes)
+              << "; ucx registration: " << (is_registered() ? "enabled" : "disabled");
+}
+
+BufferPool::~BufferPool()
+{
+    std::lock_guard<decltype(m_slab_mutex)> lock(m_slab_mutex);
+    for (auto& slab : m_slabs)
+    {
+        if (m_context && slab.memh != nullptr)
+        {
+            m_context->unregister_memory(slab.memh);
+        }
+        std::free(slab.data);
+    }
+    m_slabs.clear();
+}
+
+PooledBuffer BufferPool::acquire(std::size_t bytes)
+{
+    auto idx = size_class_for(bytes);
+
+    if (idx == unpooled)
+    {
+        DVLOG(10) << "buffer of " << bytes_to_string(bytes) << " exceeds the largest size class; unpooled";
+        void* slot = aligned_allocate(context_bytes, context_bytes + bytes);
+        return PooledBuffer(shared_from_this(), slot, bytes, unpooled);
+    }
+
+    auto& size_class = *m_size_classes[idx];
+    void* slot       = nullptr;
+    {
+        std::lock_guard<decltype(size_class.mutex)> lock(size_class.mutex);
+        if (size_class.free_slots.empty())
+        {
+            grow(size_class);
+        }
+        slot = size_class.free_slots.back();
+        size_class.free_slots.pop_back();
+    }
+
+    return PooledBuffer(shared_from_this(), slot, bytes, idx);
+}
+
+void BufferPool::release(void* slot, std::size_t size_class)
+{
+    if (size_class == unpooled)
+    {
+        std::free(slot);
+        return;
+    }
+
+    DCHECK_LT(size_class, m_size_classes.size());
+    auto& sc = *m_size_classes[size_class];
+    std::lock_guard<decltype(sc.mutex)> lock(sc.mutex);
+    sc.free_slots.push_back(slot);
+}
+
+void BufferPool::grow(SizeClass& size_class)
+{
+    auto slots_per_slab = std::max<std::size_t>(1, m_slab_bytes / size_class.slot_bytes);
+    auto bytes          = align_up(slots_per_slab * size_class.slot_bytes, slab_alignment);
+
+    Slab slab{aligned_allocate(slab_alignment, bytes), bytes, nullptr};
+
+    if (m_context)
+    {
+        // register the entire slab once; every buffer carved from it is pre-registered
+        slab.memh = m_context->register_memory(slab.data, slab.bytes);
+    }
+
+    DVLOG(10) << "buffer pool: new slab of " << slots_per_slab << " x "
+              << bytes_to_string(size_class.bytes) << " buffers";
+
+    size_class.free_slots.reserve(size_class.free_slots.size() + slots_per_slab);
+    auto* start = static_cast<std::byte*>(slab.data);
+    for (std::size_t i = slots_per_slab; i > 0; i--)
+    {
+        size_class.free_slots.push_back(start + (i - 1) * size_class.slot_bytes);
+    }
+
+    std::lock_guard<decltype(m_slab_mutex)> lock(m_slab_mutex);
+    m_slabs.push_back(slab);
+}
+
+std::size_t BufferPool::size_class_count() const
+{
+    return m_size_classes.size();
+}
+
+std::size_t BufferPool::size_class_bytes(std::size_t size_class) const
+{
+    DCHECK_LT(size_class, m_size_classes.size());
+    return m_size_classes[size_class]->bytes;
+}
+
+std::size_t BufferPool::size_class_for(std::size_t bytes) const
+{
+    if (bytes > m_max_bytes)
+    {
+        return unpooled;
+    }
+    auto rounded = next_power_of_two(std::max(bytes, m_min_bytes));
+    return log2_floor(rounded) - log2_floor(m_min_bytes);
+}
+
+std::size_t BufferPool::free_count(std::size_t size_class) const
+{
+    DCHECK_LT(size_class, m_size_classes.size());
+    const auto& sc = *m_size_classes[size_class];
+    std::lock_guard<decltype(sc.mutex)> lock(sc.mutex);
+    return sc.free_slots.size();
+}
+
+std::size_t BufferPool::slab_count() const
+{
+    std::lock_guard<decltype(m_slab_mutex)> lock(m_slab_mutex);
+    return m_slabs.size();
+}
+
+bool BufferPool::is_registered() const
+{
+    return static_cast<bool>(m_context);
+}
+
+}  // namespace srf::internal::data_plane
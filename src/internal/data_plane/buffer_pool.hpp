@@ -0,0 +1,228 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/ucx/context.hpp"
+
+#include <srf/memory/blob_storage.hpp>
+#include <srf/memory/memory_kind.hpp>
+#include <srf/utils/macros.hpp>
+
+#include <ucp/api/ucp_def.h>
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace srf::internal::data_plane {
+
+class BufferPool;
+
+/**
+ * @brief Move-only handle to a pooled buffer; the buffer is returned to its pool on destruction.
+ *
+ * Every pooled buffer is prefixed by a small, cache-line aligned context region that the owner of an in-flight
+ * send or receive can use to store its completion state. This allows the ucx completion handler to recover everything it
+ * needs from the user_data pointer without a separate allocation or thread local storage.
+ */
+class PooledBuffer final
+{
+  public:
+    PooledBuffer() = default;
+    ~PooledBuffer();
+
+    PooledBuffer(PooledBuffer&& other) noexcept;
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+
+    DELETE_COPYABILITY(PooledBuffer);
+
+    // start of the payload region
+    void* data();
+    const void* data() const;
+
+    // number of payload bytes requested at acquisition
+    std::size_t bytes() const;
+
+    // number of usable payload bytes, i.e. the size of the size class
+    std::size_t capacity() const;
+
+    // update the number of payload bytes in use; must not exceed capacity; unpooled buffers are never resized
+    void resize(std::size_t bytes);
+
+    // scratch space of BufferPool::context_bytes preceding the payload
+    void* context();
+
+    // the pool from which this buffer was acquired
+    const std::shared_ptr<BufferPool>& pool() const;
+
+    // return the buffer to the pool
+    void release();
+
+    operator bool() const;
+
+  private:
+    PooledBuffer(std::shared_ptr<BufferPool> pool, void* slot, std::size_t bytes, std::size_t size_class);
+
+    std::shared_ptr<BufferPool> m_pool{nullptr};
+    void* m_slot{nullptr};
+    std::size_t m_bytes{0};
+    std::size_t m_size_class{0};
+
+    friend BufferPool;
+};
+
+/**
+ * @brief Size-classed pool of host buffers used by the data plane to stage outbound and inbound tagged messages.
+ *
+ * Size classes are powers of two from min_bytes to max_bytes. Each size class is backed by slabs which are allocated
+ * on demand and never returned to the system until the pool is destroyed. If a ucx::Context is provided, each slab is
+ * registered with ucx once when it is created, so network payloads are staged in pre-registered memory.
+ *
+ * Requests larger than max_bytes fall back to an unpooled allocation which is released on return.
+ *
+ * Buffers may be acquired and released from any thread; each size class is guarded by its own lock.
+ */
+class BufferPool final : public std::enable_shared_from_this<BufferPool>
+{
+  public:
+    static constexpr std::size_t context_bytes      = 64;                                     // NOLINT
+    static constexpr std::size_t default_min_bytes  = 256;                                    // NOLINT
+    static constexpr std::size_t default_max_bytes  = 4UL << 20;                              // NOLINT
+    static constexpr std::size_t default_slab_bytes = 4UL << 20;                              // NOLINT
+    static constexpr std::size_t unpooled           = std::numeric_limits<std::size_t>::max();  // NOLINT
+
+    static std::shared_ptr<BufferPool> create(std::shared_ptr<ucx::Context> context = nullptr,
+                                                     std::size_t min_bytes                 = default_min_bytes,
+                                                     std::size_t max_bytes                 = default_max_bytes,
+                                                     std::size_t slab_bytes                = default_slab_bytes);
+
+    ~BufferPool();
+
+    DELETE_COPYABILITY(BufferPool);
+    DELETE_MOVEABILITY(BufferPool);
+
+    /**
+     * @brief Acquire a buffer with a payload capacity of at least bytes
+     */
+    PooledBuffer acquire(std::size_t bytes);
+
+    // number of size classes managed by the pool
+    std::size_t size_class_count() const;
+
+    // payload capacity of a given size class
+    std::size_t size_class_bytes(std::size_t size_class) const;
+
+    // size class used to service an allocation of bytes; returns unpooled if bytes > max_bytes
+    std::size_t size_class_for(std::size_t bytes) const;
+
+    // number of buffers currently sitting on the free list of a size class
+    std::size_t free_count(std::size_t size_class) const;
+
+    // number of slabs allocated across all size classes
+    std::size_t slab_count() const;
+
+    // true if slabs are registered with ucx
+    bool is_registered() const;
+
+  private:
+    BufferPool(std::shared_ptr<ucx::Context> context,
+                      std::size_t min_bytes,
+                      std::size_t max_bytes,
+                      std::size_t slab_bytes);
+
+    struct SizeClass
+    {
+        std::size_t bytes;       // payload capacity
+        std::size_t slot_bytes;  // context_bytes + payload capacity
+        mutable std::mutex mutex;
+        std::vector<void*> free_slots;
+    };
+
+    struct Slab
+    {
+        void* data;
+        std::size_t bytes;
+        ucp_mem_h memh;
+    };
+
+    void release(void* slot, std::size_t size_class);
+
+    // allocate a new slab for size_class and push its slots on the free list; caller holds the size class lock
+    void grow(SizeClass& size_class);
+
+    std::shared_ptr<ucx::Context> m_context;
+    std::size_t m_min_bytes;
+    std::size_t m_max_bytes;
+    std::size_t m_slab_bytes;
+
+    std::vector<std::unique_ptr<SizeClass>> m_size_classes;
+
+    mutable std::mutex m_slab_mutex;
+    std::vector<Slab> m_slabs;
+
+    friend PooledBuffer;
+};
+
+}  // namespace srf::internal::data_plane
+
+namespace srf::memory {
+
+/**
+ * @brief Allows a pooled PooledBuffer to back a memory::blob; the buffer is recycled when the last blob is dropped.
+ */
+template <>
+class BlobStorage<internal::data_plane::PooledBuffer> final : public IBlobStorage
+{
+  public:
+    BlobStorage(internal::data_plane::PooledBuffer&& buffer) : m_buffer(std::move(buffer)) {}
+    ~BlobStorage() final = default;
+
+  private:
+    void* do_data() final
+    {
+        return m_buffer.data();
+    }
+
+    const void* do_data() const final
+    {
+        return m_buffer.data();
+    }
+
+    std::size_t do_bytes() const final
+    {
+        return m_buffer.bytes();
+    }
+
+    memory_kind_type do_kind() const final
+    {
+        return memory_kind_type::host;
+    }
+
+    std::shared_ptr<IBlobStorage> do_allocate(std::size_t bytes, cudaStream_t stream) const final
+    {
+        CHECK(stream == nullptr);
+        return std::make_shared<BlobStorage<internal::data_plane::PooledBuffer>>(
+            m_buffer.pool()->acquire(bytes));
+    }
+
+    internal::data_plane::PooledBuffer m_buffer;
+};
+
+}  // namespace srf::memory
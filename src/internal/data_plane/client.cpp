@@ -17,7 +17,9 @@
 
 #include "internal/data_plane/client.hpp"
 
+#include "internal/data_plane/buffer_pool.hpp"
 #include "internal/data_plane/client_worker.hpp"
+#include "internal/data_plane/frame.hpp"
 #include "internal/data_plane/tags.hpp"
 #include "internal/utils/contains.hpp"
 
@@ -25,9 +27,8 @@
 #include <srf/channel/buffered_channel.hpp>
 #include <srf/channel/channel.hpp>
 #include <srf/channel/status.hpp>
-#include <srf/codable/encode.hpp>
 #include <srf/codable/encoded_object.hpp>
-#include <srf/codable/protobuf_message.hpp>  // IWYU pragma: keep
+#include <srf/core/addresses.hpp>
 
 #include <srf/exceptions/runtime_error.hpp>
 #include <srf/memory/block.hpp>
@@ -47,24 +48,161 @@
 #include <ucp/api/ucp.h>
 #include <ucs/memory/memory_type.h>
 #include <ucs/type/status.h>
+#include <boost/fiber/future/async.hpp>
 #include <boost/fiber/future/future.hpp>
 #include <boost/fiber/future/promise.hpp>
+#include <boost/fiber/operations.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <exception>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
 #include <ostream>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace srf::internal::data_plane {
 
-static void send_completion_handler_with_future(void* request, ucs_status_t status, void* user_data)
+/**
+ * @brief Bounded counter of in-flight sends to a single remote instance.
+ *
+ * acquire yields the calling fiber while the window is full; release is called by the send completion path which may
+ * run on the progress engine.
+ */
+class SendWindow final
+{
+  public:
+    SendWindow(std::size_t capacity) : m_capacity(capacity)
+    {
+        // a send may need to reserve a slot for the frame it flushes in addition to its own
+        CHECK_GE(m_capacity, 2);
+    }
+
+    void acquire(std::size_t slots = 1)
+    {
+        DCHECK_LE(slots, m_capacity);
+        std::unique_lock<Mutex> lock(m_mutex);
+        m_cv.wait(lock, [this, slots] { return m_inflight + slots <= m_capacity; });
+        m_inflight += slots;
+    }
+
+    void release(std::size_t slots = 1)
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        DCHECK_GE(m_inflight, slots);
+        m_inflight -= slots;
+        m_cv.notify_all();
+    }
+
+    void await_empty()
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_inflight == 0; });
+    }
+
+    std::size_t inflight() const
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        return m_inflight;
+    }
+
+  private:
+    const std::size_t m_capacity;
+    std::size_t m_inflight{0};
+    mutable Mutex m_mutex;
+    CondV m_cv;
+};
+
+/**
+ * @brief Slots of a SendWindow acquired before taking an aggregator lock, so that a full window to one instance never
+ * blocks while holding a lock. Each issued send takes one slot; slots which were not taken are released on
+ * destruction.
+ */
+class WindowReservation final
 {
-    auto* promise = static_cast<Promise<void>*>(user_data);
+  public:
+    WindowReservation(SendWindow& window, std::size_t slots) : m_window(window), m_slots(slots)
+    {
+        m_window.acquire(m_slots);
+    }
+
+    ~WindowReservation()
+    {
+        if (m_slots > 0)
+        {
+            m_window.release(m_slots);
+        }
+    }
+
+    WindowReservation(const WindowReservation&)            = delete;
+    WindowReservation& operator=(const WindowReservation&) = delete;
+
+    SendWindow& take()
+    {
+        CHECK_GT(m_slots, 0) << "send issued without a reserved window slot";
+        --m_slots;
+        return m_window;
+    }
 
+  private:
+    SendWindow& m_window;
+    std::size_t m_slots;
+};
+
+/**
+ * @brief Partially filled frame of small async sends to a single remote instance.
+ */
+struct SendAggregator
+{
+    SendAggregator(InstanceID id) : instance_id(id) {}
+
+    const InstanceID instance_id;
+    Mutex mutex;
+    std::optional<FrameWriter> frame;
+    std::chrono::steady_clock::time_point opened;
+};
+
+namespace {
+
+/**
+ * @brief Completion state of an in-flight send.
+ *
+ * Constructed in place in the context region of the pooled send buffer which it owns, so the completion handler can
+ * recover it from the user_data pointer without an additional allocation.
+ */
+struct InFlightSend
+{
+    PooledBuffer buffer;
+    SendWindow* window;
+    Promise<void>* promise;
+};
+
+static_assert(sizeof(InFlightSend) <= BufferPool::context_bytes, "InFlightSend must fit in context");
+
+void complete_send(InFlightSend* in_flight, ucs_status_t status)
+{
+    auto buffer   = std::move(in_flight->buffer);
+    auto* window  = in_flight->window;
+    auto* promise = in_flight->promise;
+    in_flight->~InFlightSend();
+
+    // return the staging buffer before opening a slot in the window
+    buffer.release();
+    window->release();
+
+    if (promise == nullptr)
+    {
+        LOG_IF(ERROR, status != UCS_OK) << "async send failed - " << ucs_status_string(status);
+        return;
+    }
     if (status == UCS_OK)
     {
         promise->set_value();
@@ -73,12 +211,32 @@ static void send_completion_handler_with_future(void* request, ucs_status_t stat
     {
         promise->set_exception(std::make_exception_ptr(std::runtime_error(ucs_status_string(status))));
     }
+}
 
+void send_completion_handler(void* request, ucs_status_t status, void* user_data)
+{
     // the request will be released by the progress engine
-    // we could optimize this a bit more
+    complete_send(static_cast<InFlightSend*>(user_data), status);
 }
 
-Client::Client(std::shared_ptr<ucx::Context> context) : m_worker(std::make_shared<ucx::Worker>(std::move(context))) {}
+}  // namespace
+
+Client::Client(std::shared_ptr<ucx::Context> context,
+               std::shared_ptr<ucx::Worker> worker,
+               std::shared_ptr<RemoteDescriptorManager> remote_descriptors,
+               std::size_t send_window,
+               std::chrono::microseconds linger) :
+  m_worker(std::move(worker)),
+  m_send_window_size(send_window),
+  m_linger(linger),
+  m_send_buffers(BufferPool::create(context)),
+  m_remote_descriptors(std::move(remote_descriptors))
+{
+    CHECK(m_worker);
+    CHECK(m_remote_descriptors);
+    static_assert(sizeof(FrameHeader) + FrameWriter::record_bytes(coalesce_bytes) <= frame_bytes,
+                  "a frame must be able to hold at least one coalesced send");
+}
 
 Client::~Client()
 {
@@ -91,6 +249,13 @@ void Client::do_service_start()
     auto sink             = std::make_unique<DataPlaneClientWorker>(m_worker);
     sink->update_channel(std::make_unique<channel::BufferedChannel<void*>>(256));
     node::make_edge(*m_ucx_request_channel, *sink);
+
+    if (m_linger.count() > 0)
+    {
+        m_linger_running = true;
+        m_linger_flusher = boost::fibers::async(::boost::fibers::launch::post, [this] { linger_flush_loop(); });
+    }
+
     LOG(FATAL) << "get launch control from partition resources";
     // auto launcher     = launch_control.prepare_launcher(std::move(sink));
     // m_progress_engine = launcher->ignition();
@@ -103,33 +268,107 @@ void Client::do_service_await_live()
 
 void Client::do_service_stop()
 {
+    stop_linger_flusher();
+    if (m_linger_flusher.valid())
+    {
+        m_linger_flusher.get();
+    }
+
+    // issue any partially filled frames; the aggregators are copied under the lock as async_send may still be
+    // inserting into the map
+    std::vector<std::pair<InstanceID, std::shared_ptr<SendAggregator>>> aggregators;
+    {
+        std::lock_guard<std::mutex> lock(m_aggregators_mutex);
+        aggregators.assign(m_send_aggregators.begin(), m_send_aggregators.end());
+    }
+    for (auto& [id, aggregator] : aggregators)
+    {
+        WindowReservation reservation(send_window(id), 1);
+        std::lock_guard<Mutex> lock(aggregator->mutex);
+        flush_frame(*aggregator, reservation);
+    }
+
+    // the progress engine must remain live until all in-flight sends have completed
+    std::vector<std::shared_ptr<SendWindow>> windows;
+    {
+        std::lock_guard<decltype(m_instances_mutex)> lock(m_instances_mutex);
+        for (const auto& [id, window] : m_send_windows)
+        {
+            windows.push_back(window);
+        }
+    }
+    for (auto& window : windows)
+    {
+        window->await_empty();
+    }
     m_ucx_request_channel.reset();
 }
 
 void Client::do_service_kill()
 {
+    stop_linger_flusher();
     m_ucx_request_channel.reset();
     m_progress_engine->kill();
 }
 
 void Client::do_service_await_join()
 {
+    if (m_linger_flusher.valid())
+    {
+        m_linger_flusher.get();
+    }
     m_progress_engine->await_join();
 }
 
 void Client::register_instance(InstanceID instance_id, ucx::WorkerAddress worker_address)
 {
+    std::lock_guard<decltype(m_instances_mutex)> lock(m_instances_mutex);
     auto search = m_workers.find(instance_id);
     if (search != m_workers.end())
     {
         LOG(ERROR) << "instance_id: " << instance_id << " was already registered";
         throw std::runtime_error("instance_id already registered");
     }
-    m_workers[instance_id] = std::move(worker_address);
+    m_workers[instance_id]      = std::move(worker_address);
+    m_send_windows[instance_id] = std::make_shared<SendWindow>(m_send_window_size);
+}
+
+void Client::register_segment(SegmentAddress segment_address, InstanceID instance_id)
+{
+    std::unique_lock<std::shared_mutex> lock(m_segments_mutex);
+    auto [it, inserted] = m_segments.emplace(segment_address, instance_id);
+    if (!inserted && it->second != instance_id)
+    {
+        LOG(ERROR) << "segment " << segment_address_string(segment_address) << " is registered to instance_id "
+                   << it->second << "; attempting to register it to instance_id " << instance_id;
+        throw std::runtime_error("segment already registered to another instance");
+    }
+}
+
+void Client::drop_segment(SegmentAddress segment_address)
+{
+    std::unique_lock<std::shared_mutex> lock(m_segments_mutex);
+    m_segments.erase(segment_address);
+}
+
+InstanceID Client::instance_for(const PortAddress& port_address) const
+{
+    auto [id, rank, port] = port_address_decode(port_address);
+    auto segment_address  = segment_address_encode(id, rank);
+
+    std::shared_lock<std::shared_mutex> lock(m_segments_mutex);
+    auto search = m_segments.find(segment_address);
+    if (search == m_segments.end())
+    {
+        LOG(ERROR) << "no instance registered for port address " << port_address_string(port_address);
+        throw std::runtime_error("no instance registered for segment");
+    }
+    return search->second;
 }
 
 const ucx::Endpoint& Client::endpoint(InstanceID id) const
 {
+    std::lock_guard<decltype(m_instances_mutex)> lock(m_instances_mutex);
     auto search_endpoints = m_endpoints.find(id);
     if (search_endpoints == m_endpoints.end())
     {
@@ -158,6 +397,7 @@ void Client::push_request(void* request)
 
 bool Client::is_connected_to(InstanceID instance_id) const
 {
+    std::lock_guard<decltype(m_instances_mutex)> lock(m_instances_mutex);
     return contains(m_workers, instance_id);
 }
 
@@ -191,130 +431,307 @@ void Client::issue_network_event(InstanceID id, ucp_tag_t tag)
     push_request(std::move(request));
 }
 
-struct GetUserData
+SendWindow& Client::send_window(InstanceID id) const
 {
-    Promise<void> promise;
-    ucp_rkey_h rkey;
-};
+    std::lock_guard<decltype(m_instances_mutex)> lock(m_instances_mutex);
+    auto search = m_send_windows.find(id);
+    if (search == m_send_windows.end())
+    {
+        LOG(ERROR) << "no send window was found for instance_id: " << id;
+        throw std::runtime_error("instance_id was not registered");
+    }
+    // windows are never erased, so the reference remains valid after the lock is released
+    return *search->second;
+}
 
-static void rdma_get_callback(void* request, ucs_status_t status, void* user_data)
+SendAggregator& Client::send_aggregator(InstanceID id) const
 {
-    DVLOG(1) << "rdma get callback start for request " << request;
-    auto* data = static_cast<GetUserData*>(user_data);
-    if (status != UCS_OK)
+    std::lock_guard<std::mutex> lock(m_aggregators_mutex);
+    auto& aggregator = m_send_aggregators[id];
+    if (!aggregator)
     {
-        LOG(FATAL) << "rdma get failure occurred";
-        // data->promise.set_exception();
+        aggregator = std::make_shared<SendAggregator>(id);
     }
-    data->promise.set_value();
-    ucp_request_free(request);
-    ucp_rkey_destroy(data->rkey);
+    return *aggregator;
 }
 
-/*
-void Client::get(const protos::RemoteDescriptor& remote_md, Descriptor& buffer)
+void Client::await_send(const InstanceID& instance_id,
+                        const PortAddress& port_address,
+                        const codable::EncodedObject& encoded_object,
+                        std::shared_ptr<void> owner)
 {
-    CHECK_GE(buffer.size(), remote_md.remote_bytes());
+    Promise<void> promise;
+    auto future = promise.get_future();
 
-    ucp_request_param_t params;
-    std::memset(&params, 0, sizeof(params));
+    issue_send(instance_id, port_address, encoded_object, &promise, std::move(owner));
+
+    // the caller of this await_send method will block and yield the fiber here
+    // the caller is calling an "await" method so blocking and yielding is implied
+    future.get();
+}
+
+void Client::await_send(const PortAddress& port_address,
+                        const codable::EncodedObject& encoded_object,
+                        std::shared_ptr<void> owner)
+{
+    await_send(instance_for(port_address), port_address, encoded_object, std::move(owner));
+}
+
+void Client::async_send(const InstanceID& instance_id,
+                        const PortAddress& port_address,
+                        const codable::EncodedObject& encoded_object,
+                        std::shared_ptr<void> owner)
+{
+    issue_send(instance_id, port_address, encoded_object, nullptr, std::move(owner));
+}
 
-    auto* user_data  = new GetUserData;
-    params.user_data = user_data;
+void Client::async_send(const PortAddress& port_address,
+                        const codable::EncodedObject& encoded_object,
+                        std::shared_ptr<void> owner)
+{
+    async_send(instance_for(port_address), port_address, encoded_object, std::move(owner));
+}
 
-    // unpack rkey on ep
-    const auto& ep = endpoint(remote_md.instance_id());
-    auto rc =
-        ucp_ep_rkey_unpack(ep.handle(), reinterpret_cast<const void*>(remote_md.remote_key().data()), &user_data->rkey);
-    if (rc != UCS_OK)
+void Client::await_flush(const InstanceID& instance_id)
+{
+    auto& window = send_window(instance_id);
     {
-        LOG(ERROR) << "ucp_ep_rkey_unpack failed - " << ucs_status_string(rc);
-        throw exceptions::SrfRuntimeError("ucp_ep_rkey_unpack failed");
+        WindowReservation reservation(window, 1);
+        auto& aggregator = send_aggregator(instance_id);
+        std::lock_guard<Mutex> lock(aggregator.mutex);
+        flush_frame(aggregator, reservation);
     }
+    window.await_empty();
+}
 
-    params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA | UCP_OP_ATTR_FLAG_NO_IMM_CMPL;
-    params.cb.send      = rdma_get_callback;
+std::size_t Client::inflight_sends(InstanceID instance_id) const
+{
+    std::lock_guard<decltype(m_instances_mutex)> lock(m_instances_mutex);
+    auto search = m_send_windows.find(instance_id);
+    return (search == m_send_windows.end() ? 0 : search->second->inflight());
+}
 
-    // possibly set memory type if the fancy pointer provided those details
-    switch (buffer.type())
+void Client::issue_send(const InstanceID& instance_id,
+                        const PortAddress& port_address,
+                        const codable::EncodedObject& encoded_object,
+                        Promise<void>* promise,
+                        std::shared_ptr<void> owner)
+{
+    // with an owner, memory blocks are either registered for the receiver to pull or inlined as eager descriptors
+    std::optional<codable::protos::EncodedObject> rendezvous;
+    std::vector<ObjectID> registered;
+    if (owner)
     {
-    case memory::memory_kind_type::host:
-    case memory::memory_kind_type::pinned:
-        params.op_attr_mask |= UCP_OP_ATTR_FIELD_MEMORY_TYPE;
-        params.memory_type = UCS_MEMORY_TYPE_HOST;
-        LOG(INFO) << "setting ucx_get_nbx memory type to HOST";
-        break;
-    case memory::memory_kind_type::device:
-        params.op_attr_mask |= UCP_OP_ATTR_FIELD_MEMORY_TYPE;
-        params.memory_type = UCS_MEMORY_TYPE_CUDA;
-        LOG(FATAL) << "this path is probably broken";
-        break;
-    default:
-        break;
+        rendezvous = encoded_object.proto();
+        for (auto& desc : *rendezvous->mutable_descriptors())
+        {
+            if (!desc.has_remote_desc())
+            {
+                continue;
+            }
+            auto& remote_desc = *desc.mutable_remote_desc();
+            auto kind         = remote_desc.memory_kind();
+            auto is_host = (kind == codable::protos::MemoryKind::Host || kind == codable::protos::MemoryKind::Pinned);
+            if (remote_desc.remote_bytes() == 0 || (is_host && remote_desc.remote_bytes() < rendezvous_bytes))
+            {
+                std::string data(reinterpret_cast<const char*>(remote_desc.remote_address()),
+                                 remote_desc.remote_bytes());
+                auto* eager_desc = desc.mutable_eager_desc();
+                eager_desc->set_data(std::move(data));
+                eager_desc->set_memory_kind(kind);
+                continue;
+            }
+            registered.push_back(m_remote_descriptors->register_descriptor(remote_desc, owner));
+        }
     }
 
-    auto future = user_data->promise.get_future();
+    // the receiver never learns of descriptors whose send failed to issue, so they are released here
+    try
+    {
+        issue_serialized_send(instance_id, port_address, rendezvous ? *rendezvous : encoded_object.proto(), promise);
+    } catch (...)
+    {
+        for (const auto& object_id : registered)
+        {
+            m_remote_descriptors->release(object_id);
+        }
+        throw;
+    }
+}
+
+void Client::issue_serialized_send(const InstanceID& instance_id,
+                                   const PortAddress& port_address,
+                                   const codable::protos::EncodedObject& proto,
+                                   Promise<void>* promise)
+{
+    // serialize the proto of the encoded object directly into a pooled, ucx registered staging buffer
+    // these are small packed remote descriptors, not the actual payload data
+    auto bytes = proto.ByteSizeLong();
+
+    // window slots are reserved before the aggregator lock so a stalled instance only blocks its own senders: one
+    // for a frame which may be flushed and, unless coalesced, one for this send; unused slots are returned
+    auto coalesce = (promise == nullptr && m_linger.count() > 0 && bytes <= coalesce_bytes);
+    WindowReservation reservation(send_window(instance_id), coalesce ? 1 : 2);
 
-    auto* status = ucp_get_nbx(
-        ep.handle(), buffer.data(), remote_md.remote_bytes(), remote_md.remote_address(), user_data->rkey, &params);
-    if (status == nullptr)  // UCS_OK
+    // the aggregator lock is held while issuing so sends to an instance leave in the order they were serialized
+    auto& aggregator = send_aggregator(instance_id);
+    std::lock_guard<Mutex> lock(aggregator.mutex);
+
+    if (coalesce)
     {
-        LOG(FATAL)
-            << "should be unreachable";  // UCP_OP_ATTR_FLAG_NO_IMM_CMPL is set - should force the completion handler
+        if (aggregator.frame && !aggregator.frame->can_append(bytes))
+        {
+            flush_frame(aggregator, reservation);
+        }
+        if (!aggregator.frame)
+        {
+            aggregator.frame.emplace(m_send_buffers->acquire(frame_bytes));
+            aggregator.opened = std::chrono::steady_clock::now();
+            notify_frame_opened();
+        }
+        auto* payload = aggregator.frame->append(port_address, bytes);
+        CHECK(proto.SerializeToArray(payload, bytes));
+        return;
     }
-    else if (UCS_PTR_IS_ERR(status))
+
+    // previously coalesced sends must not be overtaken
+    flush_frame(aggregator, reservation);
+
+    auto buffer = m_send_buffers->acquire(bytes);
+    CHECK(proto.SerializeToArray(buffer.data(), bytes));
+    issue_tagged_send(instance_id, std::move(buffer), port_address | INGRESS_TAG, promise, reservation);
+}
+
+void Client::flush_frame(SendAggregator& aggregator, WindowReservation& reservation)
+{
+    if (!aggregator.frame)
     {
-        LOG(ERROR) << "rdma get failure";  // << ucs_status_string(status);
-        throw exceptions::SrfRuntimeError("rdma get failure");
+        return;
     }
+    auto frame = aggregator.frame->finalize();
+    aggregator.frame.reset();
+    issue_tagged_send(aggregator.instance_id, std::move(frame), FRAME_TAG, nullptr, reservation);
+}
 
-    // await on promise
-    future.get();
+void Client::notify_frame_opened()
+{
+    std::lock_guard<Mutex> lock(m_linger_mutex);
+    m_frame_opened = true;
+    m_linger_cv.notify_one();
 }
-*/
 
-void Client::await_send(const InstanceID& instance_id,
-                        const PortAddress& port_address,
-                        const codable::EncodedObject& encoded_object)
+void Client::stop_linger_flusher()
 {
-    Promise<void> promise;
-    auto future = promise.get_future();
+    std::lock_guard<Mutex> lock(m_linger_mutex);
+    m_linger_running = false;
+    m_linger_cv.notify_one();
+}
 
-    ucp_tag_t tag = port_address | INGRESS_TAG;
-    ucp_request_param_t params;
+void Client::linger_flush_loop()
+{
+    std::vector<std::pair<InstanceID, std::shared_ptr<SendAggregator>>> aggregators;
 
-    params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
-    params.cb.send      = send_completion_handler_with_future;
-    params.user_data    = &promise;
+    while (true)
+    {
+        // sleep until a frame is opened; the flag is cleared before scanning so a frame opened during the scan is not
+        // missed
+        {
+            std::unique_lock<Mutex> lock(m_linger_mutex);
+            m_linger_cv.wait(lock, [this] { return m_frame_opened || !m_linger_running; });
+            if (!m_linger_running)
+            {
+                return;
+            }
+            m_frame_opened = false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_aggregators_mutex);
+            aggregators.assign(m_send_aggregators.begin(), m_send_aggregators.end());
+        }
+
+        // flush each open frame once it has lingered, sleeping until the earliest deadline
+        bool pending = true;
+        while (pending && m_linger_running)
+        {
+            pending       = false;
+            auto now      = std::chrono::steady_clock::now();
+            auto earliest = std::chrono::steady_clock::time_point::max();
+
+            for (auto& [id, aggregator] : aggregators)
+            {
+                {
+                    std::lock_guard<Mutex> lock(aggregator->mutex);
+                    if (!aggregator->frame)
+                    {
+                        continue;
+                    }
+                    auto deadline = aggregator->opened + m_linger;
+                    if (deadline > now)
+                    {
+                        pending  = true;
+                        earliest = std::min(earliest, deadline);
+                        continue;
+                    }
+                }
+
+                // reserve the slot without holding the aggregator lock; a sender may have flushed the frame meanwhile
+                WindowReservation reservation(send_window(id), 1);
+                std::lock_guard<Mutex> lock(aggregator->mutex);
+                if (aggregator->frame && aggregator->opened + m_linger <= now)
+                {
+                    flush_frame(*aggregator, reservation);
+                }
+            }
+
+            if (pending)
+            {
+                boost::this_fiber::sleep_until(earliest);
+            }
+        }
+    }
+}
 
-    // serialize the proto of the encoded object into it's own encoded object
-    // dogfooding at its best
-    codable::EncodedObject msg;
-    codable::encode(encoded_object.proto(), msg);
+void Client::issue_tagged_send(const InstanceID& instance_id,
+                               PooledBuffer buffer,
+                               ucp_tag_t tag,
+                               Promise<void>* promise,
+                               WindowReservation& reservation)
+{
+    const auto& ep = endpoint(instance_id);
+
+    // the slot is released by the completion handler
+    auto& window = reservation.take();
+
+    auto bytes      = buffer.bytes();
+    void* context   = buffer.context();
+    auto* in_flight = new (context) InFlightSend{std::move(buffer), &window, promise};
 
-    // sanity check
-    // 1) there should be only 1 descriptor, and
-    // 2) the size of the memory block should be the size of the protos requested
-    DCHECK_EQ(msg.descriptor_count(), 1);
-    auto block = msg.memory_block(0);
-    DCHECK_EQ(block.bytes(), encoded_object.proto().ByteSizeLong());
+    ucp_request_param_t params;
+
+    params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
+    params.cb.send      = send_completion_handler;
+    params.user_data    = in_flight;
 
     // all encoded_objects are serialized to host memory
-    // these are small packed remote descriptors, not the actual payload data
     params.op_attr_mask |= UCP_OP_ATTR_FIELD_MEMORY_TYPE;
     params.memory_type = UCS_MEMORY_TYPE_HOST;
 
     // issue send
-    ucs_status_ptr_t request =
-        ucp_tag_send_nbx(endpoint(instance_id).handle(), block.data(), block.bytes(), tag, &params);
+    ucs_status_ptr_t request = ucp_tag_send_nbx(ep.handle(), in_flight->buffer.data(), bytes, tag, &params);
 
     if (request == nullptr /* UCS_OK */)
     {
+        // completed immediately - the callback will not be invoked
+        complete_send(in_flight, UCS_OK);
         return;
     }
     if (UCS_PTR_IS_ERR(request))
     {
-        LOG(ERROR) << "send failed - ";
+        auto status = UCS_PTR_STATUS(request);
+        LOG(ERROR) << "send failed - " << ucs_status_string(status);
+        in_flight->promise = nullptr;
+        complete_send(in_flight, status);
         throw std::runtime_error("send failed");
     }
 
@@ -322,14 +739,11 @@ void Client::await_send(const InstanceID& instance_id,
     // is in flight. push the request to the progress engine which will
     // wake up a progress fiber to complete the send
     push_request(std::move(request));
-
-    // the caller of this await_send method will block and yield the fiber here
-    // the caller is calling an "await" method so blocking and yielding is implied
-    future.get();
 }
 
 std::size_t Client::connections() const
 {
+    std::lock_guard<decltype(m_instances_mutex)> lock(m_instances_mutex);
     return m_endpoints.size();
 }
 
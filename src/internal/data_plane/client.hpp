@@ -17,11 +17,14 @@
 
 #pragma once
 
+#include "internal/data_plane/buffer_pool.hpp"
+#include "internal/data_plane/remote_descriptor_manager.hpp"
 #include "internal/service.hpp"
 
-#include <srf/protos/remote_descriptor.pb.h>
+#include <srf/protos/codable.pb.h>
 #include <srf/channel/status.hpp>
 #include <srf/codable/encoded_object.hpp>
+#include <srf/memory/block.hpp>
 #include <srf/node/source_channel.hpp>
 #include <srf/runnable/launch_control.hpp>
 #include <srf/runnable/runner.hpp>
@@ -34,18 +37,53 @@
 #include <ucp/api/ucp_def.h>
 #include <rxcpp/rx.hpp>  // IWYU pragma: keep
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
 
 namespace srf::internal::data_plane {
 
+class SendWindow;
+class WindowReservation;
+struct SendAggregator;
+
 // todo(ryan) - rename NetworkSendManager -> DataPlaneAPI
 
 class Client final : public Service
 {
   public:
-    Client(std::shared_ptr<ucx::Context> context);
+    // default number of sends that may be in flight to a single remote instance
+    static constexpr std::size_t default_send_window = 64;  // NOLINT
+
+    // default time a partially filled frame may linger before it is flushed; zero disables coalescing
+    static constexpr std::chrono::microseconds default_linger{20};  // NOLINT
+
+    // async sends whose serialized proto is at most this many bytes are coalesced into frames
+    static constexpr std::size_t coalesce_bytes = 1024;  // NOLINT
+
+    // payload capacity of a coalesced frame
+    static constexpr std::size_t frame_bytes = 16384;  // NOLINT
+
+    // memory blocks of at least this many bytes are sent by reference and pulled by the receiver with an rdma get
+    static constexpr std::size_t rendezvous_bytes = 8192;  // NOLINT
+
+    /**
+     * @param context
+     * @param worker the worker of the partition which owns this client; shared with the partition's Server
+     * @param remote_descriptors
+     * @param send_window
+     * @param linger
+     */
+    Client(std::shared_ptr<ucx::Context> context,
+           std::shared_ptr<ucx::Worker> worker,
+           std::shared_ptr<RemoteDescriptorManager> remote_descriptors,
+           std::size_t send_window          = default_send_window,
+           std::chrono::microseconds linger = default_linger);
     ~Client() final;
 
     /**
@@ -53,6 +91,21 @@ class Client final : public Service
      */
     void register_instance(InstanceID instance_id, ucx::WorkerAddress worker_address);
 
+    /**
+     * @brief Register the InstanceID of the partition which hosts the segment at SegmentAddress
+     *
+     * Each partition owns its own ucx worker, so data destined for a segment must be sent to the worker of the
+     * partition on which the segment was placed.
+     */
+    void register_segment(SegmentAddress segment_address, InstanceID instance_id);
+
+    void drop_segment(SegmentAddress segment_address);
+
+    /**
+     * @brief InstanceID of the partition hosting the segment of a PortAddress; throws if the segment is not registered
+     */
+    InstanceID instance_for(const PortAddress& port_address) const;
+
     /**
      * @brief Send an EncodedObject to the PortAddress at InstanceID
      *
@@ -61,13 +114,68 @@ class Client final : public Service
      * the await_send with only port_address and encoded_object; however, the internal should be able to short
      * circuit the translation.
      *
+     * If an owner is provided, the memory blocks of the encoded object are sent with the rendezvous protocol: blocks of
+     * at least rendezvous_bytes are registered with the RemoteDescriptorManager and pulled by the receiver, while
+     * smaller host blocks are copied into eager descriptors. The owner must keep the memory described by the encoded
+     * object alive and is held until the receiver has released every remote descriptor. Without an owner, the
+     * descriptors of the encoded object are sent as is.
+     *
      * @param instance_id
      * @param port_address
      * @param encoded_object
+     * @param owner
      */
     void await_send(const InstanceID& instance_id,
                     const PortAddress& port_address,
-                    const codable::EncodedObject& encoded_object);
+                    const codable::EncodedObject& encoded_object,
+                    std::shared_ptr<void> owner = nullptr);
+
+    /**
+     * @brief Send an EncodedObject to the PortAddress on the partition which hosts its segment, see instance_for
+     */
+    void await_send(const PortAddress& port_address,
+                    const codable::EncodedObject& encoded_object,
+                    std::shared_ptr<void> owner = nullptr);
+
+    /**
+     * @brief Issue a send of an EncodedObject to the PortAddress at InstanceID without awaiting its completion
+     *
+     * The proto of the encoded object is serialized into a pooled send buffer, so the EncodedObject may be released as
+     * soon as this method returns. Completion is tracked by the DataPlaneClientWorker progress engine. At most
+     * send_window sends may be in flight to a given InstanceID; when the window is full the calling fiber yields
+     * until an in-flight send completes.
+     *
+     * Small encoded objects are coalesced with other async sends to the same InstanceID into a single FRAME_TAG
+     * message. A frame is flushed when it is full, when it has lingered for longer than the linger period, or when a
+     * non-coalesced send or flush is issued to the same InstanceID. Sends to a given InstanceID from a single caller
+     * are delivered in order.
+     *
+     * See await_send for the handling of owner.
+     *
+     * @param instance_id
+     * @param port_address
+     * @param encoded_object
+     * @param owner
+     */
+    void async_send(const InstanceID& instance_id,
+                    const PortAddress& port_address,
+                    const codable::EncodedObject& encoded_object,
+                    std::shared_ptr<void> owner = nullptr);
+
+    /**
+     * @brief Issue a send of an EncodedObject to the PortAddress on the partition which hosts its segment
+     */
+    void async_send(const PortAddress& port_address,
+                    const codable::EncodedObject& encoded_object,
+                    std::shared_ptr<void> owner = nullptr);
+
+    /**
+     * @brief Flush any partially filled frame, then await the completion of all in-flight sends to InstanceID
+     */
+    void await_flush(const InstanceID& instance_id);
+
+    // number of sends currently in flight to a remote instance
+    std::size_t inflight_sends(InstanceID) const;
 
     // number of established remote instances
     std::size_t connections() const;
@@ -77,9 +185,6 @@ class Client final : public Service
 
     void decrement_remote_descriptor(InstanceID, ObjectID);
 
-    // void get(const protos::RemoteDescriptor&, void*, size_t);
-    // void get(const protos::RemoteDescriptor&, Descriptor&);
-
   protected:
     // issue tag only send - no payload data
     void issue_network_event(InstanceID, ucp_tag_t);
@@ -89,6 +194,47 @@ class Client final : public Service
 
     void push_request(void* request);
 
+    // serialize the encoded object into a pooled buffer or a coalesced frame and issue the send; promise is optional
+    // and encoded objects with a promise are never coalesced
+    void issue_send(const InstanceID& instance_id,
+                    const PortAddress& port_address,
+                    const codable::EncodedObject& encoded_object,
+                    Promise<void>* promise,
+                    std::shared_ptr<void> owner);
+
+    // issue_send after any remote descriptors of the proto have been registered
+    void issue_serialized_send(const InstanceID& instance_id,
+                               const PortAddress& port_address,
+                               const codable::protos::EncodedObject& proto,
+                               Promise<void>* promise);
+
+    // issue a tagged send of a pooled buffer using a slot of the reservation; the buffer and the slot are released
+    // when the send completes
+    void issue_tagged_send(const InstanceID& instance_id,
+                           PooledBuffer buffer,
+                           ucp_tag_t tag,
+                           Promise<void>* promise,
+                           WindowReservation& reservation);
+
+    // issue the partially filled frame of an aggregator, if any; the caller must hold the aggregator's mutex and a
+    // reservation of the aggregator's send window which was acquired before taking it
+    void flush_frame(SendAggregator& aggregator, WindowReservation& reservation);
+
+    // get the send window for instance id; throws if the instance was not registered
+    SendWindow& send_window(InstanceID) const;
+
+    // get the frame aggregator for instance id
+    SendAggregator& send_aggregator(InstanceID) const;
+
+    // flushes frames which have lingered longer than the linger period; runs on a fiber while the service is live and
+    // waits on m_linger_cv while no frame is open
+    void linger_flush_loop();
+
+    // wake the linger flusher after a frame was opened
+    void notify_frame_opened();
+
+    void stop_linger_flusher();
+
   private:
     void do_service_start() final;
     void do_service_await_live() final;
@@ -100,8 +246,34 @@ class Client final : public Service
     std::unique_ptr<node::SourceChannelWriteable<void*>> m_ucx_request_channel;
     std::unique_ptr<runnable::Runner> m_progress_engine;
 
+    // guards the per-instance state below; entries are created by register_instance or lazily for endpoints
+    mutable std::mutex m_instances_mutex;
     std::map<InstanceID, ucx::WorkerAddress> m_workers;
     mutable std::map<InstanceID, std::shared_ptr<ucx::Endpoint>> m_endpoints;
+
+    // partition instance hosting each remote segment
+    mutable std::shared_mutex m_segments_mutex;
+    std::map<SegmentAddress, InstanceID> m_segments;
+
+    // bounded number of in-flight sends per remote instance; created when the instance is registered
+    std::size_t m_send_window_size;
+    std::map<InstanceID, std::shared_ptr<SendWindow>> m_send_windows;
+
+    // small message coalescing per remote instance
+    std::chrono::microseconds m_linger;
+    mutable std::mutex m_aggregators_mutex;
+    mutable std::map<InstanceID, std::shared_ptr<SendAggregator>> m_send_aggregators;
+    std::atomic<bool> m_linger_running{false};
+    Mutex m_linger_mutex;
+    CondV m_linger_cv;
+    bool m_frame_opened{false};
+    Future<void> m_linger_flusher;
+
+    // pooled and ucx registered staging buffers for serialized EncodedObjects
+    std::shared_ptr<BufferPool> m_send_buffers;
+
+    // sender side state of the rendezvous protocol; shared with the Server which receives release events
+    std::shared_ptr<RemoteDescriptorManager> m_remote_descriptors;
 };
 
 }  // namespace srf::internal::data_plane
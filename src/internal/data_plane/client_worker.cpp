@@ -19,14 +19,16 @@
 
 #include "internal/ucx/worker.hpp"
 
-#include <ucp/api/ucp_compat.h>
+#include <ucp/api/ucp.h>
+#include <ucs/type/status.h>
 #include <boost/fiber/operations.hpp>
 
 namespace srf::internal::data_plane {
 
 void DataPlaneClientWorker::on_data(void*&& data)
 {
-    while (ucp_request_is_completed(data) == 0)
+    // completion callbacks of this and any other in-flight requests are invoked from progress
+    while (ucp_request_check_status(data) == UCS_INPROGRESS)
     {
         if (m_worker->progress() != 0U)
         {
@@ -34,7 +36,7 @@ void DataPlaneClientWorker::on_data(void*&& data)
         }
         boost::this_fiber::yield();
     }
-    ucp_request_release(data);
+    ucp_request_free(data);
 }
 
 }  // namespace srf::internal::data_plane
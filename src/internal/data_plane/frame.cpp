@@ -0,0 +1,136 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/data_plane/frame.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <utility>
+
+namespace srf::internal::data_plane {
+
+namespace {
+
+// walks the records of a frame, invoking on_record for each if it is not null; returns false on the first malformed
+// record
+bool walk_frame_records(const void* frame,
+                        std::size_t bytes,
+                        const std::function<void(PortAddress, const void*, std::size_t)>* on_record)
+{
+    if (bytes < sizeof(FrameHeader))
+    {
+        LOG(ERROR) << "frame of " << bytes << " bytes is too small to hold a frame header";
+        return false;
+    }
+
+    const auto* start = static_cast<const std::byte*>(frame);
+
+    FrameHeader header;
+    std::memcpy(&header, start, sizeof(header));
+
+    std::size_t offset = sizeof(FrameHeader);
+    for (std::uint32_t i = 0; i < header.record_count; i++)
+    {
+        if (offset + sizeof(FrameRecordHeader) > bytes)
+        {
+            LOG(ERROR) << "frame record " << i << " header extends past the end of the frame";
+            return false;
+        }
+
+        FrameRecordHeader record;
+        std::memcpy(&record, start + offset, sizeof(record));
+
+        // compared against the remaining bytes so a corrupt length cannot overflow the bounds check
+        if (record.bytes > bytes - offset - sizeof(FrameRecordHeader))
+        {
+            LOG(ERROR) << "frame record " << i << " payload extends past the end of the frame";
+            return false;
+        }
+
+        if (on_record != nullptr)
+        {
+            (*on_record)(record.port_address, start + offset + sizeof(FrameRecordHeader), record.bytes);
+        }
+        offset = std::min(offset + FrameWriter::record_bytes(record.bytes), bytes);
+    }
+
+    return true;
+}
+
+}  // namespace
+
+FrameWriter::FrameWriter(PooledBuffer buffer) : m_buffer(std::move(buffer)), m_offset(sizeof(FrameHeader))
+{
+    CHECK(m_buffer);
+    CHECK_GE(m_buffer.capacity(), sizeof(FrameHeader));
+}
+
+bool FrameWriter::can_append(std::size_t payload_bytes) const
+{
+    return m_offset + record_bytes(payload_bytes) <= m_buffer.capacity();
+}
+
+void* FrameWriter::append(PortAddress port_address, std::size_t payload_bytes)
+{
+    CHECK(can_append(payload_bytes));
+
+    auto* start = static_cast<std::byte*>(m_buffer.data()) + m_offset;
+
+    FrameRecordHeader header{port_address, payload_bytes};
+    std::memcpy(start, &header, sizeof(header));
+
+    m_offset += record_bytes(payload_bytes);
+    ++m_record_count;
+
+    return start + sizeof(FrameRecordHeader);
+}
+
+std::size_t FrameWriter::record_count() const
+{
+    return m_record_count;
+}
+
+std::size_t FrameWriter::bytes() const
+{
+    return m_offset;
+}
+
+PooledBuffer FrameWriter::finalize()
+{
+    FrameHeader header{m_record_count, 0};
+    std::memcpy(m_buffer.data(), &header, sizeof(header));
+    m_buffer.resize(m_offset);
+    return std::move(m_buffer);
+}
+
+bool for_each_frame_record(const void* frame,
+                           std::size_t bytes,
+                           const std::function<void(PortAddress, const void*, std::size_t)>& on_record)
+{
+    // validate every record before dispatching any so a malformed frame is dropped as a whole
+    if (!walk_frame_records(frame, bytes, nullptr))
+    {
+        return false;
+    }
+    walk_frame_records(frame, bytes, &on_record);
+    return true;
+}
+
+}  // namespace srf::internal::data_plane
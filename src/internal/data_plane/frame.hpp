@@ -0,0 +1,150 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/data_plane/buffer_pool.hpp"
+
+#include <srf/memory/blob_storage.hpp>
+#include <srf/memory/memory_kind.hpp>
+#include <srf/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+// A frame packs many small serialized EncodedObjects destined for the same remote instance into a single tagged
+// message, amortizing the per-message tag matching and completion overhead. Frames are sent with FRAME_TAG.
+//
+// wire layout; all offsets are 8-byte aligned
+//   FrameHeader
+//   FrameRecordHeader | payload | padding
+//   ...
+
+namespace srf::internal::data_plane {
+
+struct FrameHeader
+{
+    std::uint32_t record_count;
+    std::uint32_t reserved;
+};
+
+struct FrameRecordHeader
+{
+    PortAddress port_address;
+    std::uint64_t bytes;
+};
+
+/**
+ * @brief Appends records to a pooled buffer in the frame wire format.
+ */
+class FrameWriter final
+{
+  public:
+    static constexpr std::size_t alignment = 8;  // NOLINT
+
+    FrameWriter(PooledBuffer buffer);
+
+    // total frame bytes consumed by a record with a payload of payload_bytes
+    static constexpr std::size_t record_bytes(std::size_t payload_bytes)
+    {
+        return sizeof(FrameRecordHeader) + ((payload_bytes + alignment - 1) & ~(alignment - 1));
+    }
+
+    // true if a record with a payload of payload_bytes fits in the remaining capacity
+    bool can_append(std::size_t payload_bytes) const;
+
+    // append a record header and return a pointer to the payload region of payload_bytes
+    void* append(PortAddress port_address, std::size_t payload_bytes);
+
+    std::size_t record_count() const;
+
+    // number of frame bytes written
+    std::size_t bytes() const;
+
+    // finalize the frame header and release the buffer sized to the frame
+    PooledBuffer finalize();
+
+  private:
+    PooledBuffer m_buffer;
+    std::size_t m_offset;
+    std::uint32_t m_record_count{0};
+};
+
+/**
+ * @brief Validates and walks the records of a frame; returns false if the frame is malformed, in which case on_record
+ * is not invoked for any record
+ */
+bool for_each_frame_record(const void* frame,
+                           std::size_t bytes,
+                           const std::function<void(PortAddress, const void*, std::size_t)>& on_record);
+
+/**
+ * @brief A record within a received frame; holds a reference to the frame so the frame's pooled buffer is recycled
+ * when the last record is released.
+ */
+struct FrameSlice
+{
+    std::shared_ptr<PooledBuffer> frame;
+    void* data;
+    std::size_t bytes;
+};
+
+}  // namespace srf::internal::data_plane
+
+namespace srf::memory {
+
+template <>
+class BlobStorage<internal::data_plane::FrameSlice> final : public IBlobStorage
+{
+  public:
+    BlobStorage(internal::data_plane::FrameSlice&& slice) : m_slice(std::move(slice)) {}
+    ~BlobStorage() final = default;
+
+  private:
+    void* do_data() final
+    {
+        return m_slice.data;
+    }
+
+    const void* do_data() const final
+    {
+        return m_slice.data;
+    }
+
+    std::size_t do_bytes() const final
+    {
+        return m_slice.bytes;
+    }
+
+    memory_kind_type do_kind() const final
+    {
+        return memory_kind_type::host;
+    }
+
+    std::shared_ptr<IBlobStorage> do_allocate(std::size_t bytes, cudaStream_t stream) const final
+    {
+        CHECK(stream == nullptr);
+        return std::make_shared<BlobStorage<internal::data_plane::PooledBuffer>>(
+            m_slice.frame->pool()->acquire(bytes));
+    }
+
+    internal::data_plane::FrameSlice m_slice;
+};
+
+}  // namespace srf::memory
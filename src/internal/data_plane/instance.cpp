@@ -18,10 +18,12 @@
 #include "internal/data_plane/instance.hpp"
 
 #include "internal/data_plane/client.hpp"
+#include "internal/data_plane/remote_descriptor_manager.hpp"
 #include "internal/data_plane/server.hpp"
 
 #include <srf/runnable/launch_control.hpp>
 #include "internal/ucx/context.hpp"
+#include "internal/ucx/worker.hpp"
 
 #include <glog/logging.h>
 
@@ -29,17 +31,36 @@
 
 namespace srf::internal::data_plane {
 
-Instance::Instance(std::unique_ptr<resources::PartitionResources> resources) : m_resources(std::move(resources)) {}
-// m_context(std::make_shared<ucx::Context>()),
-// m_client(std::make_shared<Client>(m_context)),
-// m_server(std::make_shared<Server>(m_context))
-// {}
+Instance::Instance(std::unique_ptr<resources::PartitionResources> resources,
+                   std::shared_ptr<ucx::Context> context,
+                   ucs_thread_mode_t thread_mode) :
+  m_resources(std::move(resources)),
+  m_context(std::move(context))
+{
+    CHECK(m_resources);
+    CHECK(m_context);
+    m_worker = std::make_shared<ucx::Worker>(m_context, thread_mode);
+}
 
 Instance::~Instance()
 {
     call_in_destructor();
 }
 
+ucx::WorkerAddress Instance::worker_address() const
+{
+    return m_worker->address();
+}
+
+void Instance::initialize(InstanceID instance_id)
+{
+    CHECK(!m_client && !m_server) << "data plane instance was already initialized";
+
+    m_remote_descriptors = std::make_shared<RemoteDescriptorManager>(instance_id, m_context);
+    m_client             = std::make_unique<Client>(m_context, m_worker, m_remote_descriptors);
+    m_server             = std::make_unique<Server>(m_context, m_worker, m_resources, m_remote_descriptors);
+}
+
 Client& Instance::comms_manager() const
 {
     CHECK(m_client);
@@ -18,12 +18,16 @@
 #pragma once
 
 #include "internal/data_plane/client.hpp"
+#include "internal/data_plane/remote_descriptor_manager.hpp"
 #include "internal/data_plane/server.hpp"
 #include "internal/resources/partition_resources.hpp"
 #include "internal/service.hpp"
 #include "internal/ucx/context.hpp"
+#include "internal/ucx/worker.hpp"
 #include "srf/runnable/launch_control.hpp"
 
+#include <ucs/type/thread_mode.h>
+
 #include <memory>
 
 namespace srf::internal::data_plane {
@@ -31,13 +35,32 @@ namespace srf::internal::data_plane {
 /**
  * @brief ArchitectResources hold and is responsible for constructing any object that depending the UCX data plane
  *
+ * One Instance is constructed per partition. Each Instance owns a ucx worker which is shared by its Client and Server,
+ * so endpoints are formed between pairs of partition workers and no worker is shared across partitions. The ucx
+ * context is shared by all partitions of the process.
+ *
+ * The worker is created on construction so that its address may be registered with the control plane; the Client and
+ * Server are constructed by initialize once the InstanceID assigned to the worker is known.
+ *
+ * The worker defaults to UCS_THREAD_MODE_MULTI. It is not confined to one thread: the Server progresses it from its
+ * progress engine, while sends, endpoint creation and the linger flush reach it from the fibers of callers of the
+ * Client. UCS_THREAD_MODE_SERIALIZED may only be passed once every worker operation runs on a single progress
+ * engine.
  */
 class Instance final : public Service
 {
   public:
-    Instance(std::unique_ptr<resources::PartitionResources> resources);
+    Instance(std::unique_ptr<resources::PartitionResources> resources,
+             std::shared_ptr<ucx::Context> context,
+             ucs_thread_mode_t thread_mode = UCS_THREAD_MODE_MULTI);
     ~Instance() final;
 
+    // address of this partition's worker
+    ucx::WorkerAddress worker_address() const;
+
+    // construct the Client and Server of this partition once the control plane has assigned its InstanceID
+    void initialize(InstanceID instance_id);
+
     Client& comms_manager() const;
     Server& events_manager() const;
 
@@ -51,8 +74,10 @@ class Instance final : public Service
     void do_service_kill() final;
     void do_service_await_join() final;
 
-    std::unique_ptr<resources::PartitionResources> m_resources;
+    std::shared_ptr<resources::PartitionResources> m_resources;
     std::shared_ptr<ucx::Context> m_context;
+    std::shared_ptr<ucx::Worker> m_worker;
+    std::shared_ptr<RemoteDescriptorManager> m_remote_descriptors;
     std::unique_ptr<Client> m_client;
     std::unique_ptr<Server> m_server;
 };
@@ -0,0 +1,142 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/data_plane/remote_descriptor_manager.hpp"
+
+#include "internal/ucx/context.hpp"
+
+#include <srf/memory/core/ucx_memory_block.hpp>
+#include <srf/memory/resources/ucx_registered_resource.hpp>
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <tuple>
+#include <utility>
+
+namespace srf::internal::data_plane {
+
+RemoteDescriptorManager::RemoteDescriptorManager(InstanceID instance_id, std::shared_ptr<ucx::Context> context) :
+  m_instance_id(instance_id),
+  m_context(std::move(context))
+{
+    CHECK(m_context);
+}
+
+RemoteDescriptorManager::~RemoteDescriptorManager()
+{
+    LOG_IF(WARNING, !m_registrations.empty())
+        << "releasing " << m_registrations.size() << " remote descriptors which were never pulled";
+    for (auto& [id, registration] : m_registrations)
+    {
+        if (registration.handle != nullptr)
+        {
+            m_context->unregister_memory(registration.handle, registration.rkey_buffer);
+        }
+    }
+}
+
+ObjectID RemoteDescriptorManager::register_descriptor(codable::protos::RemoteDescriptor& desc,
+                                                      std::shared_ptr<void> owner)
+{
+    CHECK(owner);
+    CHECK_GT(desc.remote_bytes(), 0);
+
+    auto* address = reinterpret_cast<void*>(desc.remote_address());
+    auto* last    = static_cast<std::byte*>(address) + desc.remote_bytes() - 1;
+
+    ucp_mem_h handle  = nullptr;
+    void* rkey_buffer = nullptr;
+
+    // reuse the registration of a pre-registered block which contains the entire memory region
+    for (const auto& cache : m_caches)
+    {
+        auto block = cache->find(address);
+        if (block && block->contains(last))
+        {
+            desc.set_remote_key(block->remote_handle(), block->remote_handle_size());
+            break;
+        }
+    }
+
+    if (desc.remote_key().empty())
+    {
+        std::size_t rkey_bytes;
+        std::tie(handle, rkey_buffer, rkey_bytes) = m_context->register_memory_with_rkey(address, desc.remote_bytes());
+        desc.set_remote_key(rkey_buffer, rkey_bytes);
+    }
+
+    desc.set_instance_id(m_instance_id);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // object ids are recycled once released; skip any which are still outstanding after wrapping
+    ObjectID object_id;
+    do
+    {
+        object_id = m_next_object_id++;
+    } while (m_registrations.count(object_id) != 0);
+
+    m_registrations.emplace(object_id, Registration{handle, rkey_buffer, std::move(owner)});
+    desc.set_object_id(object_id);
+    return object_id;
+}
+
+bool RemoteDescriptorManager::release(ObjectID object_id)
+{
+    Registration registration;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto search = m_registrations.find(object_id);
+        if (search == m_registrations.end())
+        {
+            // released events arrive from the network; a duplicate or stale id must not take down the progress engine
+            LOG(WARNING) << "dropping release of unknown remote descriptor object_id: " << object_id;
+            return false;
+        }
+        registration = std::move(search->second);
+        m_registrations.erase(search);
+    }
+
+    // unregister and drop the owner outside the lock
+    if (registration.handle != nullptr)
+    {
+        m_context->unregister_memory(registration.handle, registration.rkey_buffer);
+    }
+    return true;
+}
+
+void RemoteDescriptorManager::add_registration_cache(std::shared_ptr<memory::ucx_registration_cache> cache)
+{
+    CHECK(cache);
+    m_caches.push_back(std::move(cache));
+}
+
+std::size_t RemoteDescriptorManager::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_registrations.size();
+}
+
+InstanceID RemoteDescriptorManager::instance_id() const
+{
+    return m_instance_id;
+}
+
+}  // namespace srf::internal::data_plane
@@ -0,0 +1,108 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/ucx/context.hpp"
+
+#include <srf/protos/codable.pb.h>
+#include <srf/types.hpp>
+#include <srf/utils/macros.hpp>
+
+#include <ucp/api/ucp_def.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace srf::memory {
+struct ucx_registration_cache;
+}  // namespace srf::memory
+
+namespace srf::internal::data_plane {
+
+/**
+ * @brief Owns the sender side state of the rendezvous protocol.
+ *
+ * Each memory region sent by reference is registered with ucx, assigned a unique ObjectID and its packed rkey is
+ * written into the RemoteDescriptor. The registration and an owner object, which keeps the memory region alive, are
+ * held until the receiving instance has pulled the region with an RDMA get and released it by issuing a
+ * DESCRIPTOR_TAG event with the ObjectID, see Client::decrement_remote_descriptor. The receive side, which pulls the
+ * region and issues the release, is not implemented yet; until it is, registrations are only released by the
+ * DESCRIPTOR_TAG handler of the Server or on destruction.
+ *
+ * Memory allocated from a ucx_registered_resource is already registered; if a registration cache has been added which
+ * owns the memory region, its cached rkey is used and no per-transfer registration is performed.
+ *
+ * register_descriptor is called from sending fibers; release is called from the server's progress engine.
+ */
+class RemoteDescriptorManager final
+{
+  public:
+    RemoteDescriptorManager(InstanceID instance_id, std::shared_ptr<ucx::Context> context);
+    ~RemoteDescriptorManager();
+
+    DELETE_COPYABILITY(RemoteDescriptorManager);
+    DELETE_MOVEABILITY(RemoteDescriptorManager);
+
+    /**
+     * @brief Register the memory described by desc and fill in its instance_id, object_id and remote_key
+     *
+     * @param desc RemoteDescriptor whose remote_address and remote_bytes describe a local memory region
+     * @param owner keeps the memory region alive until the descriptor is released
+     * @return ObjectID
+     */
+    ObjectID register_descriptor(codable::protos::RemoteDescriptor& desc, std::shared_ptr<void> owner);
+
+    /**
+     * @brief Add a cache of pre-registered memory consulted before registering a memory region; not thread safe with
+     * respect to register_descriptor and should be called before any sends are issued
+     */
+    void add_registration_cache(std::shared_ptr<memory::ucx_registration_cache> cache);
+
+    /**
+     * @brief Unregister the memory region of a remote descriptor, if it was registered on the fly, and drop its owner
+     *
+     * @return false if object_id is not registered, e.g. a duplicate release; the release is logged and dropped
+     */
+    bool release(ObjectID object_id);
+
+    // number of registered remote descriptors which have not been released
+    std::size_t size() const;
+
+    InstanceID instance_id() const;
+
+  private:
+    struct Registration
+    {
+        // null if the memory region was found in a registration cache
+        ucp_mem_h handle;
+        void* rkey_buffer;
+        std::shared_ptr<void> owner;
+    };
+
+    const InstanceID m_instance_id;
+    std::shared_ptr<ucx::Context> m_context;
+    ObjectID m_next_object_id{0};
+    std::map<ObjectID, Registration> m_registrations;
+    std::vector<std::shared_ptr<memory::ucx_registration_cache>> m_caches;
+    mutable std::mutex m_mutex;
+};
+
+}  // namespace srf::internal::data_plane
@@ -17,10 +17,13 @@
 
 #include "internal/data_plane/server.hpp"
 
+#include "internal/data_plane/buffer_pool.hpp"
+#include "internal/data_plane/frame.hpp"
+#include "internal/data_plane/remote_descriptor_manager.hpp"
 #include "internal/data_plane/tags.hpp"
 
 #include <srf/channel/status.hpp>
-#include <srf/memory/block.hpp>
+#include <srf/memory/blob.hpp>
 #include <srf/memory/memory_kind.hpp>
 #include <srf/node/edge_builder.hpp>
 #include <srf/node/operators/router.hpp>
@@ -33,6 +36,7 @@
 #include <srf/types.hpp>
 #include "internal/ucx/common.hpp"
 #include "internal/ucx/context.hpp"
+#include "internal/ucx/progress.hpp"
 #include "internal/ucx/worker.hpp"
 
 #include <glog/logging.h>
@@ -44,19 +48,33 @@
 #include <rxcpp/rx-subscriber.hpp>
 #include <rxcpp/rx.hpp>  // IWYU pragma: keep
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
-#include <cstdlib>
 #include <exception>
+#include <memory>
+#include <new>
 #include <ostream>
 #include <utility>
 
 namespace srf::internal::data_plane {
 
-static thread_local rxcpp::subscriber<network_event_t>* static_subscriber = nullptr;
-
 namespace {
 
+/**
+ * @brief Completion state of an in-flight INGRESS_TAG or FRAME_TAG receive.
+ *
+ * Constructed in place in the context region of the pooled receive buffer which it owns, so the recv completion
+ * handler can recover both the payload and the subscriber from the user_data pointer.
+ */
+struct InFlightReceive
+{
+    PooledBuffer buffer;
+    rxcpp::subscriber<network_event_t>* subscriber;
+};
+
+static_assert(sizeof(InFlightReceive) <= BufferPool::context_bytes, "InFlightReceive must fit in context");
+
 void zero_bytes_completion_handler(void* request,
                                    ucs_status_t status,
                                    const ucp_tag_recv_info_t* msg_info,
@@ -75,18 +93,52 @@ void recv_completion_handler(void* request, ucs_status_t status, const ucp_tag_r
     {
         LOG(FATAL) << "recv_completion_handler observed " << ucs_status_string(status);
     }
-    auto port_address = tag_decode_user_tag(msg_info->sender_tag);
-    DCHECK(static_subscriber && static_subscriber->is_subscribed());
-    auto msg = std::make_pair(port_address, memory::block(user_data, msg_info->length, memory::memory_kind_type::host));
-    static_subscriber->on_next(std::move(msg));
+
+    // take ownership of the buffer, then tear down the in-flight state which lives inside the buffer's context region
+    auto* in_flight  = static_cast<InFlightReceive*>(user_data);
+    auto buffer      = std::move(in_flight->buffer);
+    auto* subscriber = in_flight->subscriber;
+    in_flight->~InFlightReceive();
+
+    DCHECK(subscriber && subscriber->is_subscribed());
+    DCHECK_EQ(buffer.bytes(), msg_info->length);
+
+    if (tag_decode_msg_type(msg_info->sender_tag) == FRAME_TAG)
+    {
+        // split the frame into a blob per record; each blob holds a reference to the frame, so the pooled buffer is
+        // recycled once the last record has been consumed; a malformed frame is peer supplied, so it is logged and
+        // dropped as a whole rather than aborting the process
+        auto frame = std::make_shared<PooledBuffer>(std::move(buffer));
+        auto valid = for_each_frame_record(
+            frame->data(), frame->bytes(), [&](PortAddress port_address, const void* data, std::size_t bytes) {
+                FrameSlice slice{frame, const_cast<void*>(data), bytes};
+                subscriber->on_next(std::make_pair(port_address, memory::blob(std::move(slice))));
+            });
+        LOG_IF(ERROR, !valid) << "dropping malformed data plane frame of " << msg_info->length << " bytes";
+    }
+    else
+    {
+        auto port_address = tag_decode_user_tag(msg_info->sender_tag);
+        subscriber->on_next(std::make_pair(port_address, memory::blob(std::move(buffer))));
+    }
     ucp_request_free(request);
 }
 
 }  // namespace
 
-Server::Server(std::shared_ptr<ucx::Context> context, std::shared_ptr<resources::PartitionResources> resources) :
-  m_worker(std::make_shared<ucx::Worker>(context))
-{}
+Server::Server(std::shared_ptr<ucx::Context> context,
+               std::shared_ptr<ucx::Worker> worker,
+               std::shared_ptr<resources::PartitionResources> resources,
+               std::shared_ptr<RemoteDescriptorManager> remote_descriptors,
+               std::chrono::microseconds busy_poll_window) :
+  m_worker(std::move(worker)),
+  m_receive_buffers(BufferPool::create(context)),
+  m_remote_descriptors(std::move(remote_descriptors)),
+  m_busy_poll_window(busy_poll_window)
+{
+    CHECK(m_worker);
+    CHECK(m_remote_descriptors);
+}
 
 Server::~Server()
 {
@@ -95,10 +147,12 @@ Server::~Server()
 
 void Server::do_service_start()
 {
-    m_deserialize_source = std::make_shared<node::Router<PortAddress, memory::block>>();
+    m_deserialize_source = std::make_shared<node::Router<PortAddress, memory::blob>>();
     m_rd_source          = std::make_unique<node::SourceChannelWriteable<ucp_tag_t>>();
 
-    auto progress_engine = std::make_unique<DataPlaneServerWorker>(m_worker);
+    m_progress           = std::make_shared<ucx::AdaptiveProgress>(m_worker, m_busy_poll_window);
+    auto progress_engine = std::make_unique<DataPlaneServerWorker>(
+        m_worker, m_receive_buffers, m_remote_descriptors, m_progress);
     node::make_edge(*progress_engine, *m_deserialize_source);
 
     // all network runnables use the `srf_network` engine factory
@@ -117,11 +171,13 @@ void Server::do_service_await_live()
 void Server::do_service_stop()
 {
     m_progress_engine->stop();
+    m_progress->wakeup();
 }
 
 void Server::do_service_kill()
 {
     m_progress_engine->kill();
+    m_progress->wakeup();
 }
 
 void Server::do_service_await_join()
@@ -138,7 +194,7 @@ ucx::WorkerAddress Server::worker_address() const
     return m_worker->address();
 }
 
-node::Router<PortAddress, memory::block>& Server::deserialize_source()
+node::Router<PortAddress, memory::blob>& Server::deserialize_source()
 {
     CHECK(m_deserialize_source);
     return *m_deserialize_source;
@@ -146,16 +202,27 @@ node::Router<PortAddress, memory::block>& Server::deserialize_source()
 
 // NetworkEventProgressEngine
 
-DataPlaneServerWorker::DataPlaneServerWorker(Handle<ucx::Worker> worker) : m_worker(std::move(worker)) {}
+DataPlaneServerWorker::DataPlaneServerWorker(Handle<ucx::Worker> worker,
+                                             std::shared_ptr<BufferPool> receive_buffers,
+                                             std::shared_ptr<RemoteDescriptorManager> remote_descriptors,
+                                             std::shared_ptr<ucx::AdaptiveProgress> progress) :
+  m_worker(std::move(worker)),
+  m_receive_buffers(std::move(receive_buffers)),
+  m_remote_descriptors(std::move(remote_descriptors)),
+  m_progress(std::move(progress))
+{
+    CHECK(m_receive_buffers);
+    CHECK(m_remote_descriptors);
+    CHECK(m_progress);
+}
 
 void DataPlaneServerWorker::data_source(rxcpp::subscriber<network_event_t>& s)
 {
     ucp_tag_message_h msg;
     ucp_tag_recv_info_t msg_info;
-    std::uint32_t backoff = 1;
 
-    // set static variable for callbacks
-    static_subscriber = &s;
+    // busy poll while messages are flowing; once idle, suspend this fiber until the worker's event fd is readable
+    auto& progress = *m_progress;
 
     while (true)
     {
@@ -170,31 +237,14 @@ void DataPlaneServerWorker::data_source(rxcpp::subscriber<network_event_t>& s)
             {
                 break;
             }
-            while (m_worker->progress() != 0U)
-            {
-                backoff = 1;
-            }
-
-            boost::this_fiber::yield();
-
-            /*
-            if (backoff < 1048576)
-            {
-                backoff = backoff << 1;
-            }
-            if (backoff < 32768)
-            {
-                boost::this_fiber::yield();
-            }
-            else
+            if (!progress.progress())
             {
-                boost::this_fiber::sleep_for(std::chrono::nanoseconds(backoff));
+                progress.idle();
             }
-            */
         }
 
         on_tagged_msg(s, msg, msg_info);
-        backoff = 1;
+        progress.activity();
     }
 }
 
@@ -216,29 +266,29 @@ void DataPlaneServerWorker::on_tagged_msg(rxcpp::subscriber<network_event_t>& su
 
     switch (msg_type)
     {
-    case INGRESS_TAG: {
+    case INGRESS_TAG:
+    case FRAME_TAG: {
         params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |   // recv_completion_handler
                               UCP_OP_ATTR_FIELD_USER_DATA |  // user_data
                               UCP_OP_ATTR_FIELD_RECV_INFO |  // not sure if this is needed
                               UCP_OP_ATTR_FLAG_NO_IMM_CMPL;  // force the completion handler to be used
 
-        // todo(#139) - replace malloc with an unexpected receive / transactional memory_resource for
-        // ultra fast allocation
-        // in that work create a struct InFlightEncodedObject and allocate msg_info.length +
-        // sizeof(InFightEncodedObject) + alignment, and pass the starting pointer of that block to the user_data void*
-        // of the callback. Then unpack the struct and blob in the callback. The pointer to the subscriber is part of
-        // the InFlightEncodedObject which will remove the thread local storage pointer we are doing now.
+        // the completion state is placed in the context region of the pooled buffer and takes ownership of it
+        auto buffer     = m_receive_buffers->acquire(msg_info.length);
+        void* context   = buffer.context();
+        auto* in_flight = new (context) InFlightReceive{std::move(buffer), &subscriber};
 
         recv_bytes       = msg_info.length;
-        recv_addr        = std::malloc(recv_bytes);
-        params.user_data = recv_addr;
+        recv_addr        = in_flight->buffer.data();
+        params.user_data = in_flight;
         params.cb.recv   = recv_completion_handler;
         break;
     }
     case DESCRIPTOR_TAG:
-        // m_rd_source.await_write(msg_info.sender_tag);
-        // m_descriptors_channel->await_write(msg_info.sender_tag);
-        LOG(FATAL) << "remote descriptor not implemented";
+        // zero-byte event - the remote instance has pulled the memory of the remote descriptor with the object id
+        // encoded in the tag; the registration and owner are released here, the recv below only consumes the message;
+        // unknown object ids are logged and dropped by the manager
+        m_remote_descriptors->release(tag_decode_user_tag(msg_info.sender_tag));
         break;
 
     case FUTURE_TAG:
@@ -252,7 +302,7 @@ void DataPlaneServerWorker::on_tagged_msg(rxcpp::subscriber<network_event_t>& su
     void* status = ucp_tag_msg_recv_nbx(m_worker->handle(), recv_addr, recv_bytes, msg, &params);
     if (UCS_PTR_IS_ERR(status))
     {
-        LOG(FATAL) << "ucp_tag_msg_recv_nbx for 0-byte event failed";
+        LOG(FATAL) << "ucp_tag_msg_recv_nbx failed - " << ucs_status_string(UCS_PTR_STATUS(status));
     }
 }
 
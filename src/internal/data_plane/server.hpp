@@ -20,7 +20,7 @@
 #include "internal/service.hpp"
 
 #include <srf/channel/status.hpp>
-#include <srf/memory/block.hpp>
+#include <srf/memory/blob.hpp>
 #include <srf/node/generic_source.hpp>
 #include <srf/node/operators/router.hpp>
 #include <srf/node/source_channel.hpp>
@@ -28,15 +28,19 @@
 #include <srf/runnable/launch_control.hpp>
 #include <srf/runnable/runner.hpp>
 #include <srf/types.hpp>
+#include "internal/data_plane/buffer_pool.hpp"
+#include "internal/data_plane/remote_descriptor_manager.hpp"
 #include "internal/resources/partition_resources.hpp"
 #include "internal/ucx/common.hpp"
 #include "internal/ucx/context.hpp"
+#include "internal/ucx/progress.hpp"
 #include "internal/ucx/worker.hpp"
 
 #include <ucp/api/ucp_def.h>
 #include <rxcpp/rx-predef.hpp>
 #include <rxcpp/rx-subscriber.hpp>
 
+#include <chrono>
 #include <memory>
 #include <utility>
 
@@ -63,17 +67,22 @@
 
 namespace srf::internal::data_plane {
 
-using network_event_t = std::pair<PortAddress, memory::block>;
+// the blob owns a pooled receive buffer which is recycled when the last downstream reference is released
+using network_event_t = std::pair<PortAddress, memory::blob>;
 
 class Server final : public Service
 {
   public:
-    Server(std::shared_ptr<ucx::Context> context, std::shared_ptr<resources::PartitionResources> resources);
+    Server(std::shared_ptr<ucx::Context> context,
+           std::shared_ptr<ucx::Worker> worker,
+           std::shared_ptr<resources::PartitionResources> resources,
+           std::shared_ptr<RemoteDescriptorManager> remote_descriptors,
+           std::chrono::microseconds busy_poll_window = ucx::AdaptiveProgress::default_busy_poll_window);
     ~Server() final;
 
     ucx::WorkerAddress worker_address() const;
 
-    node::Router<PortAddress, memory::block>& deserialize_source();
+    node::Router<PortAddress, memory::blob>& deserialize_source();
 
   private:
     void do_service_start() final;
@@ -84,15 +93,27 @@ class Server final : public Service
 
     // deserialization nodes will connect to this source wtih their port id
     // the source for this router is the private GenericSoruce of this object
-    std::shared_ptr<node::Router<PortAddress, memory::block>> m_deserialize_source;
+    std::shared_ptr<node::Router<PortAddress, memory::blob>> m_deserialize_source;
 
     // the remote descriptor manager will connect to this source
     // data will be emitted on this source as a conditional branch of data source
     std::unique_ptr<node::SourceChannelWriteable<ucp_tag_t>> m_rd_source;
 
-    // ucx worker
+    // ucx worker of the partition; shared with the partition's Client
     Handle<ucx::Worker> m_worker;
 
+    // size-classed and ucx registered buffers for inbound messages
+    std::shared_ptr<BufferPool> m_receive_buffers;
+
+    // remote descriptors are released when a DESCRIPTOR_TAG event is received
+    std::shared_ptr<RemoteDescriptorManager> m_remote_descriptors;
+
+    // duration the progress engine busy polls after activity before waiting on the worker's event fd
+    std::chrono::microseconds m_busy_poll_window;
+
+    // idle strategy of the progress engine; shared so that stop and kill can resume it while it is suspended
+    std::shared_ptr<ucx::AdaptiveProgress> m_progress;
+
     // runner for the ucx progress engine event source
     std::unique_ptr<runnable::Runner> m_progress_engine;
 
@@ -102,7 +123,10 @@ class Server final : public Service
 class DataPlaneServerWorker final : public node::GenericSource<network_event_t>
 {
   public:
-    DataPlaneServerWorker(Handle<ucx::Worker> worker);
+    DataPlaneServerWorker(Handle<ucx::Worker> worker,
+                          std::shared_ptr<BufferPool> receive_buffers,
+                          std::shared_ptr<RemoteDescriptorManager> remote_descriptors,
+                          std::shared_ptr<ucx::AdaptiveProgress> progress);
 
   private:
     void data_source(rxcpp::subscriber<network_event_t>& s) final;
@@ -112,6 +136,9 @@ class DataPlaneServerWorker final : public node::GenericSource<network_event_t>
                        const ucp_tag_recv_info_t& msg_info);
 
     Handle<ucx::Worker> m_worker;
+    std::shared_ptr<BufferPool> m_receive_buffers;
+    std::shared_ptr<RemoteDescriptorManager> m_remote_descriptors;
+    std::shared_ptr<ucx::AdaptiveProgress> m_progress;
 
     // modify these to adjust the tag matching
     // 0/0 is the equivalent of match all tags
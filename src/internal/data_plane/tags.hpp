@@ -33,6 +33,7 @@ static constexpr ucp_tag_t MSG_TYPE_MASK  = 0xF000000000000000;  // leading 4 bi
 static constexpr ucp_tag_t INGRESS_TAG    = 0x8000000000000000;  // leading 4 bits are 1000  // NOLINT
 static constexpr ucp_tag_t DESCRIPTOR_TAG = 0x4000000000000000;  // leading 4 bits are 0100  // NOLINT
 static constexpr ucp_tag_t FUTURE_TAG     = 0x2000000000000000;  // leading 4 bits are 0010  // NOLINT
+static constexpr ucp_tag_t FRAME_TAG      = 0x1000000000000000;  // leading 4 bits are 0001  // NOLINT
 
 static constexpr ucp_tag_t USR_TYPE_MASK = 0x0000FFFFFFFFFFFF;  // 48-bits  // NOLINT
 
@@ -70,7 +71,7 @@ static std::tuple<ucp_tag_t, ucp_tag_t, std::uint8_t, std::uint32_t> tag_decode(
 // 0x8 = node id send/recv
 // 0x4 = obj id dec/[inc]
 // 0x2 = future / promise
-// 0x1 = unused
+// 0x1 = coalesced frame of node id send/recv
 
 // 0x08 = unused
 // 0x04 = unused
@@ -80,4 +81,4 @@ static std::tuple<ucp_tag_t, ucp_tag_t, std::uint8_t, std::uint32_t> tag_decode(
 // match any bit pattern
 
 // mask low bits - 60 out and check for power of two (v & v - 1) == 0
-// ensure only 1 of the first 3-6 high bits is set, currently only using 3
+// ensure only 1 of the first 3-6 high bits is set, currently using 4
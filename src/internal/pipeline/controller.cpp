@@ -110,14 +110,16 @@ void Controller::update(SegmentAddresses&& new_segments_map)
                         std::inserter(remove_segments, remove_segments.end()));
     DVLOG(10) << info() << remove_segments.size() << " segments marked for removal";
 
-    // construct new segments and attach to manifold
+    // construct new segments and attach to manifold; segments are constructed concurrently across partitions
+    SegmentAddresses segments_to_create;
     for (const auto& address : create_segments)
     {
         auto partition_id = new_segments_map.at(address);
         DVLOG(10) << info() << ": create segment for address " << ::srf::segment::info(address)
                   << " on resource partition: " << partition_id;
-        m_pipeline->create_segment(address, partition_id);
+        segments_to_create[address] = partition_id;
     }
+    m_pipeline->create_segments(segments_to_create);
 
     // detach from manifold or stop old segments
     for (const auto& address : remove_segments)
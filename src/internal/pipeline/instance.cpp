@@ -19,6 +19,7 @@
 
 #include "internal/pipeline/pipeline.hpp"
 #include "internal/pipeline/resources.hpp"
+#include "internal/pipeline/types.hpp"
 #include "internal/resources/host_resources.hpp"
 #include "internal/resources/partition_resources.hpp"
 #include "internal/segment/definition.hpp"
@@ -34,6 +35,9 @@
 #include <boost/fiber/future/future.hpp>
 
 #include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -52,15 +56,66 @@ Instance::Instance(std::shared_ptr<const Pipeline> definition,
 
 void Instance::update()
 {
+    // partitions of the upstream and downstream segments of each port
+    std::map<PortName, std::vector<std::size_t>> upstream_partitions;
+    std::map<PortName, std::vector<std::size_t>> downstream_partitions;
+    for (const auto& [address, segment] : m_segments)
+    {
+        auto definition = m_definition->find_segment(segment->id());
+        for (const auto& name : definition->egress_port_names())
+        {
+            upstream_partitions[name].push_back(segment->partition_id());
+        }
+        for (const auto& name : definition->ingress_port_names())
+        {
+            downstream_partitions[name].push_back(segment->partition_id());
+        }
+    }
+
     for (const auto& [name, manifold] : m_manifolds)
     {
+        // a single upstream and a single downstream segment on the same partition are bound directly
+        const auto& upstream   = upstream_partitions[name];
+        const auto& downstream = downstream_partitions[name];
+        manifold->permit_direct_binding(upstream.size() == 1 && downstream.size() == 1 &&
+                                        upstream.front() == downstream.front());
+
         manifold->update_inputs();
         manifold->update_outputs();
         manifold->start();
     }
+
+    // start the segments concurrently on their respective partitions, then jointly await on all to become live
+    std::vector<Future<void>> starts;
+    for (const auto& [address, segment] : m_segments)
+    {
+        auto* instance = segment.get();
+        starts.push_back(
+            partition(instance->partition_id()).host().main().enqueue([instance] { instance->service_start(); }));
+    }
+
+    std::exception_ptr first_exception = nullptr;
+    for (auto& start : starts)
+    {
+        try
+        {
+            start.get();
+        } catch (...)
+        {
+            if (first_exception == nullptr)
+            {
+                first_exception = std::current_exception();
+            }
+        }
+    }
+    if (first_exception)
+    {
+        LOG(ERROR) << "pipeline::Instance - an exception was caught while starting segments - rethrowing";
+        std::rethrow_exception(std::move(first_exception));
+    }
+
     for (const auto& [address, segment] : m_segments)
     {
-        segment->service_start();
         segment->service_await_live();
     }
     mark_joinable();
@@ -97,51 +152,74 @@ void Instance::stop_segment(const SegmentAddress& address)
     search->second->service_stop();
 }
 
-void Instance::create_segment(const SegmentAddress& address, std::uint32_t partition_id)
+void Instance::create_segments(const SegmentAddresses& segments)
 {
-    // perform our allocations on the numa domain of the intended target
-    // CHECK_LT(partition_id, m_resources->host_resources().size());
-    CHECK_LT(partition_id, resources().partitions());
-    partition(partition_id)
-        .host()
-        .main()
-        .enqueue([this, address, partition_id] {
-            auto search = m_segments.find(address);
-            CHECK(search == m_segments.end());
-
-            auto [id, rank] = segment_address_decode(address);
-            auto definition = m_definition->find_segment(id);
-            auto segment    = std::make_unique<segment::Instance>(definition, rank, *this, partition_id);
-
-            for (const auto& name : definition->egress_port_names())
+    std::vector<std::pair<SegmentAddress, Future<std::unique_ptr<segment::Instance>>>> constructions;
+
+    for (const auto& [segment_address, segment_partition_id] : segments)
+    {
+        // perform our allocations on the numa domain of the intended target
+        CHECK_LT(segment_partition_id, resources().partitions());
+        CHECK(m_segments.find(segment_address) == m_segments.end());
+
+        auto address      = segment_address;
+        auto partition_id = segment_partition_id;
+
+        constructions.emplace_back(
+            address, partition(partition_id).host().main().enqueue([this, address, partition_id] {
+                auto [id, rank] = segment_address_decode(address);
+                auto definition = m_definition->find_segment(id);
+                return std::make_unique<segment::Instance>(definition, rank, *this, partition_id);
+            }));
+    }
+
+    // await every construction before rethrowing so no task outlives this call
+    std::exception_ptr first_exception = nullptr;
+    for (auto& [address, construction] : constructions)
+    {
+        try
+        {
+            m_segments[address] = construction.get();
+        } catch (...)
+        {
+            if (first_exception == nullptr)
             {
-                VLOG(10) << ::srf::segment::info(address) << " configuring manifold for egress port " << name;
-                std::shared_ptr<manifold::Interface> manifold = get_manifold(name);
-                if (!manifold)
-                {
-                    VLOG(10) << ::srf::segment::info(address) << " creating manifold for egress port " << name;
-                    manifold          = segment->create_manifold(name);
-                    m_manifolds[name] = manifold;
-                }
-                segment->attach_manifold(manifold);
+                first_exception = std::current_exception();
             }
+        }
+    }
+    if (first_exception)
+    {
+        LOG(ERROR) << "pipeline::Instance - an exception was caught while constructing segments - rethrowing";
+        std::rethrow_exception(std::move(first_exception));
+    }
 
-            for (const auto& name : definition->ingress_port_names())
-            {
-                VLOG(10) << ::srf::segment::info(address) << " configuring manifold for ingress port " << name;
-                std::shared_ptr<manifold::Interface> manifold = get_manifold(name);
-                if (!manifold)
+    // attaching a segment to a manifold enqueues updates on the manifold which are not thread safe and manifolds are
+    // shared by every segment with the same port; attach one segment at a time, each on its own partition
+    for (const auto& [address, construction] : constructions)
+    {
+        auto* segment = m_segments.at(address).get();
+        partition(segment->partition_id())
+            .host()
+            .main()
+            .enqueue([this, address = address, segment] {
+                auto [id, rank] = segment_address_decode(address);
+                auto definition = m_definition->find_segment(id);
+
+                for (const auto& name : definition->egress_port_names())
                 {
-                    VLOG(10) << ::srf::segment::info(address) << " creating manifold for ingress port " << name;
-                    manifold          = segment->create_manifold(name);
-                    m_manifolds[name] = manifold;
+                    VLOG(10) << ::srf::segment::info(address) << " configuring manifold for egress port " << name;
+                    segment->attach_manifold(get_or_create_manifold(name, *segment));
                 }
-                segment->attach_manifold(manifold);
-            }
 
-            m_segments[address] = std::move(segment);
-        })
-        .get();
+                for (const auto& name : definition->ingress_port_names())
+                {
+                    VLOG(10) << ::srf::segment::info(address) << " configuring manifold for ingress port " << name;
+                    segment->attach_manifold(get_or_create_manifold(name, *segment));
+                }
+            })
+            .get();
+    }
 }
 
 manifold::Interface& Instance::manifold(const PortName& port_name)
@@ -153,6 +231,7 @@ manifold::Interface& Instance::manifold(const PortName& port_name)
 
 std::shared_ptr<manifold::Interface> Instance::get_manifold(const PortName& port_name)
 {
+    std::lock_guard<decltype(m_manifolds_mutex)> lock(m_manifolds_mutex);
     auto search = m_manifolds.find(port_name);
     if (search == m_manifolds.end())
     {
@@ -162,6 +241,22 @@ std::shared_ptr<manifold::Interface> Instance::get_manifold(const PortName& port
     return m_manifolds.at(port_name);
 }
 
+std::shared_ptr<manifold::Interface> Instance::get_or_create_manifold(const PortName& port_name,
+                                                                      segment::Instance& segment)
+{
+    std::lock_guard<decltype(m_manifolds_mutex)> lock(m_manifolds_mutex);
+    auto search = m_manifolds.find(port_name);
+    if (search != m_manifolds.end())
+    {
+        return search->second;
+    }
+
+    VLOG(10) << ::srf::segment::info(segment.address()) << " creating manifold for port " << port_name;
+    auto manifold          = segment.create_manifold(port_name);
+    m_manifolds[port_name] = manifold;
+    return manifold;
+}
+
 void Instance::mark_joinable()
 {
     if (!m_joinable)
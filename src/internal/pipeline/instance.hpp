@@ -19,6 +19,7 @@
 
 #include "internal/pipeline/pipeline.hpp"
 #include "internal/pipeline/resources.hpp"
+#include "internal/pipeline/types.hpp"
 #include "internal/resources/resource_partitions.hpp"
 #include "internal/segment/instance.hpp"
 #include "internal/service.hpp"
@@ -29,6 +30,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 
 namespace srf::internal::pipeline {
 
@@ -37,11 +39,15 @@ class Instance final : public Service, public Resources
   public:
     Instance(std::shared_ptr<const Pipeline> definition, std::shared_ptr<resources::ResourcePartitions> resources);
 
-    // currently we are passing the instance back to the executor
-    // we should own the instance here in the pipeline instance
-    // we need to stage those object that are created into some struct/container so we can mass start them after all
-    // object have been created
-    void create_segment(const SegmentAddress& address, std::uint32_t partition_id);
+    /**
+     * @brief Construct segments and attach them to their manifolds
+     *
+     * Each segment is constructed on the main task queue of its resource partition; segments on different partitions
+     * are constructed concurrently with a single joint await on all of them. Manifolds are shared across segments and
+     * are not thread safe, so the constructed segments are then attached to their manifolds one at a time, each still
+     * on its own partition. The segments are started by update().
+     */
+    void create_segments(const SegmentAddresses& segments);
     void stop_segment(const SegmentAddress& address);
     void join_segment(const SegmentAddress& address);
     void remove_segment(const SegmentAddress& address);
@@ -53,6 +59,8 @@ class Instance final : public Service, public Resources
      * pipeline instance have been started. Any Segment that natually shutdowns down is still owned by the Pipeline
      * Instance until the configuration manager explicitly tells the Pipeline Instace to remove it.
      *
+     * Segments are started concurrently, each on the main task queue of its resource partition; the call returns once
+     * every segment is live.
      */
     void update();
 
@@ -68,11 +76,17 @@ class Instance final : public Service, public Resources
     manifold::Interface& manifold(const PortName& port_name);
     std::shared_ptr<manifold::Interface> get_manifold(const PortName& port_name);
 
+    // get the manifold for port_name or create it from the segment; safe to call concurrently
+    std::shared_ptr<manifold::Interface> get_or_create_manifold(const PortName& port_name, segment::Instance& segment);
+
     std::shared_ptr<const Pipeline> m_definition;  // convert to pipeline::Pipeline
 
     std::map<SegmentAddress, std::unique_ptr<segment::Instance>> m_segments;
     std::map<PortName, std::shared_ptr<manifold::Interface>> m_manifolds;
 
+    // guards m_manifolds while segments are constructed concurrently
+    std::mutex m_manifolds_mutex;
+
     bool m_joinable{false};
     Promise<void> m_joinable_promise;
     SharedFuture<void> m_joinable_future;
@@ -20,6 +20,7 @@
 #include "internal/runnable/fiber_engines.hpp"
 #include "internal/runnable/thread_engines.hpp"
 #include "internal/system/fiber_pool.hpp"
+#include "internal/system/pinned_thread_pool.hpp"
 #include "internal/system/system.hpp"
 #include "srf/constants.hpp"
 #include "srf/core/task_queue.hpp"
@@ -142,7 +143,8 @@ class ThreadEngineFactory : public ::srf::runnable::EngineFactory
   public:
     ThreadEngineFactory(std::shared_ptr<system::System> system, CpuSet cpu_set) :
       m_system(std::move(system)),
-      m_cpu_set(std::move(cpu_set))
+      m_cpu_set(std::move(cpu_set)),
+      m_pool(std::make_shared<system::PinnedThreadPool>(m_system))
     {
         CHECK(!m_cpu_set.empty());
         CHECK(m_system);
@@ -151,7 +153,7 @@ class ThreadEngineFactory : public ::srf::runnable::EngineFactory
     std::shared_ptr<::srf::runnable::Engines> build_engines(const LaunchOptions& launch_options) final
     {
         auto cpu_set = get_next_n_cpus(launch_options.pe_count);
-        return std::make_shared<ThreadEngines>(launch_options, std::move(cpu_set), m_system);
+        return std::make_shared<ThreadEngines>(launch_options, std::move(cpu_set), m_pool);
     }
 
   protected:
@@ -170,6 +172,7 @@ class ThreadEngineFactory : public ::srf::runnable::EngineFactory
 
     CpuSet m_cpu_set;
     std::shared_ptr<system::System> m_system;
+    std::shared_ptr<system::PinnedThreadPool> m_pool;
 };
 
 /**
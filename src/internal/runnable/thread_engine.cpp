@@ -17,8 +17,9 @@
 
 #include "internal/runnable/thread_engine.hpp"
 
-#include "internal/system/system.hpp"
+#include "internal/system/pinned_thread_pool.hpp"
 
+#include <glog/logging.h>
 #include <boost/fiber/future/future.hpp>
 #include <boost/fiber/future/packaged_task.hpp>
 
@@ -27,26 +28,29 @@
 
 namespace srf::internal::runnable {
 
-ThreadEngine::ThreadEngine(CpuSet cpu_set, std::shared_ptr<system::System> system) :
+ThreadEngine::ThreadEngine(CpuSet cpu_set, std::shared_ptr<system::PinnedThreadPool> pool) :
   m_cpu_set(std::move(cpu_set)),
-  m_system(std::move(system))
-{}
-
-ThreadEngine::~ThreadEngine()
+  m_pool(std::move(pool))
 {
-    m_thread->join();
+    CHECK(m_pool);
 }
 
-std::thread::id ThreadEngine::get_id() const
+ThreadEngine::~ThreadEngine()
 {
-    return m_thread->get_id();
+    if (m_completed.valid())
+    {
+        m_completed.wait();
+    }
 }
 
 Future<void> ThreadEngine::do_launch_task(std::function<void()> task)
 {
     boost::fibers::packaged_task<void()> pkg_task(std::move(task));
     auto future = pkg_task.get_future();
-    m_thread    = std::make_unique<std::thread>(m_system->make_thread("thread_engine", m_cpu_set, std::move(pkg_task)));
+
+    std::packaged_task<void()> pooled_task([t = std::move(pkg_task)]() mutable { t(); });
+    m_completed = pooled_task.get_future();
+    m_pool->launch(m_cpu_set, std::move(pooled_task));
     return std::move(future);
 }
 
@@ -26,28 +26,31 @@
 #include "srf/types.hpp"
 
 #include <functional>
+#include <future>
 #include <memory>
-#include <thread>
 
 namespace srf::internal::runnable {
 
+/**
+ * @brief Engine which runs its task on a dedicated thread pinned to cpu_set; the thread is acquired from, and returned
+ * to, a PinnedThreadPool so threads are reused across launches
+ */
 class ThreadEngine final : public Engine
 {
   public:
-    explicit ThreadEngine(CpuSet cpu_set, std::shared_ptr<system::System> system);
+    explicit ThreadEngine(CpuSet cpu_set, std::shared_ptr<system::PinnedThreadPool> pool);
     ~ThreadEngine() final;
 
     EngineType engine_type() const final;
 
-  protected:
-    std::thread::id get_id() const;
-
   private:
     Future<void> do_launch_task(std::function<void()> task) final;
 
     CpuSet m_cpu_set;
-    std::shared_ptr<system::System> m_system;
-    std::unique_ptr<std::thread> m_thread{nullptr};
+    std::shared_ptr<system::PinnedThreadPool> m_pool;
+
+    // completed when the task has finished and its thread has been released
+    std::future<void> m_completed;
 };
 
 }  // namespace srf::internal::runnable
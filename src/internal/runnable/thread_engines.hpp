@@ -19,6 +19,7 @@
 
 #include "internal/runnable/engines.hpp"
 
+#include "internal/system/pinned_thread_pool.hpp"
 #include "internal/system/system.hpp"
 
 #include "srf/core/bitmap.hpp"
@@ -35,6 +36,7 @@ class ThreadEngines final : public Engines
   public:
     ThreadEngines(CpuSet cpu_set, std::shared_ptr<system::System> system);
     ThreadEngines(LaunchOptions launch_options, CpuSet cpu_set, std::shared_ptr<system::System> system);
+    ThreadEngines(LaunchOptions launch_options, CpuSet cpu_set, std::shared_ptr<system::PinnedThreadPool> pool);
     ~ThreadEngines() final = default;
 
     EngineType engine_type() const final;
@@ -43,7 +45,7 @@ class ThreadEngines final : public Engines
     void initialize_launchers();
 
     CpuSet m_cpu_set;
-    Handle<system::System> m_system;
+    Handle<system::PinnedThreadPool> m_pool;
 };
 
 }  // namespace srf::internal::runnable
@@ -29,6 +29,7 @@
 #include <srf/core/task_queue.hpp>
 #include <srf/exceptions/runtime_error.hpp>
 #include <srf/manifold/interface.hpp>
+#include <srf/metrics/counter.hpp>
 #include <srf/runnable/launchable.hpp>
 #include <srf/runnable/launcher.hpp>
 #include <srf/runnable/runner.hpp>
@@ -90,6 +91,11 @@ const SegmentAddress& Instance::address() const
     return m_address;
 }
 
+std::size_t Instance::partition_id() const
+{
+    return m_default_partition_id;
+}
+
 void Instance::do_service_start()
 {
     // prepare launchers from m_builder
@@ -99,6 +105,8 @@ void Instance::do_service_start()
 
     auto apply_callback = [this](std::unique_ptr<runnable::Launcher>& launcher, std::string name) {
         launcher->apply([this, n = std::move(name)](runnable::Runner& runner) {
+            auto counter = m_resources.metrics_registry().make_forced_yield_counter(n);
+            runner.on_forced_yield_callback([counter]() mutable { counter.increment(); });
             runner.on_completion_callback([this, n](bool ok) {
                 if (!ok)
                 {
@@ -48,6 +48,9 @@ class Instance final : public Service
     const SegmentRank& rank() const;
     const SegmentAddress& address() const;
 
+    // resource partition on which the segment was constructed and its nodes are launched
+    std::size_t partition_id() const;
+
     std::shared_ptr<manifold::Interface> create_manifold(const PortName& name);
     void attach_manifold(std::shared_ptr<manifold::Interface> manifold);
 
@@ -0,0 +1,653 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/shm/channel.hpp"
+
+#include "internal/shm/ring.hpp"
+#include "internal/shm/shared_region.hpp"
+
+#include <srf/protos/codable.pb.h>
+#include <srf/codable/encoded_object.hpp>
+#include <srf/memory/blob.hpp>
+#include <srf/memory/block.hpp>
+#include <srf/types.hpp>
+
+#include <boost/fiber/operations.hpp>
+#include <glog/logging.h>
+
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+namespace srf::internal::shm {
+
+namespace {
+
+constexpr std::uint64_t channel_magic = 0x73726673686d0001;  // NOLINT
+constexpr std::size_t section_alignment = 64;                // NOLINT
+constexpr std::size_t slot_alignment    = 4096;              // NOLINT
+constexpr std::size_t block_alignment   = 8;                 // NOLINT
+
+struct alignas(section_alignment) ChannelHeader
+{
+    std::uint64_t magic;
+    std::uint64_t slot_bytes;
+    std::uint64_t slot_count;
+};
+
+constexpr std::size_t align_up(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+std::size_t ring_capacity(std::size_t slot_count)
+{
+    // a slot is referenced by at most one record in either ring, so neither ring can fill
+    std::size_t capacity = 1;
+    while (capacity < slot_count)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+struct Layout
+{
+    Layout(std::size_t slot_bytes, std::size_t slot_count) :
+      slot_bytes(align_up(slot_bytes, section_alignment)),
+      slot_count(slot_count),
+      capacity(ring_capacity(slot_count))
+    {
+        messages_offset = align_up(sizeof(ChannelHeader), section_alignment);
+        releases_offset =
+            align_up(messages_offset + RecordRing<Record>::required_bytes(capacity), section_alignment);
+        slots_offset =
+            align_up(releases_offset + RecordRing<std::uint64_t>::required_bytes(capacity), slot_alignment);
+        total_bytes = slots_offset + this->slot_bytes * slot_count;
+    }
+
+    std::size_t slot_bytes;
+    std::size_t slot_count;
+    std::size_t capacity;
+    std::size_t messages_offset;
+    std::size_t releases_offset;
+    std::size_t slots_offset;
+    std::size_t total_bytes;
+};
+
+int make_eventfd()
+{
+    int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0)
+    {
+        LOG(ERROR) << "eventfd failed: " << std::strerror(errno);
+        throw std::runtime_error("eventfd failed");
+    }
+    return fd;
+}
+
+std::byte* offset_ptr(const SharedRegion& region, std::size_t offset)
+{
+    return static_cast<std::byte*>(region.data()) + offset;
+}
+
+sockaddr_un make_address(const std::string& socket_path)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    CHECK_LT(socket_path.size(), sizeof(address.sun_path)) << "unix socket path too long: " << socket_path;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+
+}  // namespace
+
+// Buffer
+
+Buffer::Buffer(Sender* sender, std::uint32_t slot, void* data, std::size_t bytes) :
+  m_sender(sender),
+  m_slot(slot),
+  m_data(data),
+  m_bytes(bytes)
+{}
+
+Buffer::~Buffer()
+{
+    if (m_sender != nullptr)
+    {
+        m_sender->release(m_slot);
+    }
+}
+
+Buffer::Buffer(Buffer&& other) noexcept :
+  m_sender(std::exchange(other.m_sender, nullptr)),
+  m_slot(other.m_slot),
+  m_data(std::exchange(other.m_data, nullptr)),
+  m_bytes(std::exchange(other.m_bytes, 0))
+{}
+
+Buffer& Buffer::operator=(Buffer&& other) noexcept
+{
+    if (m_sender != nullptr)
+    {
+        m_sender->release(m_slot);
+    }
+    m_sender = std::exchange(other.m_sender, nullptr);
+    m_slot   = other.m_slot;
+    m_data   = std::exchange(other.m_data, nullptr);
+    m_bytes  = std::exchange(other.m_bytes, 0);
+    return *this;
+}
+
+void* Buffer::data() const
+{
+    return m_data;
+}
+
+std::size_t Buffer::bytes() const
+{
+    return m_bytes;
+}
+
+Buffer::operator bool() const
+{
+    return m_sender != nullptr;
+}
+
+// Sender
+
+Sender::Sender(ChannelOptions options) : m_options(options)
+{
+    CHECK_GT(m_options.slot_bytes, 0);
+    CHECK_GT(m_options.slot_count, 0);
+    CHECK_LE(m_options.slot_count, std::numeric_limits<std::uint32_t>::max());
+
+    Layout layout(m_options.slot_bytes, m_options.slot_count);
+    m_options.slot_bytes = layout.slot_bytes;
+
+    m_region      = SharedRegion::create(layout.total_bytes, "srf_shm_channel");
+    m_data_efd    = make_eventfd();
+    m_release_efd = make_eventfd();
+
+    auto* header       = new (m_region->data()) ChannelHeader();
+    header->slot_bytes = layout.slot_bytes;
+    header->slot_count = layout.slot_count;
+
+    m_messages = std::make_unique<RecordRing<Record>>(
+        offset_ptr(*m_region, layout.messages_offset), layout.capacity, m_data_efd, true);
+    m_releases = std::make_unique<RecordRing<std::uint64_t>>(
+        offset_ptr(*m_region, layout.releases_offset), layout.capacity, m_release_efd, true);
+    m_slots = offset_ptr(*m_region, layout.slots_offset);
+
+    m_free_slots.reserve(layout.slot_count);
+    for (std::size_t i = layout.slot_count; i > 0; i--)
+    {
+        m_free_slots.push_back(i - 1);
+    }
+
+    // a receiver can only attach once the fds have been passed to it, after construction has completed
+    header->magic = channel_magic;
+}
+
+Sender::~Sender()
+{
+    ::close(m_data_efd);
+    ::close(m_release_efd);
+}
+
+ChannelFds Sender::fds() const
+{
+    return ChannelFds{m_region->fd(), m_data_efd, m_release_efd};
+}
+
+void Sender::export_fds(const std::string& socket_path) const
+{
+    int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0)
+    {
+        LOG(ERROR) << "socket failed: " << std::strerror(errno);
+        throw std::runtime_error("socket failed");
+    }
+
+    auto address = make_address(socket_path);
+    ::unlink(socket_path.c_str());
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, 1) != 0)
+    {
+        LOG(ERROR) << "unable to listen on " << socket_path << ": " << std::strerror(errno);
+        ::close(listener);
+        throw std::runtime_error("unable to listen on unix socket");
+    }
+
+    int connection = ::accept(listener, nullptr, nullptr);
+    ::close(listener);
+    ::unlink(socket_path.c_str());
+    if (connection < 0)
+    {
+        LOG(ERROR) << "accept on " << socket_path << " failed: " << std::strerror(errno);
+        throw std::runtime_error("accept failed");
+    }
+
+    send_fds(connection, fds());
+    ::close(connection);
+}
+
+Buffer Sender::acquire(std::size_t bytes)
+{
+    auto start   = std::chrono::steady_clock::now();
+    auto backoff = min_acquire_backoff;
+    while (true)
+    {
+        auto buffer = try_acquire(bytes);
+        if (buffer)
+        {
+            return std::move(*buffer);
+        }
+
+        // every slot is held by the receiver; busy poll briefly, then suspend only the calling fiber between polls of
+        // the release ring so other fibers on this thread keep running and no lock is held while waiting
+        if (std::chrono::steady_clock::now() - start < Receiver::busy_poll_window)
+        {
+            boost::this_fiber::yield();
+            continue;
+        }
+        boost::this_fiber::sleep_for(backoff);
+        backoff = std::min(backoff * 2, max_acquire_backoff);
+    }
+}
+
+std::optional<Buffer> Sender::try_acquire(std::size_t bytes)
+{
+    if (bytes > m_options.slot_bytes)
+    {
+        LOG(ERROR) << "payload of " << bytes << " bytes exceeds the shared memory slot size of "
+                   << m_options.slot_bytes;
+        throw std::length_error("payload exceeds shared memory slot size");
+    }
+
+    std::lock_guard<Mutex> lock(m_mutex);
+    if (m_free_slots.empty())
+    {
+        reclaim();
+        if (m_free_slots.empty())
+        {
+            return std::nullopt;
+        }
+    }
+
+    auto slot = m_free_slots.back();
+    m_free_slots.pop_back();
+    return Buffer(this, slot, m_slots + slot * m_options.slot_bytes, bytes);
+}
+
+void Sender::send(PortAddress port_address, Buffer&& buffer)
+{
+    CHECK(buffer);
+    CHECK(buffer.m_sender == this);
+
+    push(Record{port_address, buffer.m_slot, RecordKind::Block, 0, buffer.bytes()});
+
+    // ownership of the slot has passed to the receiver
+    buffer.m_sender = nullptr;
+}
+
+void Sender::send(PortAddress port_address, memory::const_block block)
+{
+    auto buffer = acquire(block.bytes());
+    std::memcpy(buffer.data(), block.data(), block.bytes());
+    send(port_address, std::move(buffer));
+}
+
+void Sender::send(PortAddress port_address, const codable::protos::EncodedObject& encoded_object)
+{
+    // lay out the memory blocks at the start of the slot and rewrite their descriptors to slot offsets
+    auto proto = encoded_object;
+    std::vector<std::pair<const void*, std::size_t>> copies;
+    std::size_t offset = 0;
+    for (auto& desc : *proto.mutable_descriptors())
+    {
+        if (!desc.has_remote_desc())
+        {
+            continue;
+        }
+        auto& remote_desc = *desc.mutable_remote_desc();
+        auto kind         = remote_desc.memory_kind();
+        CHECK(kind == codable::protos::MemoryKind::Host || kind == codable::protos::MemoryKind::Pinned)
+            << "shared memory channels only carry host memory";
+
+        copies.emplace_back(reinterpret_cast<const void*>(remote_desc.remote_address()), remote_desc.remote_bytes());
+        remote_desc.set_remote_address(offset);
+        remote_desc.clear_remote_key();
+        offset = align_up(offset + remote_desc.remote_bytes(), block_alignment);
+    }
+
+    auto proto_offset = offset;
+    auto proto_bytes  = proto.ByteSizeLong();
+    auto buffer       = acquire(proto_offset + proto_bytes);
+
+    auto* data = static_cast<std::byte*>(buffer.data());
+    offset     = 0;
+    for (const auto& [src, bytes] : copies)
+    {
+        std::memcpy(data + offset, src, bytes);
+        offset = align_up(offset + bytes, block_alignment);
+    }
+    CHECK(proto.SerializeToArray(data + proto_offset, proto_bytes));
+
+    push(Record{port_address, buffer.m_slot, RecordKind::EncodedObject, proto_offset, proto_bytes});
+    buffer.m_sender = nullptr;
+}
+
+void Sender::send(PortAddress port_address, const codable::EncodedObject& encoded_object)
+{
+    send(port_address, encoded_object.proto());
+}
+
+std::size_t Sender::slot_bytes() const
+{
+    return m_options.slot_bytes;
+}
+
+std::size_t Sender::free_slots()
+{
+    std::lock_guard<Mutex> lock(m_mutex);
+    reclaim();
+    return m_free_slots.size();
+}
+
+void Sender::reclaim()
+{
+    std::uint64_t slot;
+    while (m_releases->try_pop(slot))
+    {
+        // released slot ids are written by the peer; an out of range id is dropped rather than handed out
+        if (slot >= m_options.slot_count)
+        {
+            LOG(ERROR) << "dropping release of invalid shared memory slot " << slot << " of " << m_options.slot_count;
+            continue;
+        }
+        m_free_slots.push_back(slot);
+    }
+}
+
+void Sender::push(const Record& record)
+{
+    std::lock_guard<Mutex> lock(m_mutex);
+
+    // the message ring holds at least as many records as there are slots
+    CHECK(m_messages->try_push(record));
+}
+
+void Sender::release(std::uint32_t slot)
+{
+    std::lock_guard<Mutex> lock(m_mutex);
+    m_free_slots.push_back(slot);
+}
+
+// Receiver
+
+struct Receiver::State
+{
+    State(ChannelFds fds) : region(SharedRegion::attach(fds.region)), release_efd(fds.release_efd) {}
+
+    ~State()
+    {
+        ::close(release_efd);
+    }
+
+    void release(std::uint64_t slot)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        CHECK(releases->try_push(slot));
+    }
+
+    std::shared_ptr<SharedRegion> region;
+    int release_efd;
+    std::unique_ptr<RecordRing<std::uint64_t>> releases;
+    std::mutex mutex;
+};
+
+Receiver::Receiver(ChannelFds fds) : m_state(std::make_shared<State>(fds)), m_data_efd(fds.data_efd)
+{
+    const auto& region = *m_state->region;
+    CHECK_GE(region.bytes(), sizeof(ChannelHeader));
+
+    const auto* header = static_cast<const ChannelHeader*>(region.data());
+    if (header->magic != channel_magic)
+    {
+        LOG(ERROR) << "shared region is not an initialized srf shared memory channel";
+        throw std::runtime_error("invalid shared memory channel");
+    }
+
+    Layout layout(header->slot_bytes, header->slot_count);
+    CHECK_EQ(layout.slot_bytes, header->slot_bytes);
+    CHECK_LE(layout.total_bytes, region.bytes());
+
+    m_messages = std::make_unique<RecordRing<Record>>(
+        offset_ptr(region, layout.messages_offset), layout.capacity, m_data_efd, false);
+    m_state->releases = std::make_unique<RecordRing<std::uint64_t>>(
+        offset_ptr(region, layout.releases_offset), layout.capacity, m_state->release_efd, false);
+    m_slots      = offset_ptr(region, layout.slots_offset);
+    m_slot_bytes = layout.slot_bytes;
+    m_slot_count = layout.slot_count;
+}
+
+Receiver::~Receiver()
+{
+    ::close(m_data_efd);
+}
+
+std::unique_ptr<Receiver> Receiver::connect(const std::string& socket_path)
+{
+    int connection = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (connection < 0)
+    {
+        LOG(ERROR) << "socket failed: " << std::strerror(errno);
+        throw std::runtime_error("socket failed");
+    }
+
+    auto address = make_address(socket_path);
+    if (::connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        LOG(ERROR) << "unable to connect to " << socket_path << ": " << std::strerror(errno);
+        ::close(connection);
+        throw std::runtime_error("unable to connect to unix socket");
+    }
+
+    auto fds = receive_fds(connection);
+    ::close(connection);
+    return std::make_unique<Receiver>(fds);
+}
+
+std::optional<Message> Receiver::try_receive()
+{
+    if (m_failed)
+    {
+        LOG(ERROR) << "shared memory channel previously received a corrupt record";
+        throw std::runtime_error("shared memory channel failed");
+    }
+
+    Record record;
+    if (!m_messages->try_pop(record))
+    {
+        return std::nullopt;
+    }
+
+    // the record was written by the peer; bounds are compared without sums so corrupt values cannot overflow
+    auto valid_kind = record.kind == RecordKind::Block || record.kind == RecordKind::EncodedObject;
+    if (record.slot >= m_slot_count || record.bytes > m_slot_bytes || record.offset > m_slot_bytes - record.bytes ||
+        !valid_kind)
+    {
+        m_failed = true;
+        LOG(ERROR) << "corrupt shared memory channel record; slot: " << record.slot << " of " << m_slot_count
+                   << "; offset: " << record.offset << "; bytes: " << record.bytes
+                   << "; slot_bytes: " << m_slot_bytes;
+        throw std::runtime_error("corrupt shared memory channel record");
+    }
+
+    auto* slot = m_slots + static_cast<std::size_t>(record.slot) * m_slot_bytes;
+
+    // the slot is returned to the sender when the last reference to the payload is released
+    auto state = m_state;
+    auto slot_id = record.slot;
+    std::shared_ptr<void> lease(slot, [state, slot_id](void*) { state->release(slot_id); });
+
+    Message message;
+    message.port_address = record.port_address;
+    message.kind         = record.kind;
+    if (record.kind == RecordKind::EncodedObject)
+    {
+        message.payload      = memory::blob(SlotView{std::move(lease), slot, record.offset + record.bytes});
+        message.proto_offset = record.offset;
+    }
+    else
+    {
+        message.payload = memory::blob(SlotView{std::move(lease), slot + record.offset, record.bytes});
+    }
+    return message;
+}
+
+std::optional<Message> Receiver::await_receive(std::chrono::milliseconds timeout)
+{
+    auto start   = std::chrono::steady_clock::now();
+    auto backoff = std::chrono::duration_cast<std::chrono::steady_clock::duration>(min_receive_backoff);
+    while (true)
+    {
+        auto message = try_receive();
+        if (message)
+        {
+            return message;
+        }
+
+        // busy poll briefly, then suspend only the calling fiber between polls of the message ring so other fibers on
+        // this thread keep running
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed < busy_poll_window)
+        {
+            boost::this_fiber::yield();
+            continue;
+        }
+        if (elapsed >= timeout)
+        {
+            return std::nullopt;
+        }
+        boost::this_fiber::sleep_for(std::min<std::chrono::steady_clock::duration>(backoff, timeout - elapsed));
+        backoff = std::min<std::chrono::steady_clock::duration>(backoff * 2, max_receive_backoff);
+    }
+}
+
+codable::protos::EncodedObject decode(const Message& message)
+{
+    CHECK(message.kind == RecordKind::EncodedObject);
+    CHECK_LE(message.proto_offset, message.payload.bytes());
+
+    const auto* base = static_cast<const std::byte*>(message.payload.data());
+
+    codable::protos::EncodedObject proto;
+    CHECK(proto.ParseFromArray(base + message.proto_offset, message.payload.bytes() - message.proto_offset));
+
+    for (auto& desc : *proto.mutable_descriptors())
+    {
+        if (!desc.has_remote_desc())
+        {
+            continue;
+        }
+        auto& remote_desc = *desc.mutable_remote_desc();
+        CHECK_LE(remote_desc.remote_address() + remote_desc.remote_bytes(), message.proto_offset);
+        remote_desc.set_remote_address(reinterpret_cast<std::uint64_t>(base + remote_desc.remote_address()));
+    }
+    return proto;
+}
+
+void send_fds(int socket, const ChannelFds& fds)
+{
+    std::array<int, 3> descriptors{fds.region, fds.data_efd, fds.release_efd};
+    char byte = 0;
+
+    iovec iov;
+    iov.iov_base = &byte;
+    iov.iov_len  = 1;
+
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(descriptors))> control{};
+
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control.data();
+    msg.msg_controllen = control.size();
+
+    auto* cmsg       = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type  = SCM_RIGHTS;
+    cmsg->cmsg_len   = CMSG_LEN(sizeof(descriptors));
+    std::memcpy(CMSG_DATA(cmsg), descriptors.data(), sizeof(descriptors));
+
+    if (::sendmsg(socket, &msg, 0) != 1)
+    {
+        LOG(ERROR) << "sendmsg of shared memory channel fds failed: " << std::strerror(errno);
+        throw std::runtime_error("unable to send channel fds");
+    }
+}
+
+ChannelFds receive_fds(int socket)
+{
+    std::array<int, 3> descriptors{};
+    char byte = 0;
+
+    iovec iov;
+    iov.iov_base = &byte;
+    iov.iov_len  = 1;
+
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(descriptors))> control{};
+
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control.data();
+    msg.msg_controllen = control.size();
+
+    if (::recvmsg(socket, &msg, MSG_CMSG_CLOEXEC) != 1)
+    {
+        LOG(ERROR) << "recvmsg of shared memory channel fds failed: " << std::strerror(errno);
+        throw std::runtime_error("unable to receive channel fds");
+    }
+
+    auto* cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg == nullptr || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(sizeof(descriptors)))
+    {
+        LOG(ERROR) << "malformed shared memory channel fd message";
+        throw std::runtime_error("unable to receive channel fds");
+    }
+    std::memcpy(descriptors.data(), CMSG_DATA(cmsg), sizeof(descriptors));
+
+    return ChannelFds{descriptors[0], descriptors[1], descriptors[2]};
+}
+
+}  // namespace srf::internal::shm
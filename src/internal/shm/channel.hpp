@@ -0,0 +1,335 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/shm/ring.hpp"
+#include "internal/shm/shared_region.hpp"
+
+#include <srf/protos/codable.pb.h>
+#include <srf/codable/encoded_object.hpp>
+#include <srf/memory/blob.hpp>
+#include <srf/memory/blob_storage.hpp>
+#include <srf/memory/block.hpp>
+#include <srf/memory/memory_kind.hpp>
+#include <srf/types.hpp>
+#include <srf/utils/macros.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// A shared memory channel carries messages in one direction between two processes on the same host.
+//
+// The channel is a single memfd region holding a message ring, a release ring and an arena of fixed-size slots.
+// The sending process owns the free list of slots. A payload is written directly into a slot, then only a record
+// naming the slot crosses the message ring; the receiving process hands out the slot's memory in place as a blob and
+// returns the slot over the release ring once the last reference to the blob is dropped.
+//
+// region layout; each section is 64-byte aligned, slots are page aligned
+//   ChannelHeader | message RecordRing<Record> | release RecordRing<std::uint64_t> | slot 0 | slot 1 | ...
+
+namespace srf::internal::shm {
+
+struct ChannelOptions
+{
+    // capacity of each slot; the largest payload which may be sent
+    std::size_t slot_bytes{65536};
+
+    // number of slots; bounds the number of messages which may be in flight or held by the receiver
+    std::size_t slot_count{256};
+};
+
+/**
+ * @brief File descriptors which must be passed to the receiving process to attach to a channel
+ */
+struct ChannelFds
+{
+    int region{-1};
+    int data_efd{-1};
+    int release_efd{-1};
+};
+
+enum class RecordKind : std::uint32_t
+{
+    Block         = 0,
+    EncodedObject = 1,
+};
+
+struct Record
+{
+    PortAddress port_address;
+    std::uint32_t slot;
+    RecordKind kind;
+    // offset and size within the slot of the block or, for EncodedObject records, of the serialized proto
+    std::uint64_t offset;
+    std::uint64_t bytes;
+};
+
+class Sender;
+
+/**
+ * @brief A slot acquired from a Sender; written in place by the caller, then passed to Sender::send.
+ *
+ * If a Buffer is destroyed without being sent, its slot is returned to the Sender. The Sender must outlive its Buffers.
+ */
+class Buffer final
+{
+  public:
+    Buffer() = default;
+    ~Buffer();
+
+    Buffer(Buffer&&) noexcept;
+    Buffer& operator=(Buffer&&) noexcept;
+
+    DELETE_COPYABILITY(Buffer);
+
+    void* data() const;
+    std::size_t bytes() const;
+
+    operator bool() const;
+
+  private:
+    Buffer(Sender* sender, std::uint32_t slot, void* data, std::size_t bytes);
+
+    Sender* m_sender{nullptr};
+    std::uint32_t m_slot{0};
+    void* m_data{nullptr};
+    std::size_t m_bytes{0};
+
+    friend Sender;
+};
+
+/**
+ * @brief A received region of a slot; the slot is returned to the sender when the lease is released.
+ */
+struct SlotView
+{
+    std::shared_ptr<void> lease;
+    void* data;
+    std::size_t bytes;
+};
+
+/**
+ * @brief A message received from a channel; payload references the sender's slot in place.
+ */
+struct Message
+{
+    PortAddress port_address;
+    RecordKind kind;
+
+    // for Block records, the block; for EncodedObject records, the memory blocks followed by the serialized proto
+    memory::blob payload;
+
+    // offset of the serialized proto within payload; only valid for EncodedObject records
+    std::size_t proto_offset{0};
+};
+
+/**
+ * @brief Sending side of a shared memory channel; creates and owns the channel's region and eventfds.
+ *
+ * acquire, send and the release of slots are serialized by an internal mutex, so a Sender may be used by multiple
+ * fibers.
+ */
+class Sender final
+{
+  public:
+    Sender(ChannelOptions options = {});
+    ~Sender();
+
+    DELETE_COPYABILITY(Sender);
+    DELETE_MOVEABILITY(Sender);
+
+    /**
+     * @brief The file descriptors to pass to the receiving process; remain owned by the Sender
+     */
+    ChannelFds fds() const;
+
+    /**
+     * @brief Listen on a unix domain socket at socket_path, pass the channel's fds to the first process to connect,
+     * then close the socket
+     */
+    void export_fds(const std::string& socket_path) const;
+
+    /**
+     * @brief Acquire a slot for a payload of bytes; suspends only the calling fiber until a slot is released by the
+     * receiver
+     */
+    Buffer acquire(std::size_t bytes);
+
+    std::optional<Buffer> try_acquire(std::size_t bytes);
+
+    /**
+     * @brief Send a buffer written in place; no copy of the payload is made
+     */
+    void send(PortAddress port_address, Buffer&& buffer);
+
+    /**
+     * @brief Copy a host memory block into a slot and send it; intended for trivially copyable types
+     */
+    void send(PortAddress port_address, memory::const_block block);
+
+    /**
+     * @brief Copy the memory blocks of an encoded object into a slot followed by its proto and send it
+     *
+     * The remote descriptors of the proto are rewritten to offsets within the slot and are resolved to addresses in the
+     * receiving process by decode. All memory blocks must be host accessible.
+     */
+    void send(PortAddress port_address, const codable::protos::EncodedObject& encoded_object);
+    void send(PortAddress port_address, const codable::EncodedObject& encoded_object);
+
+    std::size_t slot_bytes() const;
+
+    // number of slots currently free, including those released by the receiver
+    std::size_t free_slots();
+
+  private:
+    // bounds on the fiber sleep between polls of the release ring once acquire has exhausted its busy poll window
+    static constexpr std::chrono::microseconds min_acquire_backoff{1};    // NOLINT
+    static constexpr std::chrono::microseconds max_acquire_backoff{250};  // NOLINT
+
+    // return slots released by the receiver to the free list; the caller must hold m_mutex
+    void reclaim();
+
+    void push(const Record& record);
+    void release(std::uint32_t slot);
+
+    ChannelOptions m_options;
+    std::shared_ptr<SharedRegion> m_region;
+    int m_data_efd;
+    int m_release_efd;
+    std::unique_ptr<RecordRing<Record>> m_messages;
+    std::unique_ptr<RecordRing<std::uint64_t>> m_releases;
+    std::byte* m_slots;
+    std::vector<std::uint32_t> m_free_slots;
+    mutable Mutex m_mutex;
+
+    friend Buffer;
+};
+
+/**
+ * @brief Receiving side of a shared memory channel.
+ *
+ * A Receiver has a single consumer; received payloads may be released from any thread. Received blobs may outlive the
+ * Receiver.
+ */
+class Receiver final
+{
+  public:
+    /**
+     * @brief Attach to the channel described by fds; takes ownership of the fds
+     */
+    Receiver(ChannelFds fds);
+    ~Receiver();
+
+    DELETE_COPYABILITY(Receiver);
+    DELETE_MOVEABILITY(Receiver);
+
+    /**
+     * @brief Connect to the unix domain socket of Sender::export_fds and attach to its channel
+     */
+    static std::unique_ptr<Receiver> connect(const std::string& socket_path);
+
+    /**
+     * @brief Receive the next message if one is available
+     *
+     * Records are written by the peer process, so each is validated against the channel's layout. A record which does
+     * not describe a valid slot region is a channel error: it is logged, std::runtime_error is thrown and the Receiver
+     * throws on every subsequent receive.
+     */
+    std::optional<Message> try_receive();
+
+    /**
+     * @brief Receive the next message, busy polling for busy_poll_window then suspending only the calling fiber between
+     * polls with an exponential backoff; returns nullopt if no message arrived within timeout
+     */
+    std::optional<Message> await_receive(std::chrono::milliseconds timeout);
+
+    static constexpr std::chrono::microseconds busy_poll_window{50};  // NOLINT
+
+  private:
+    // bounds on the fiber sleep between polls of the message ring once await_receive has exhausted its busy poll window
+    static constexpr std::chrono::microseconds min_receive_backoff{1};    // NOLINT
+    static constexpr std::chrono::microseconds max_receive_backoff{250};  // NOLINT
+
+    struct State;
+
+    std::shared_ptr<State> m_state;
+    int m_data_efd;
+    std::unique_ptr<RecordRing<Record>> m_messages;
+    std::byte* m_slots;
+    std::size_t m_slot_bytes;
+    std::size_t m_slot_count;
+    bool m_failed{false};
+};
+
+/**
+ * @brief Decode the proto of an EncodedObject message; remote descriptors are rewritten to describe memory within the
+ * message's payload which must outlive any use of the proto
+ */
+codable::protos::EncodedObject decode(const Message& message);
+
+// pass and receive channel fds over a connected unix domain socket
+void send_fds(int socket, const ChannelFds& fds);
+ChannelFds receive_fds(int socket);
+
+}  // namespace srf::internal::shm
+
+namespace srf::memory {
+
+template <>
+class BlobStorage<internal::shm::SlotView> final : public IBlobStorage
+{
+  public:
+    BlobStorage(internal::shm::SlotView&& view) : m_view(std::move(view)) {}
+    ~BlobStorage() final = default;
+
+  private:
+    void* do_data() final
+    {
+        return m_view.data;
+    }
+
+    const void* do_data() const final
+    {
+        return m_view.data;
+    }
+
+    std::size_t do_bytes() const final
+    {
+        return m_view.bytes;
+    }
+
+    memory_kind_type do_kind() const final
+    {
+        return memory_kind_type::host;
+    }
+
+    std::shared_ptr<IBlobStorage> do_allocate(std::size_t bytes, cudaStream_t stream) const final
+    {
+        throw std::runtime_error("shared memory slots are not backed by a memory resource");
+    }
+
+    internal::shm::SlotView m_view;
+};
+
+}  // namespace srf::memory
@@ -0,0 +1,174 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <glog/logging.h>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace srf::internal::shm {
+
+/**
+ * @brief Control block of a RecordRing; placed at the start of the ring's shared memory.
+ *
+ * The head is only written by the consumer and the tail only by the producer; each lives on its own cache line.
+ */
+struct RingHeader
+{
+    alignas(64) std::atomic<std::uint64_t> head;
+    alignas(64) std::atomic<std::uint64_t> tail;
+    alignas(64) std::atomic<std::uint32_t> consumer_waiting;
+    std::uint32_t capacity;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared memory rings require lock-free atomics");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shared memory rings require lock-free atomics");
+
+/**
+ * @brief Single-producer, single-consumer ring of fixed-size records in memory shared between two processes.
+ *
+ * The producer signals an eventfd only when the consumer has declared itself waiting, so a busy consumer is never
+ * signalled. Neither side is thread safe; callers with multiple producers or consumers must serialize access.
+ */
+template <typename RecordT>
+class RecordRing final
+{
+    static_assert(std::is_trivially_copyable_v<RecordT>, "ring records must be trivially copyable");
+
+  public:
+    // bytes of shared memory required for a ring of capacity records
+    static constexpr std::size_t required_bytes(std::size_t capacity)
+    {
+        return sizeof(RingHeader) + capacity * sizeof(RecordT);
+    }
+
+    /**
+     * @param memory shared memory of at least required_bytes(capacity), aligned to 64 bytes
+     * @param capacity power of two number of records
+     * @param efd eventfd used to wake a waiting consumer; not owned
+     * @param initialize true for exactly one of the two processes sharing the ring, before the other attaches
+     */
+    RecordRing(void* memory, std::size_t capacity, int efd, bool initialize) :
+      m_header(static_cast<RingHeader*>(memory)),
+      m_records(reinterpret_cast<RecordT*>(static_cast<std::byte*>(memory) + sizeof(RingHeader))),
+      m_mask(capacity - 1),
+      m_efd(efd)
+    {
+        CHECK_GT(capacity, 0);
+        CHECK_EQ(capacity & m_mask, 0) << "ring capacity must be a power of two";
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(memory) % alignof(RingHeader), 0);
+
+        if (initialize)
+        {
+            new (m_header) RingHeader();
+            m_header->head.store(0);
+            m_header->tail.store(0);
+            m_header->consumer_waiting.store(0);
+            m_header->capacity = capacity;
+        }
+        CHECK_EQ(m_header->capacity, capacity);
+    }
+
+    std::size_t capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    bool empty() const
+    {
+        return m_header->head.load(std::memory_order_acquire) == m_header->tail.load(std::memory_order_acquire);
+    }
+
+    // producer; returns false if the ring is full
+    bool try_push(const RecordT& record)
+    {
+        auto tail = m_header->tail.load(std::memory_order_relaxed);
+        if (tail - m_header->head.load(std::memory_order_acquire) > m_mask)
+        {
+            return false;
+        }
+        m_records[tail & m_mask] = record;
+
+        // sequentially consistent so the publication of the record is ordered before the check of consumer_waiting
+        m_header->tail.store(tail + 1, std::memory_order_seq_cst);
+        if (m_header->consumer_waiting.load(std::memory_order_seq_cst) != 0)
+        {
+            std::uint64_t one = 1;
+            auto rc           = ::write(m_efd, &one, sizeof(one));
+            LOG_IF(ERROR, rc != sizeof(one)) << "failed to signal shared memory ring eventfd";
+        }
+        return true;
+    }
+
+    // consumer; returns false if the ring is empty
+    bool try_pop(RecordT& record)
+    {
+        auto head = m_header->head.load(std::memory_order_relaxed);
+        if (head == m_header->tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        record = m_records[head & m_mask];
+        m_header->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer; block the calling thread until the ring is non-empty or timeout has elapsed
+     * @return true if the ring is non-empty
+     */
+    bool wait(std::chrono::milliseconds timeout)
+    {
+        m_header->consumer_waiting.store(1, std::memory_order_seq_cst);
+        if (!empty())
+        {
+            m_header->consumer_waiting.store(0, std::memory_order_relaxed);
+            return true;
+        }
+
+        pollfd pfd;
+        pfd.fd      = m_efd;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+        ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+
+        // drain the eventfd; it is non-blocking
+        std::uint64_t count;
+        while (::read(m_efd, &count, sizeof(count)) == sizeof(count)) {}
+
+        m_header->consumer_waiting.store(0, std::memory_order_relaxed);
+        return !empty();
+    }
+
+  private:
+    RingHeader* m_header;
+    RecordT* m_records;
+    std::size_t m_mask;
+    int m_efd;
+};
+
+}  // namespace srf::internal::shm
@@ -0,0 +1,107 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/shm/shared_region.hpp"
+
+#include <glog/logging.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+namespace srf::internal::shm {
+
+std::shared_ptr<SharedRegion> SharedRegion::create(std::size_t bytes, const std::string& name)
+{
+    CHECK_GT(bytes, 0);
+
+    int fd = ::memfd_create(name.c_str(), MFD_CLOEXEC);
+    if (fd < 0)
+    {
+        LOG(ERROR) << "memfd_create failed: " << std::strerror(errno);
+        throw std::runtime_error("memfd_create failed");
+    }
+
+    if (::ftruncate(fd, bytes) != 0)
+    {
+        LOG(ERROR) << "ftruncate of memfd to " << bytes << " bytes failed: " << std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("ftruncate failed");
+    }
+
+    auto* data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        LOG(ERROR) << "mmap of memfd failed: " << std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("mmap failed");
+    }
+
+    return std::shared_ptr<SharedRegion>(new SharedRegion(fd, data, bytes));
+}
+
+std::shared_ptr<SharedRegion> SharedRegion::attach(int fd)
+{
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        LOG(ERROR) << "unable to determine the size of shared region fd: " << fd;
+        ::close(fd);
+        throw std::runtime_error("invalid shared region fd");
+    }
+    auto bytes = static_cast<std::size_t>(info.st_size);
+
+    auto* data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        LOG(ERROR) << "mmap of shared region failed: " << std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("mmap failed");
+    }
+
+    return std::shared_ptr<SharedRegion>(new SharedRegion(fd, data, bytes));
+}
+
+SharedRegion::SharedRegion(int fd, void* data, std::size_t bytes) : m_fd(fd), m_data(data), m_bytes(bytes) {}
+
+SharedRegion::~SharedRegion()
+{
+    ::munmap(m_data, m_bytes);
+    ::close(m_fd);
+}
+
+void* SharedRegion::data() const
+{
+    return m_data;
+}
+
+std::size_t SharedRegion::bytes() const
+{
+    return m_bytes;
+}
+
+int SharedRegion::fd() const
+{
+    return m_fd;
+}
+
+}  // namespace srf::internal::shm
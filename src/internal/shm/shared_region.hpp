@@ -0,0 +1,64 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <srf/utils/macros.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace srf::internal::shm {
+
+/**
+ * @brief Memory region backed by a memfd which may be mapped by multiple processes on the same host.
+ *
+ * The region is shared by passing its file descriptor to another process, either by inheritance across fork or over a
+ * unix domain socket, see send_fds.
+ */
+class SharedRegion final
+{
+  public:
+    /**
+     * @brief Create and map a zero-initialized region of bytes
+     */
+    static std::shared_ptr<SharedRegion> create(std::size_t bytes, const std::string& name = "srf_shm");
+
+    /**
+     * @brief Map the entire region of a memfd created by another process; takes ownership of fd
+     */
+    static std::shared_ptr<SharedRegion> attach(int fd);
+
+    ~SharedRegion();
+
+    DELETE_COPYABILITY(SharedRegion);
+    DELETE_MOVEABILITY(SharedRegion);
+
+    void* data() const;
+    std::size_t bytes() const;
+    int fd() const;
+
+  private:
+    SharedRegion(int fd, void* data, std::size_t bytes);
+
+    int m_fd;
+    void* m_data;
+    std::size_t m_bytes;
+};
+
+}  // namespace srf::internal::shm
@@ -27,5 +27,6 @@ class DevicePartition;
 class FiberTaskQueue;
 class FiberPool;
 class FiberManager;
+class PinnedThreadPool;
 
 }  // namespace srf::internal::system
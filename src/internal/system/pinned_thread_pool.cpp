@@ -0,0 +1,133 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "internal/system/pinned_thread_pool.hpp"
+
+#include "internal/system/system.hpp"
+
+#include <glog/logging.h>
+
+#include <ostream>
+#include <utility>
+
+namespace srf::internal::system {
+
+PinnedThreadPool::PinnedThreadPool(std::shared_ptr<System> system, std::string desc) :
+  m_system(std::move(system)),
+  m_desc(std::move(desc)),
+  m_state(std::make_shared<State>())
+{
+    CHECK(m_system);
+}
+
+PinnedThreadPool::~PinnedThreadPool()
+{
+    {
+        std::lock_guard<decltype(m_state->mutex)> lock(m_state->mutex);
+        m_state->shutdown = true;
+        for (auto& worker : m_state->workers)
+        {
+            worker->cv.notify_one();
+        }
+    }
+
+    // threads running a task are joined once their task completes; the workers are not modified once shutdown is set
+    for (auto& worker : m_state->workers)
+    {
+        if (worker->thread.get_id() == std::this_thread::get_id())
+        {
+            // the calling thread returns to run once the task destroying the pool completes; it holds m_state
+            DVLOG(10) << "[pinned_thread_pool]: destroyed from one of its own threads; detaching";
+            worker->thread.detach();
+            continue;
+        }
+        worker->thread.join();
+    }
+}
+
+void PinnedThreadPool::launch(const CpuSet& cpu_set, std::packaged_task<void()> task)
+{
+    CHECK(task.valid());
+    auto key = cpu_set.str();
+
+    std::lock_guard<decltype(m_state->mutex)> lock(m_state->mutex);
+    CHECK(!m_state->shutdown);
+
+    auto search = m_state->idle.find(key);
+    if (search != m_state->idle.end() && !search->second.empty())
+    {
+        auto* worker = search->second.back();
+        search->second.pop_back();
+        DVLOG(10) << "[pinned_thread_pool]: reusing tid: " << worker->thread.get_id() << " for cpu_set " << key;
+        worker->task = std::move(task);
+        worker->cv.notify_one();
+        return;
+    }
+
+    auto worker  = std::make_unique<Worker>();
+    worker->key  = key;
+    worker->task = std::move(task);
+
+    auto* ptr      = worker.get();
+    worker->thread = m_system->make_thread(m_desc, cpu_set, [state = m_state, ptr] { run(state, *ptr); });
+    DVLOG(10) << "[pinned_thread_pool]: created tid: " << worker->thread.get_id() << " for cpu_set " << key;
+    m_state->workers.push_back(std::move(worker));
+}
+
+void PinnedThreadPool::run(const std::shared_ptr<State>& state, Worker& worker)
+{
+    std::unique_lock<decltype(state->mutex)> lock(state->mutex);
+    while (true)
+    {
+        worker.cv.wait(lock, [&state, &worker] { return worker.task.valid() || state->shutdown; });
+        if (!worker.task.valid())
+        {
+            return;
+        }
+
+        auto task = std::move(worker.task);
+        lock.unlock();
+        task();
+        lock.lock();
+
+        if (state->shutdown)
+        {
+            return;
+        }
+        state->idle[worker.key].push_back(&worker);
+    }
+}
+
+std::size_t PinnedThreadPool::thread_count() const
+{
+    std::lock_guard<decltype(m_state->mutex)> lock(m_state->mutex);
+    return m_state->workers.size();
+}
+
+std::size_t PinnedThreadPool::idle_count() const
+{
+    std::lock_guard<decltype(m_state->mutex)> lock(m_state->mutex);
+    std::size_t count = 0;
+    for (const auto& [key, workers] : m_state->idle)
+    {
+        count += workers.size();
+    }
+    return count;
+}
+
+}  // namespace srf::internal::system
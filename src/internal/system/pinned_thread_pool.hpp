@@ -0,0 +1,108 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <srf/core/bitmap.hpp>
+#include <srf/utils/macros.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace srf::internal::system {
+
+class System;
+
+/**
+ * @brief Persistent pool of pinned threads to which long running tasks are assigned and from which they are returned
+ *
+ * In contrast to the ThreadPool, which multiplexes short compute tasks over a fixed set of threads, each task launched
+ * on a PinnedThreadPool is given a dedicated thread for its entire lifetime. When the task completes, its thread is
+ * returned to the pool and is reused by the next task launched with the same cpu affinity. A new thread is only created
+ * when no idle thread with the requested affinity exists, so the thread creation, affinity and thread initialization
+ * costs are paid once per thread rather than once per launch.
+ *
+ * The ThreadEngines backing Thread runnables launch their tasks on a PinnedThreadPool owned by their engine factory.
+ *
+ * Threads are reused without clearing their thread_local state, so state written by one task is visible to the next
+ * task run on the same thread:
+ *  - the node free lists of BlobStorage and the thread caches of BufferPool keep their cached memory, which remains
+ *    valid for any task; BufferPool caches of destroyed pools are dropped on the next use of a pool by the thread;
+ *  - the thread local resources registered with the System are keyed by cpu_set and are the same for every task;
+ *  - memory::detail::thread_local_view and any other thread_local set by a task are not restored; a task which
+ *    changes such state must restore it before returning.
+ *
+ * The pool may be destroyed from one of its own threads, e.g. when the last task holding the pool releases it. That
+ * thread is detached and finishes its teardown on state which is shared with the pool and outlives it.
+ */
+class PinnedThreadPool final
+{
+  public:
+    PinnedThreadPool(std::shared_ptr<System> system, std::string desc = "thread_engine");
+    ~PinnedThreadPool();
+
+    DELETE_COPYABILITY(PinnedThreadPool);
+    DELETE_MOVEABILITY(PinnedThreadPool);
+
+    /**
+     * @brief Run task on an idle thread pinned to cpu_set, creating the thread if no idle thread is available
+     */
+    void launch(const CpuSet& cpu_set, std::packaged_task<void()> task);
+
+    // number of threads owned by the pool
+    std::size_t thread_count() const;
+
+    // number of threads awaiting a task
+    std::size_t idle_count() const;
+
+  private:
+    struct Worker
+    {
+        std::string key;
+        std::packaged_task<void()> task;
+        std::condition_variable cv;
+        std::thread thread;
+    };
+
+    // owned jointly by the pool and its threads, so a thread may outlive the pool when destroyed from that thread
+    struct State
+    {
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        // idle workers keyed by the string representation of their cpu_set
+        std::map<std::string, std::vector<Worker*>> idle;
+
+        bool shutdown{false};
+        std::mutex mutex;
+    };
+
+    static void run(const std::shared_ptr<State>& state, Worker& worker);
+
+    std::shared_ptr<System> m_system;
+    const std::string m_desc;
+    const std::shared_ptr<State> m_state;
+};
+
+}  // namespace srf::internal::system
@@ -0,0 +1,190 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/ucx/progress.hpp"
+
+#include "internal/ucx/worker.hpp"
+
+#include <srf/types.hpp>
+
+#include <boost/fiber/operations.hpp>
+#include <glog/logging.h>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+namespace srf::internal::ucx {
+
+AdaptiveProgress::AdaptiveProgress(Handle<Worker> worker, std::chrono::microseconds busy_poll_window) :
+  m_worker(std::move(worker)),
+  m_efd(m_worker->efd()),
+  m_busy_poll_window(busy_poll_window),
+  m_last_activity(std::chrono::steady_clock::now())
+{
+    m_control_efd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_control_efd < 0)
+    {
+        LOG(ERROR) << "eventfd failed: " << std::strerror(errno);
+        throw std::runtime_error("eventfd failed");
+    }
+
+    m_reactor = std::thread([this] { reactor(); });
+}
+
+AdaptiveProgress::~AdaptiveProgress()
+{
+    {
+        std::lock_guard<decltype(m_reactor_mutex)> lock(m_reactor_mutex);
+        m_shutdown = true;
+    }
+    m_reactor_cv.notify_one();
+
+    // interrupt a poll in progress
+    std::uint64_t one = 1;
+    auto rc           = ::write(m_control_efd, &one, sizeof(one));
+    LOG_IF(ERROR, rc != sizeof(one)) << "failed to signal the ucx progress reactor";
+
+    m_reactor.join();
+    ::close(m_control_efd);
+}
+
+bool AdaptiveProgress::progress()
+{
+    bool progressed = false;
+    while (m_worker->progress() != 0U)
+    {
+        progressed = true;
+    }
+    if (progressed)
+    {
+        activity();
+    }
+    return progressed;
+}
+
+void AdaptiveProgress::activity()
+{
+    m_last_activity = std::chrono::steady_clock::now();
+}
+
+void AdaptiveProgress::idle()
+{
+    if (std::chrono::steady_clock::now() - m_last_activity < m_busy_poll_window)
+    {
+        boost::this_fiber::yield();
+        return;
+    }
+
+    // arming fails if events arrived since the last progress; yield so the caller polls again without starving other
+    // fibers on this thread
+    if (!m_worker->arm())
+    {
+        boost::this_fiber::yield();
+        return;
+    }
+
+    ++m_suspensions;
+    await_event();
+}
+
+void AdaptiveProgress::await_event()
+{
+    {
+        std::lock_guard<decltype(m_reactor_mutex)> lock(m_reactor_mutex);
+        m_armed = true;
+    }
+    m_reactor_cv.notify_one();
+
+    // only this fiber is suspended; the thread continues to run other fibers
+    std::unique_lock<decltype(m_mutex)> lock(m_mutex);
+    m_cv.wait_for(lock, max_wait, [this] { return m_ready.load(); });
+    m_ready = false;
+}
+
+void AdaptiveProgress::reactor()
+{
+    std::array<pollfd, 2> pfds;
+    pfds[0].fd     = m_efd;
+    pfds[0].events = POLLIN;
+    pfds[1].fd     = m_control_efd;
+    pfds[1].events = POLLIN;
+
+    std::unique_lock<decltype(m_reactor_mutex)> lock(m_reactor_mutex);
+    while (true)
+    {
+        m_reactor_cv.wait(lock, [this] { return m_armed || m_shutdown; });
+        if (m_shutdown)
+        {
+            return;
+        }
+        lock.unlock();
+
+        // a poll which outlives the fiber's max_wait is left in place; the fiber re-arms rather than waiting on it
+        int rc = 0;
+        do
+        {
+            pfds[0].revents = 0;
+            pfds[1].revents = 0;
+            rc              = ::poll(pfds.data(), pfds.size(), -1);
+        } while (rc < 0 && errno == EINTR);
+        LOG_IF(ERROR, rc < 0) << "poll on ucx worker event fd failed: " << std::strerror(errno);
+
+        if ((pfds[1].revents & POLLIN) != 0)
+        {
+            std::uint64_t value = 0;
+            LOG_IF(ERROR, ::read(m_control_efd, &value, sizeof(value)) < 0)
+                << "failed to drain the ucx progress reactor eventfd";
+        }
+
+        lock.lock();
+        m_armed = false;
+        lock.unlock();
+
+        resume();
+        lock.lock();
+    }
+}
+
+void AdaptiveProgress::resume()
+{
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_ready = true;
+    }
+    m_cv.notify_all();
+}
+
+void AdaptiveProgress::wakeup() noexcept
+{
+    resume();
+}
+
+std::size_t AdaptiveProgress::suspensions() const
+{
+    return m_suspensions;
+}
+
+}  // namespace srf::internal::ucx
@@ -0,0 +1,113 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/ucx/common.hpp"
+#include "internal/ucx/worker.hpp"
+
+#include <srf/types.hpp>
+#include <srf/utils/macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+namespace srf::internal::ucx {
+
+/**
+ * @brief Hybrid busy-poll / event-driven progress for a ucx worker driven by a single fiber.
+ *
+ * While the worker is active, or within busy_poll_window of the last activity, idle() simply yields so that newly
+ * arrived messages are observed with the latency of a single poll. Once the window has elapsed, idle() arms the worker
+ * and suspends the calling fiber on a fiber condition variable. A dedicated reactor thread owned by this object blocks
+ * in poll() on the worker's event fd while the fiber is suspended and resumes it as soon as the fd becomes readable.
+ * Only the idle fiber is suspended; other fibers on the same thread continue to run.
+ *
+ * The suspension is bounded by max_wait so callers periodically observe their own shutdown conditions; wakeup() resumes
+ * a suspended caller immediately.
+ */
+class AdaptiveProgress final
+{
+  public:
+    static constexpr std::chrono::microseconds default_busy_poll_window{100};  // NOLINT
+    static constexpr std::chrono::milliseconds max_wait{10};                   // NOLINT
+
+    AdaptiveProgress(Handle<Worker> worker, std::chrono::microseconds busy_poll_window = default_busy_poll_window);
+    ~AdaptiveProgress();
+
+    DELETE_COPYABILITY(AdaptiveProgress);
+    DELETE_MOVEABILITY(AdaptiveProgress);
+
+    /**
+     * @brief Progress the worker until no further progress is made; returns true if any progress was made
+     */
+    bool progress();
+
+    /**
+     * @brief Record activity observed by the caller, e.g. a probed message, which restarts the busy poll window
+     */
+    void activity();
+
+    /**
+     * @brief Called when a poll of the worker found no work; either yields or suspends the calling fiber
+     */
+    void idle();
+
+    /**
+     * @brief Resume a fiber suspended in idle, or the next call to idle if none is suspended; safe to call from any
+     * thread
+     */
+    void wakeup() noexcept;
+
+    // number of times the caller was suspended on the event fd
+    std::size_t suspensions() const;
+
+  private:
+    // returns once the event fd is readable, wakeup was called or max_wait has elapsed
+    void await_event();
+
+    // body of the reactor thread; polls the event fd each time the fiber is suspended
+    void reactor();
+
+    // resume the fiber suspended in await_event
+    void resume();
+
+    Handle<Worker> m_worker;
+    const int m_efd;
+    const std::chrono::microseconds m_busy_poll_window;
+    std::chrono::steady_clock::time_point m_last_activity;
+    std::atomic<std::size_t> m_suspensions{0};
+
+    // fiber side; m_ready is set by the reactor or wakeup and consumed by await_event
+    Mutex m_mutex;
+    CondV m_cv;
+    std::atomic<bool> m_ready{false};
+
+    // reactor side; m_armed requests a poll of the event fd, m_control_efd interrupts a poll on shutdown
+    std::mutex m_reactor_mutex;
+    std::condition_variable m_reactor_cv;
+    bool m_armed{false};
+    bool m_shutdown{false};
+    int m_control_efd{-1};
+    std::thread m_reactor;
+};
+
+}  // namespace srf::internal::ucx
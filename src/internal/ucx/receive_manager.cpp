@@ -18,19 +18,17 @@
 #include "internal/ucx/receive_manager.hpp"
 
 #include "internal/ucx/common.hpp"
+#include "internal/ucx/progress.hpp"
 #include "internal/ucx/worker.hpp"
 
 #include <srf/types.hpp>
 
 #include <boost/fiber/future/async.hpp>
 #include <boost/fiber/future/future.hpp>
-#include <boost/fiber/operations.hpp>
 #include <boost/fiber/policy.hpp>  // for launch, launch::post
 
 #include <ucp/api/ucp.h>  // for ucp_tag_probe_nb, ucp_tag_recv_info
 
-#include <chrono>   // for nanoseconds
-#include <cstdint>  // for uint32_t
 #include <utility>
 
 namespace srf::internal::ucx {
@@ -39,6 +37,7 @@ TaggedReceiveManager::TaggedReceiveManager(Handle<Worker> worker, ucp_tag_t tag,
   m_worker(std::move(worker)),
   m_tag(tag),
   m_tag_mask(task_mask),
+  m_progress(std::make_unique<AdaptiveProgress>(m_worker)),
   m_running(false)
 {}
 
@@ -53,6 +52,7 @@ void TaggedReceiveManager::start()
 void TaggedReceiveManager::stop()
 {
     m_running = false;
+    m_progress->wakeup();
 }
 
 void TaggedReceiveManager::join()
@@ -73,7 +73,8 @@ void TaggedReceiveManager::progress_engine()
 {
     ucp_tag_message_h msg;
     ucp_tag_recv_info_t msg_info;
-    std::uint32_t backoff = 1;
+
+    auto& progress = *m_progress;
 
     while (true)
     {
@@ -84,31 +85,19 @@ void TaggedReceiveManager::progress_engine()
             {
                 break;
             }
-            while (m_worker->progress() != 0U)
+            if (progress.progress())
             {
-                backoff = 1;
+                continue;
             }
             if (!m_running)
             {
                 return;
             }
-
-            if (backoff < 1048576)
-            {
-                backoff = backoff << 1;
-            }
-            if (backoff < 32768)
-            {
-                boost::this_fiber::yield();
-            }
-            else
-            {
-                boost::this_fiber::sleep_for(std::chrono::nanoseconds(backoff));
-            }
+            progress.idle();
         }
 
         on_tagged_msg(msg, msg_info);
-        backoff = 0;
+        progress.activity();
     }
 }
 
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "internal/ucx/common.hpp"
+#include "internal/ucx/progress.hpp"
 #include "internal/ucx/worker.hpp"
 
 #include <srf/types.hpp>
@@ -58,6 +59,9 @@ class TaggedReceiveManager : public std::enable_shared_from_this<TaggedReceiveMa
     ucp_tag_t m_tag;
     ucp_tag_t m_tag_mask;
 
+    // idle strategy of the progress engine; stop resumes it while it is suspended
+    std::unique_ptr<AdaptiveProgress> m_progress;
+
     Future<void> m_shutdown_complete;
     mutable Mutex m_mutex;
     bool m_running;
@@ -26,8 +26,8 @@
 
 #include <ucp/api/ucp.h>           // for ucp_*
 #include <ucp/api/ucp_def.h>       // for ucp_worker_h
-#include <ucs/type/status.h>       // for ucs_status_string, UCS_OK
-#include <ucs/type/thread_mode.h>  // for UCS_THREAD_MODE_MULTI
+#include <ucs/type/status.h>       // for ucs_status_string, UCS_OK, UCS_ERR_BUSY
+#include <ucs/type/thread_mode.h>  // for ucs_thread_mode_t
 
 #include <cstring>  // for memset
 #include <memory>
@@ -38,7 +38,11 @@
 
 namespace srf::internal::ucx {
 
-Worker::Worker(Handle<Context> context) : m_context(std::move(context)), m_address_pointer(nullptr), m_address_length(0)
+Worker::Worker(Handle<Context> context, ucs_thread_mode_t thread_mode) :
+  m_context(std::move(context)),
+  m_thread_mode(thread_mode),
+  m_address_pointer(nullptr),
+  m_address_length(0)
 {
     CHECK(m_context) << "null context detected when creating ucx worker";
 
@@ -49,9 +53,10 @@ Worker::Worker(Handle<Context> context) : m_context(std::move(context)), m_addre
     // _SINGLE states that only the thread that created can access which could imply thread_local storage
     // used in the implementation. Even a serialized fiber could fail in that scenario if the fiber is
     // executing on a different thread. Swifts @MainActor would be nice here.
-    // We will start with _MULTI and hopefully be able to drop down to _SERIALIZED.
+    // We will start with _MULTI and hopefully be able to drop down to _SERIALIZED; the owner of a worker whose
+    // access is known to be serialized may already opt in via thread_mode.
     worker_params.field_mask  = UCP_WORKER_PARAM_FIELD_THREAD_MODE;
-    worker_params.thread_mode = UCS_THREAD_MODE_MULTI;
+    worker_params.thread_mode = m_thread_mode;
 
     auto status = ucp_worker_create(m_context->handle(), &worker_params, &m_handle);
     if (status != UCS_OK)
@@ -75,11 +80,55 @@ Handle<Endpoint> Worker::create_endpoint(WorkerAddress remote_address)
     return std::make_shared<Endpoint>(casted_this, remote_address);
 }
 
+ucs_thread_mode_t Worker::thread_mode() const
+{
+    return m_thread_mode;
+}
+
 unsigned Worker::progress()
 {
     return ucp_worker_progress(m_handle);
 }
 
+bool Worker::arm()
+{
+    auto status = ucp_worker_arm(m_handle);
+    if (status == UCS_ERR_BUSY)
+    {
+        return false;
+    }
+    if (status != UCS_OK)
+    {
+        LOG(ERROR) << "ucp_worker_arm failed: " << ucs_status_string(status);
+        throw std::runtime_error("ucp_worker_arm failed");
+    }
+    return true;
+}
+
+void Worker::signal()
+{
+    auto status = ucp_worker_signal(m_handle);
+    if (status != UCS_OK)
+    {
+        LOG(ERROR) << "ucp_worker_signal failed: " << ucs_status_string(status);
+        throw std::runtime_error("ucp_worker_signal failed");
+    }
+}
+
+int Worker::efd()
+{
+    if (m_efd < 0)
+    {
+        auto status = ucp_worker_get_efd(m_handle, &m_efd);
+        if (status != UCS_OK)
+        {
+            LOG(ERROR) << "ucp_worker_get_efd failed: " << ucs_status_string(status);
+            throw std::runtime_error("ucp_worker_get_efd failed");
+        }
+    }
+    return m_efd;
+}
+
 const std::string& Worker::address()
 {
     if (m_address_pointer == nullptr)
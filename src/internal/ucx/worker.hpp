@@ -24,21 +24,43 @@
 #include "internal/ucx/endpoint.hpp"
 #include "internal/ucx/primitive.hpp"
 
-#include <ucp/api/ucp_def.h>  // for ucp_worker_h, ucp_address_t
+#include <ucp/api/ucp_def.h>       // for ucp_worker_h, ucp_address_t
+#include <ucs/type/thread_mode.h>  // for ucs_thread_mode_t
 
 #include <cstddef>  // for size_t
 #include <string>
 
 namespace srf::internal::ucx {
 
+/**
+ * @brief UCX Worker
+ *
+ * The default thread mode, UCS_THREAD_MODE_MULTI, allows the worker to be used concurrently from any thread. Workers
+ * created with UCS_THREAD_MODE_SERIALIZED or UCS_THREAD_MODE_SINGLE avoid the internal locking of the worker, but the
+ * owner must guarantee that all access to the worker and its endpoints is serialized or confined to a single thread.
+ */
 class Worker : public Primitive<ucp_worker_h>
 {
   public:
-    Worker(Handle<Context>);
+    Worker(Handle<Context> context, ucs_thread_mode_t thread_mode = UCS_THREAD_MODE_MULTI);
     ~Worker() override;
 
+    ucs_thread_mode_t thread_mode() const;
+
     unsigned progress();
 
+    /**
+     * @brief Arm the worker's event fd; returns false if events are pending and the worker should be progressed
+     * instead of waited on
+     */
+    bool arm();
+
+    // wake any thread waiting on the event fd; safe to call from any thread
+    void signal();
+
+    // file descriptor which becomes readable on worker activity once armed
+    int efd();
+
     const std::string& address();
     void release_address();
 
@@ -46,9 +68,11 @@ class Worker : public Primitive<ucp_worker_h>
 
   private:
     Handle<Context> m_context;
+    ucs_thread_mode_t m_thread_mode;
     std::string m_address;
     ucp_address_t* m_address_pointer;
     std::size_t m_address_length;
+    int m_efd{-1};
 };
 
 }  // namespace srf::internal::ucx
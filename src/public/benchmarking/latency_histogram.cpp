@@ -0,0 +1,182 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <srf/benchmarking/latency_histogram.hpp>
+
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace srf::benchmarking {
+
+namespace {
+
+unsigned floor_log2(std::uint64_t value)
+{
+    return 63U - static_cast<unsigned>(__builtin_clzll(value));
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram(std::uint64_t highest_trackable_ns, unsigned sub_bucket_bits) :
+  m_sub_bucket_bits(sub_bucket_bits),
+  m_sub_bucket_half(std::uint64_t(1) << (sub_bucket_bits - 1)),
+  m_highest_trackable(highest_trackable_ns),
+  m_min(std::numeric_limits<std::uint64_t>::max())
+{
+    CHECK(sub_bucket_bits >= 2 && sub_bucket_bits <= 24) << "sub_bucket_bits must be in [2, 24]";
+    CHECK_GE(highest_trackable_ns, std::uint64_t(1) << sub_bucket_bits);
+    m_counts.resize(index_for(highest_trackable_ns) + 1, 0);
+}
+
+std::size_t LatencyHistogram::index_for(std::uint64_t value) const
+{
+    if (value < (m_sub_bucket_half << 1))
+    {
+        return value;
+    }
+    auto shift = floor_log2(value) - m_sub_bucket_bits + 1;
+    return shift * m_sub_bucket_half + (value >> shift);
+}
+
+std::uint64_t LatencyHistogram::highest_equivalent_value(std::size_t index) const
+{
+    if (index < (m_sub_bucket_half << 1))
+    {
+        return index;
+    }
+    auto shift = index / m_sub_bucket_half - 1;
+    auto sub   = index - shift * m_sub_bucket_half;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t value_ns)
+{
+    if (value_ns > m_highest_trackable)
+    {
+        ++m_overflow;
+        value_ns = m_highest_trackable;
+    }
+    ++m_counts[index_for(value_ns)];
+    ++m_count;
+    m_sum += value_ns;
+    m_min = std::min(m_min, value_ns);
+    m_max = std::max(m_max, value_ns);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    CHECK(m_sub_bucket_bits == other.m_sub_bucket_bits && m_highest_trackable == other.m_highest_trackable)
+        << "unable to merge histograms with different configurations";
+
+    for (std::size_t i = 0; i < m_counts.size(); ++i)
+    {
+        m_counts[i] += other.m_counts[i];
+    }
+    m_count += other.m_count;
+    m_overflow += other.m_overflow;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+void LatencyHistogram::reset()
+{
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    m_count    = 0;
+    m_overflow = 0;
+    m_sum      = 0;
+    m_min      = std::numeric_limits<std::uint64_t>::max();
+    m_max      = 0;
+}
+
+std::uint64_t LatencyHistogram::count() const
+{
+    return m_count;
+}
+
+std::uint64_t LatencyHistogram::overflow_count() const
+{
+    return m_overflow;
+}
+
+std::uint64_t LatencyHistogram::min() const
+{
+    return m_count == 0 ? 0 : m_min;
+}
+
+std::uint64_t LatencyHistogram::max() const
+{
+    return m_max;
+}
+
+double LatencyHistogram::mean() const
+{
+    return m_count == 0 ? 0.0 : static_cast<double>(m_sum / m_count);
+}
+
+std::uint64_t LatencyHistogram::highest_trackable() const
+{
+    return m_highest_trackable;
+}
+
+std::uint64_t LatencyHistogram::value_at_percentile(double percentile) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    percentile  = std::clamp(percentile, 0.0, 100.0);
+    auto target = static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_count)));
+    target      = std::max<std::uint64_t>(target, 1);
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < m_counts.size(); ++i)
+    {
+        seen += m_counts[i];
+        if (seen >= target)
+        {
+            return std::min(highest_equivalent_value(i), m_max);
+        }
+    }
+    return m_max;
+}
+
+nlohmann::json LatencyHistogram::to_json() const
+{
+    constexpr double NsToSec = 1 / 1e9;  // NOLINT
+
+    nlohmann::json json;
+    json["count"]          = m_count;
+    json["overflow_count"] = m_overflow;
+    json["min_seconds"]    = min() * NsToSec;
+    json["mean_seconds"]   = mean() * NsToSec;
+    json["max_seconds"]    = max() * NsToSec;
+    json["p50_seconds"]    = value_at_percentile(50.0) * NsToSec;
+    json["p90_seconds"]    = value_at_percentile(90.0) * NsToSec;
+    json["p99_seconds"]    = value_at_percentile(99.0) * NsToSec;
+    json["p99_9_seconds"]  = value_at_percentile(99.9) * NsToSec;
+    json["p99_99_seconds"] = value_at_percentile(99.99) * NsToSec;
+    return json;
+}
+
+}  // namespace srf::benchmarking
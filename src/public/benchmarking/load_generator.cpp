@@ -0,0 +1,154 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <srf/benchmarking/load_generator.hpp>
+#include <srf/core/userspace_threads.hpp>
+
+#include <boost/fiber/operations.hpp>
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+
+namespace srf::benchmarking {
+
+namespace {
+
+// remaining wait below which wait_until yields in a loop rather than sleeps
+constexpr std::chrono::microseconds SpinThreshold{100};  // NOLINT
+
+}  // namespace
+
+ArrivalSchedule::ArrivalSchedule(const LoadProfile& profile) :
+  m_arrival(profile.arrival),
+  m_interval_ns(1e9 / profile.rate_per_second),
+  m_generator(profile.seed),
+  m_exponential(1.0)
+{
+    CHECK_GT(profile.rate_per_second, 0.0) << "offered load must be a positive rate";
+}
+
+std::chrono::nanoseconds ArrivalSchedule::next()
+{
+    auto intended = std::chrono::nanoseconds(static_cast<std::int64_t>(m_elapsed_ns));
+    if (m_arrival == ArrivalProcess::Poisson)
+    {
+        m_elapsed_ns += m_interval_ns * m_exponential(m_generator);
+    }
+    else
+    {
+        m_elapsed_ns += m_interval_ns;
+    }
+    return intended;
+}
+
+void wait_until(TimeUtil::time_pt_t time_point)
+{
+    // suspend only the calling fiber so other fibers on this engine's thread keep running while the source waits
+    if (time_point - TimeUtil::get_current_time_point() > SpinThreshold)
+    {
+        userspace_threads::sleep_until(time_point - SpinThreshold);
+    }
+    while (TimeUtil::get_current_time_point() < time_point)
+    {
+        boost::this_fiber::yield();
+    }
+}
+
+LatencyRecorder::LatencyRecorder(LatencyHistogram histogram) : m_histogram(std::move(histogram)) {}
+
+void LatencyRecorder::record(TimeUtil::time_pt_t intended_send)
+{
+    auto now = TimeUtil::get_current_time_point();
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    m_histogram.record(std::chrono::duration_cast<std::chrono::nanoseconds>(now - intended_send));
+    m_first_intended  = std::min(m_first_intended, intended_send);
+    m_last_completion = std::max(m_last_completion, now);
+}
+
+void LatencyRecorder::reset()
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    m_histogram.reset();
+    m_first_intended  = TimeUtil::time_pt_t::max();
+    m_last_completion = TimeUtil::time_pt_t::min();
+}
+
+LatencyHistogram LatencyRecorder::histogram() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    return m_histogram;
+}
+
+std::size_t LatencyRecorder::count() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    return m_histogram.count();
+}
+
+double LatencyRecorder::elapsed_seconds() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    if (m_histogram.count() == 0)
+    {
+        return 0.0;
+    }
+    return std::chrono::duration<double>(m_last_completion - m_first_intended).count();
+}
+
+std::vector<LoadPoint> sweep_offered_load(const LoadProfile& base,
+                                          const std::vector<double>& rates_per_second,
+                                          const load_run_fn_t& run)
+{
+    std::vector<LoadPoint> curve;
+    curve.reserve(rates_per_second.size());
+
+    for (const auto& rate : rates_per_second)
+    {
+        auto profile            = base;
+        profile.rate_per_second = rate;
+
+        LatencyRecorder recorder;
+        run(profile, recorder);
+
+        CHECK_EQ(recorder.count(), profile.count) << "load run completed without recording every sample";
+        auto elapsed  = recorder.elapsed_seconds();
+        auto achieved = elapsed > 0.0 ? static_cast<double>(recorder.count()) / elapsed : 0.0;
+
+        VLOG(1) << "offered " << rate << "/s achieved " << achieved << "/s p99 "
+                << recorder.histogram().value_at_percentile(99.0) << "ns";
+        curve.push_back(LoadPoint{rate, achieved, recorder.histogram()});
+    }
+
+    return curve;
+}
+
+nlohmann::json to_json(const std::vector<LoadPoint>& curve)
+{
+    auto json = nlohmann::json::array();
+    for (const auto& point : curve)
+    {
+        auto entry             = point.histogram.to_json();
+        entry["offered_rate"]  = point.offered_rate;
+        entry["achieved_rate"] = point.achieved_rate;
+        json.push_back(std::move(entry));
+    }
+    return json;
+}
+
+}  // namespace srf::benchmarking
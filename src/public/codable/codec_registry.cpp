@@ -0,0 +1,105 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "srf/codable/codec_registry.hpp"
+
+#include "srf/exceptions/runtime_error.hpp"
+
+#include <glog/logging.h>
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace srf::codable {
+
+namespace {
+
+struct Codecs
+{
+    std::shared_mutex mutex;
+    std::unordered_map<std::size_t, Codec> codecs;
+};
+
+Codecs& codecs()
+{
+    static Codecs instance;
+    return instance;
+}
+
+}  // namespace
+
+void CodecRegistry::register_codec(std::type_index type, Codec::decode_fn_t decode_fn, Codec::encode_fn_t encode_fn)
+{
+    CHECK(decode_fn && encode_fn);
+    auto& registry = codecs();
+    std::unique_lock<decltype(registry.mutex)> lock(registry.mutex);
+
+    auto search = registry.codecs.find(type.hash_code());
+    if (search != registry.codecs.end())
+    {
+        if (search->second.type != type)
+        {
+            throw exceptions::SrfRuntimeError("codec type_index_hash collision between " +
+                                              std::string(search->second.type.name()) + " and " +
+                                              std::string(type.name()));
+        }
+        return;
+    }
+
+    registry.codecs.emplace(type.hash_code(), Codec{type, std::move(decode_fn), std::move(encode_fn)});
+}
+
+bool CodecRegistry::has_codec(std::size_t type_index_hash)
+{
+    auto& registry = codecs();
+    std::shared_lock<decltype(registry.mutex)> lock(registry.mutex);
+    return registry.codecs.find(type_index_hash) != registry.codecs.end();
+}
+
+const Codec& CodecRegistry::find_codec(std::size_t type_index_hash)
+{
+    auto& registry = codecs();
+    std::shared_lock<decltype(registry.mutex)> lock(registry.mutex);
+
+    auto search = registry.codecs.find(type_index_hash);
+    if (search == registry.codecs.end())
+    {
+        throw exceptions::SrfRuntimeError("no codec registered for type_index_hash " +
+                                          std::to_string(type_index_hash));
+    }
+    return search->second;
+}
+
+std::any CodecRegistry::decode(const EncodedObject& encoded, std::size_t object_idx)
+{
+    return find_codec(encoded.type_index_hash_for_object(object_idx)).decode(encoded, object_idx);
+}
+
+void CodecRegistry::encode(const std::any& obj, EncodedObject& encoded, const EncodingOptions& opts)
+{
+    if (!obj.has_value())
+    {
+        throw exceptions::SrfRuntimeError("unable to encode an empty std::any");
+    }
+    find_codec(std::type_index(obj.type()).hash_code()).encode(obj, encoded, opts);
+}
+
+}  // namespace srf::codable
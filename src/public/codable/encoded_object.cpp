@@ -17,18 +17,29 @@
 
 #include <srf/codable/encoded_object.hpp>
 
+#include "internal/codable/compression.hpp"
+
 #include <srf/protos/codable.pb.h>
+#include <srf/codable/encoding_options.hpp>
 #include <srf/codable/memory_resources.hpp>
+#include <srf/codable/protobuf_arena.hpp>
+#include <srf/exceptions/runtime_error.hpp>
 #include <srf/memory/block.hpp>
+#include <srf/memory/buffer.hpp>
 #include <srf/memory/memory_kind.hpp>
 #include <srf/utils/thread_local_shared_pointer.hpp>
 
 #include <google/protobuf/any.pb.h>
+#include <google/protobuf/arena.h>
 #include <google/protobuf/message.h>
 
 #include <cstdint>  // for uint64_t
-#include <memory>   // for __shared_ptr_access, shared_ptr
+#include <cstring>
+#include <memory>  // for __shared_ptr_access, shared_ptr
+#include <mutex>
 #include <ostream>  // for operator<<
+#include <utility>
+#include <vector>
 
 namespace srf::codable {
 
@@ -70,6 +81,40 @@ static protos::MemoryKind encode_memory_type(memory::memory_kind_type mem_kind)
     return protos::MemoryKind::None;
 }
 
+static protos::Compression encode_compression(CompressionAlgorithm algorithm)
+{
+    switch (algorithm)
+    {
+    case CompressionAlgorithm::lz4:
+        return protos::Compression::LZ4;
+    case CompressionAlgorithm::zstd:
+        return protos::Compression::ZSTD;
+    default:
+        LOG(FATAL) << "unhandled CompressionAlgorithm";
+    };
+
+    return protos::Compression::Uncompressed;
+}
+
+static CompressionAlgorithm decode_compression(const protos::Compression& compression)
+{
+    switch (compression)
+    {
+    case protos::Compression::LZ4:
+        return CompressionAlgorithm::lz4;
+    case protos::Compression::ZSTD:
+        return CompressionAlgorithm::zstd;
+    default:
+        LOG(ERROR) << "unhandled protos::Compression: " << static_cast<int>(compression);
+        throw exceptions::SrfRuntimeError("unhandled protos::Compression");
+    };
+}
+
+static bool is_host_memory(memory::memory_kind_type kind)
+{
+    return (kind == memory::memory_kind_type::host || kind == memory::memory_kind_type::pinned);
+}
+
 memory::block EncodedObject::decode_descriptor(const protos::RemoteDescriptor& desc)
 {
     return memory::block(
@@ -86,60 +131,192 @@ protos::RemoteDescriptor EncodedObject::encode_descriptor(memory::const_block vi
     return desc;
 }
 
+EncodedObject::EncodedObject() : EncodedObject(acquire_arena()) {}
+
+EncodedObject::EncodedObject(std::shared_ptr<google::protobuf::Arena> arena) :
+  m_arena(std::move(arena)),
+  m_proto(google::protobuf::Arena::CreateMessage<protos::EncodedObject>(m_arena.get()))
+{}
+
+EncodedObject::EncodedObject(google::protobuf::Arena& arena) :
+  m_proto(google::protobuf::Arena::CreateMessage<protos::EncodedObject>(&arena))
+{}
+
+EncodedObject::~EncodedObject()
+{
+    // arena allocated protos are destroyed with their arena
+    if (m_proto != nullptr && m_proto->GetArena() == nullptr)
+    {
+        delete m_proto;
+    }
+}
+
+EncodedObject::EncodedObject(EncodedObject&& other) noexcept :
+  m_arena(std::move(other.m_arena)),
+  m_proto(std::exchange(other.m_proto, nullptr)),
+  m_buffers(std::move(other.m_buffers)),
+  m_object_info(std::move(other.m_object_info)),
+  m_context_acquired(std::exchange(other.m_context_acquired, false)),
+  m_decompressed(std::move(other.m_decompressed))
+{}
+
+EncodedObject& EncodedObject::operator=(EncodedObject&& other) noexcept
+{
+    // other releases our previous state when it is destroyed
+    std::swap(m_arena, other.m_arena);
+    std::swap(m_proto, other.m_proto);
+    std::swap(m_buffers, other.m_buffers);
+    std::swap(m_object_info, other.m_object_info);
+    std::swap(m_context_acquired, other.m_context_acquired);
+    std::swap(m_decompressed, other.m_decompressed);
+    return *this;
+}
+
+google::protobuf::Arena* EncodedObject::arena() const
+{
+    return m_proto->GetArena();
+}
+
 const protos::EncodedObject& EncodedObject::proto() const
 {
-    return m_proto;
+    return *m_proto;
 }
 
 memory::const_block EncodedObject::memory_block(std::size_t idx) const
 {
     DCHECK_LT(idx, descriptor_count());
-    CHECK(m_proto.descriptors().at(idx).has_remote_desc());
-    return decode_descriptor(m_proto.descriptors().at(idx).remote_desc());
+    const auto& desc = m_proto->descriptors().at(idx);
+
+    memory::const_block block;
+
+    // small blocks sent with the rendezvous protocol arrive inlined as eager descriptors
+    if (desc.has_eager_desc())
+    {
+        const auto& data = desc.eager_desc().data();
+        block = memory::const_block(data.data(), data.size(), decode_memory_type(desc.eager_desc().memory_kind()));
+    }
+    else
+    {
+        CHECK(desc.has_remote_desc());
+        block = decode_descriptor(desc.remote_desc());
+    }
+
+    if (desc.compression() != protos::Compression::Uncompressed)
+    {
+        return decompressed_block(idx, block);
+    }
+    return block;
+}
+
+memory::const_block EncodedObject::decompressed_block(std::size_t idx, memory::const_block compressed) const
+{
+    const auto& desc = m_proto->descriptors().at(idx);
+    auto bytes       = desc.uncompressed_bytes();
+
+    std::lock_guard<decltype(m_decompressed_mutex)> lock(m_decompressed_mutex);
+    auto search = m_decompressed.find(idx);
+    if (search == m_decompressed.end())
+    {
+        // bytes is read off the wire; validate it against the compressed data before allocating
+        auto algorithm = decode_compression(desc.compression());
+        internal::codable::validate_decompressed_bytes(algorithm, compressed.data(), compressed.bytes(), bytes);
+
+        auto blob = utils::ThreadLocalSharedPointer<codable::MemoryResources>::get()->pooled_host_blob(bytes);
+        internal::codable::decompress(algorithm, compressed.data(), compressed.bytes(), blob.data(), bytes);
+        search = m_decompressed.emplace(idx, std::move(blob)).first;
+    }
+    return memory::const_block(search->second.data(), bytes, memory::memory_kind_type::host);
+}
+
+void EncodedObject::compress(std::size_t object_idx, const CompressionPolicy& policy)
+{
+    CHECK(!m_context_acquired);
+    if (!policy.enabled())
+    {
+        return;
+    }
+
+    thread_local std::vector<char> scratch;
+
+    auto first = start_idx_for_object(object_idx);
+    auto last  = (object_idx + 1 < object_count() ? start_idx_for_object(object_idx + 1) : descriptor_count());
+
+    for (auto idx = first; idx < last; idx++)
+    {
+        auto* desc = m_proto->mutable_descriptors(idx);
+        if (!desc->has_remote_desc() || desc->compression() != protos::Compression::Uncompressed)
+        {
+            continue;
+        }
+
+        auto block = decode_descriptor(desc->remote_desc());
+        if (!is_host_memory(block.kind()) || !policy.should_compress(block.bytes()))
+        {
+            continue;
+        }
+
+        auto bytes = internal::codable::compress(
+            policy.algorithm(), policy.level(), block.data(), block.bytes(), scratch);
+        policy.record(block.bytes(), bytes);
+        if (bytes == 0)
+        {
+            continue;
+        }
+
+        // the compressed copy replaces any buffer the object owned for this block
+        auto view = utils::ThreadLocalSharedPointer<codable::MemoryResources>::get()->host_resource_view();
+        memory::blob compressed(memory::buffer<::cuda::memory_location::host>(bytes, view));
+        std::memcpy(compressed.data(), scratch.data(), bytes);
+
+        *desc->mutable_remote_desc() = encode_descriptor(compressed);
+        desc->set_compression(encode_compression(policy.algorithm()));
+        desc->set_uncompressed_bytes(block.bytes());
+        m_buffers[idx] = std::move(compressed);
+    }
 }
 
 const protos::EagerDescriptor& EncodedObject::eager_descriptor(std::size_t idx) const
 {
     DCHECK_LT(idx, descriptor_count());
-    CHECK(m_proto.descriptors().at(idx).has_eager_desc());
-    return m_proto.descriptors().at(idx).eager_desc();
+    CHECK(m_proto->descriptors().at(idx).has_eager_desc());
+    return m_proto->descriptors().at(idx).eager_desc();
 }
 
 memory::block EncodedObject::mutable_memory_block(std::size_t idx) const
 {
     CHECK(m_context_acquired);
     DCHECK_LT(idx, descriptor_count());
-    CHECK(m_proto.descriptors().at(idx).has_remote_desc());
-    return decode_descriptor(m_proto.descriptors().at(idx).remote_desc());
+    CHECK(m_proto->descriptors().at(idx).has_remote_desc());
+    return decode_descriptor(m_proto->descriptors().at(idx).remote_desc());
 }
 
 std::size_t EncodedObject::descriptor_count() const
 {
-    return m_proto.descriptors_size();
+    return m_proto->descriptors_size();
 }
 
 std::size_t EncodedObject::object_count() const
 {
-    return m_proto.objects_size();
+    return m_proto->objects_size();
 }
 
 std::size_t EncodedObject::type_index_hash_for_object(std::size_t idx) const
 {
     DCHECK_LT(idx, object_count());
-    return m_proto.objects().at(idx).type_index_hash();
+    return m_proto->objects().at(idx).type_index_hash();
 }
 
 std::size_t EncodedObject::start_idx_for_object(std::size_t idx) const
 {
     DCHECK_LT(idx, object_count());
-    return m_proto.objects().at(idx).desc_id();
+    return m_proto->objects().at(idx).desc_id();
 }
 
 std::size_t EncodedObject::add_meta_data(const google::protobuf::Message& meta_data)
 {
     CHECK(m_context_acquired);
-    auto index = m_proto.descriptors_size();
-    auto* desc = m_proto.add_descriptors();
+    auto index = m_proto->descriptors_size();
+    auto* desc = m_proto->add_descriptors();
     desc->mutable_meta_data_desc()->mutable_meta_data()->PackFrom(meta_data);
     return index;
 }
@@ -148,7 +325,7 @@ std::size_t EncodedObject::add_memory_block(memory::const_block view)
 {
     CHECK(m_context_acquired);
     auto count = descriptor_count();
-    auto* desc = m_proto.add_descriptors()->mutable_remote_desc();
+    auto* desc = m_proto->add_descriptors()->mutable_remote_desc();
     *desc      = encode_descriptor(view);
     return count;
 }
@@ -171,7 +348,7 @@ std::size_t EncodedObject::add_eager_buffer(const void* data, std::size_t bytes)
 {
     CHECK(m_context_acquired);
     auto count                    = descriptor_count();
-    protos::EagerDescriptor* desc = m_proto.add_descriptors()->mutable_eager_desc();
+    protos::EagerDescriptor* desc = m_proto->add_descriptors()->mutable_eager_desc();
     desc->set_data(data, bytes);
     return count;
 }
@@ -193,7 +370,7 @@ EncodedObject::ContextGuard::~ContextGuard()
 void EncodedObject::add_type_index(std::type_index type_index)
 {
     CHECK(m_context_acquired);
-    auto* obj = m_proto.add_objects();
+    auto* obj = m_proto->add_objects();
     obj->set_type_index_hash(type_index.hash_code());
     obj->set_desc_id(descriptor_count());
 }
@@ -0,0 +1,147 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "srf/codable/encoding_options.hpp"
+
+#include <glog/logging.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace srf::codable {
+
+// shared by copies of a policy; updates are relaxed, so the sampled ratio is approximate under concurrency
+struct CompressionPolicy::Sampler
+{
+    Sampler(std::size_t sample_window, std::size_t probe_interval) :
+      sample_window(sample_window),
+      probe_interval(probe_interval)
+    {}
+
+    const std::size_t sample_window;
+    const std::size_t probe_interval;
+
+    std::atomic<bool> active{true};
+    std::atomic<std::uint64_t> uncompressed_bytes{0};
+    std::atomic<std::uint64_t> compressed_bytes{0};
+    std::atomic<std::uint64_t> samples{0};
+    std::atomic<std::uint64_t> skipped{0};
+};
+
+CompressionPolicy::CompressionPolicy(CompressionAlgorithm algorithm,
+                                     int level,
+                                     std::size_t min_bytes,
+                                     double min_ratio,
+                                     std::size_t sample_window,
+                                     std::size_t probe_interval) :
+  m_algorithm(algorithm),
+  m_level(level),
+  m_min_bytes(min_bytes),
+  m_min_ratio(min_ratio),
+  m_sampler(std::make_shared<Sampler>(sample_window, probe_interval))
+{
+    CHECK_GT(sample_window, 0);
+    CHECK_GT(probe_interval, 0);
+}
+
+CompressionAlgorithm CompressionPolicy::algorithm() const
+{
+    return m_algorithm;
+}
+
+int CompressionPolicy::level() const
+{
+    return m_level;
+}
+
+std::size_t CompressionPolicy::min_bytes() const
+{
+    return m_min_bytes;
+}
+
+double CompressionPolicy::min_ratio() const
+{
+    return m_min_ratio;
+}
+
+bool CompressionPolicy::enabled() const
+{
+    return m_algorithm != CompressionAlgorithm::none;
+}
+
+bool CompressionPolicy::active() const
+{
+    return enabled() && m_sampler->active.load(std::memory_order_relaxed);
+}
+
+bool CompressionPolicy::should_compress(std::size_t bytes) const
+{
+    if (!enabled() || bytes < m_min_bytes)
+    {
+        return false;
+    }
+    if (m_sampler->active.load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+    return (m_sampler->skipped.fetch_add(1, std::memory_order_relaxed) + 1) % m_sampler->probe_interval == 0;
+}
+
+void CompressionPolicy::record(std::size_t uncompressed_bytes, std::size_t compressed_bytes) const
+{
+    DCHECK(enabled());
+    auto& sampler = *m_sampler;
+
+    // a block which did not compress is accounted as stored at its original size
+    if (compressed_bytes == 0 || compressed_bytes > uncompressed_bytes)
+    {
+        compressed_bytes = uncompressed_bytes;
+    }
+
+    if (!sampler.active.load(std::memory_order_relaxed))
+    {
+        // a probe; re-enable on a good ratio and start a new window
+        if (static_cast<double>(uncompressed_bytes) >= m_min_ratio * static_cast<double>(compressed_bytes))
+        {
+            sampler.uncompressed_bytes.store(0, std::memory_order_relaxed);
+            sampler.compressed_bytes.store(0, std::memory_order_relaxed);
+            sampler.active.store(true, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    sampler.uncompressed_bytes.fetch_add(uncompressed_bytes, std::memory_order_relaxed);
+    sampler.compressed_bytes.fetch_add(compressed_bytes, std::memory_order_relaxed);
+
+    if ((sampler.samples.fetch_add(1, std::memory_order_relaxed) + 1) % sampler.sample_window == 0)
+    {
+        auto in  = sampler.uncompressed_bytes.exchange(0, std::memory_order_relaxed);
+        auto out = sampler.compressed_bytes.exchange(0, std::memory_order_relaxed);
+        if (static_cast<double>(in) < m_min_ratio * static_cast<double>(out))
+        {
+            VLOG(1) << "disabling payload compression; sampled ratio " << (out > 0 ? double(in) / out : 0.0)
+                    << " is below " << m_min_ratio;
+            sampler.skipped.store(0, std::memory_order_relaxed);
+            sampler.active.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+}  // namespace srf::codable
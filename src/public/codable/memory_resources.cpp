@@ -0,0 +1,75 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "srf/codable/memory_resources.hpp"
+
+#include "srf/memory/blob.hpp"
+#include "srf/memory/buffer.hpp"
+#include "srf/memory/buffer_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace srf::codable {
+
+namespace {
+
+// each size class pool holds at most this many bytes, and at least min_pool_buffers buffers
+constexpr std::size_t max_pool_bytes   = 64UL << 20;  // NOLINT
+constexpr std::size_t min_pool_buffers = 16;          // NOLINT
+
+}  // namespace
+
+memory::blob MemoryResources::pooled_host_blob(std::size_t bytes)
+{
+    if (bytes > max_pooled_bytes)
+    {
+        return memory::blob(memory::buffer<::cuda::memory_location::host>(bytes, host_resource_view()));
+    }
+
+    std::size_t size_class = 0;
+    while ((min_pooled_bytes << size_class) < bytes)
+    {
+        ++size_class;
+    }
+
+    std::shared_ptr<host_pool_t> pool;
+    {
+        std::lock_guard<decltype(m_host_pools_mutex)> lock(m_host_pools_mutex);
+        auto& entry = m_host_pools.at(size_class);
+        if (!entry)
+        {
+            auto class_bytes = min_pooled_bytes << size_class;
+            entry = host_pool_t::create(
+                host_resource_view(), class_bytes, 0, std::max(min_pool_buffers, max_pool_bytes / class_bytes));
+        }
+        pool = entry;
+    }
+
+    auto buffer = pool->try_acquire();
+    if (!buffer)
+    {
+        return memory::blob(memory::buffer<::cuda::memory_location::host>(bytes, host_resource_view()));
+    }
+    return memory::blob(std::move(buffer));
+}
+
+}  // namespace srf::codable
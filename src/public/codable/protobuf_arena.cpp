@@ -0,0 +1,109 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "srf/codable/protobuf_arena.hpp"
+
+#include <google/protobuf/arena.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace srf::codable {
+
+namespace {
+
+constexpr std::size_t arena_block_bytes = 8192;  // NOLINT
+constexpr std::size_t max_cached_arenas = 16;   // NOLINT
+
+google::protobuf::ArenaOptions arena_options(char* block)
+{
+    google::protobuf::ArenaOptions options;
+    options.initial_block      = block;
+    options.initial_block_size = arena_block_bytes;
+    return options;
+}
+
+struct RecycledArena  // NOLINT
+{
+    RecycledArena() : block(std::make_unique<char[]>(arena_block_bytes)), arena(arena_options(block.get())) {}
+
+    std::unique_ptr<char[]> block;
+    google::protobuf::Arena arena;
+};
+
+// trivially destructible, so releases which happen during thread teardown can detect the cache is gone
+thread_local bool t_cache_destroyed{false};
+
+struct ArenaCache  // NOLINT
+{
+    ~ArenaCache()
+    {
+        t_cache_destroyed = true;
+    }
+
+    std::vector<std::unique_ptr<RecycledArena>> arenas;
+};
+
+ArenaCache* local_cache()
+{
+    if (t_cache_destroyed)
+    {
+        return nullptr;
+    }
+    thread_local ArenaCache cache;
+    return &cache;
+}
+
+void release(RecycledArena* recycled)
+{
+    std::unique_ptr<RecycledArena> arena(recycled);
+    auto* cache = local_cache();
+    if (cache == nullptr || cache->arenas.size() == max_cached_arenas)
+    {
+        return;
+    }
+
+    // frees every block but the initial block, which is kept for the next owner
+    arena->arena.Reset();
+    cache->arenas.push_back(std::move(arena));
+}
+
+}  // namespace
+
+std::shared_ptr<google::protobuf::Arena> acquire_arena()
+{
+    std::unique_ptr<RecycledArena> recycled;
+
+    auto* cache = local_cache();
+    if (cache != nullptr && !cache->arenas.empty())
+    {
+        recycled = std::move(cache->arenas.back());
+        cache->arenas.pop_back();
+    }
+    else
+    {
+        recycled = std::make_unique<RecycledArena>();
+    }
+
+    auto* arena = &recycled->arena;
+    return std::shared_ptr<google::protobuf::Arena>(
+        arena, [recycled = recycled.release()](google::protobuf::Arena* /*unused*/) { release(recycled); });
+}
+
+}  // namespace srf::codable
@@ -26,36 +26,30 @@ namespace srf::memory {
 blob::blob()  = default;
 blob::~blob() = default;
 
-blob::blob(std::shared_ptr<IBlobStorage> view) : m_storage(std::move(view)) {}
-
-void* blob::data()
-{
-    return (m_storage ? m_storage->data() : nullptr);
-}
-
-const void* blob::data() const
-{
-    return (m_storage ? m_storage->data() : nullptr);
-}
-
-std::size_t blob::bytes() const
-{
-    return (m_storage ? m_storage->bytes() : 0UL);
-}
-
-memory_kind_type blob::kind() const
+blob::blob(std::shared_ptr<IBlobStorage> view) : m_storage(std::move(view))
 {
-    return (m_storage ? m_storage->kind() : memory_kind_type::none);
+    if (m_storage)
+    {
+        m_data  = m_storage->data();
+        m_bytes = m_storage->bytes();
+        m_kind  = m_storage->kind();
+    }
 }
 
-bool blob::empty() const
-{
-    return not bool(*this);
-}
+blob::blob(blob&& other) noexcept :
+  m_storage(std::move(other.m_storage)),
+  m_data(std::exchange(other.m_data, nullptr)),
+  m_bytes(std::exchange(other.m_bytes, 0)),
+  m_kind(std::exchange(other.m_kind, memory_kind_type::none))
+{}
 
-blob::operator bool() const
+blob& blob::operator=(blob&& other) noexcept
 {
-    return m_storage && (m_storage->data() != nullptr) && (m_storage->bytes() != 0U);
+    m_storage = std::move(other.m_storage);
+    m_data    = std::exchange(other.m_data, nullptr);
+    m_bytes   = std::exchange(other.m_bytes, 0);
+    m_kind    = std::exchange(other.m_kind, memory_kind_type::none);
+    return *this;
 }
 
 blob blob::allocate(std::size_t bytes) const
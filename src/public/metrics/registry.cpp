@@ -16,12 +16,14 @@
  */
 
 #include <srf/metrics/counter.hpp>
+#include <srf/metrics/gauge.hpp>
 #include <srf/metrics/registry.hpp>
 
 #include <glog/logging.h>
 #include <prometheus/client_metric.h>
 #include <prometheus/counter.h>
 #include <prometheus/family.h>
+#include <prometheus/gauge.h>
 #include <prometheus/registry.h>
 
 #include <map>
@@ -37,7 +39,11 @@ Registry::Registry() :
   m_throughput_counters(prometheus::BuildCounter()
                             .Name("srf_throughput_counters")
                             .Help("number of data elements passing thru a given pipeline object")
-                            .Register(*m_registry))
+                            .Register(*m_registry)),
+  m_forced_yield_counters(prometheus::BuildCounter()
+                              .Name("srf_forced_yield_counters")
+                              .Help("number of yields forced by the time-slice budget of a given pipeline object")
+                              .Register(*m_registry))
 {}
 
 Counter Registry::make_counter(std::string name, std::map<std::string, std::string> labels)
@@ -47,12 +53,25 @@ Counter Registry::make_counter(std::string name, std::map<std::string, std::stri
     return Counter(&counter);
 }
 
+Gauge Registry::make_gauge(std::string name, std::map<std::string, std::string> labels)
+{
+    auto& family = prometheus::BuildGauge().Name(std::move(name)).Register(*m_registry);
+    auto& gauge  = family.Add(std::move(labels));
+    return Gauge(&gauge);
+}
+
 Counter Registry::make_throughput_counter(std::string name)
 {
     auto& counter = m_throughput_counters.Add({{"name", name}});
     return Counter(&counter);
 }
 
+Counter Registry::make_forced_yield_counter(std::string name)
+{
+    auto& counter = m_forced_yield_counters.Add({{"name", name}});
+    return Counter(&counter);
+}
+
 std::vector<CounterReport> Registry::collect_throughput_counters() const
 {
     std::vector<CounterReport> report;
@@ -65,4 +84,16 @@ std::vector<CounterReport> Registry::collect_throughput_counters() const
     return report;
 }
 
+std::vector<CounterReport> Registry::collect_forced_yield_counters() const
+{
+    std::vector<CounterReport> report;
+    auto collected = m_forced_yield_counters.Collect();
+    CHECK_EQ(collected.size(), 1);
+    for (auto& metric : collected[0].metric)
+    {
+        report.emplace_back(metric.label.at(0).value, metric.counter.value);
+    }
+    return report;
+}
+
 }  // namespace srf::metrics
@@ -22,6 +22,7 @@
 #include <glog/logging.h>
 #include <boost/fiber/fss.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <exception>
 #include <sstream>
@@ -93,6 +94,53 @@ void Context::yield()
     do_yield();
 }
 
+bool Context::time_slice_tick()
+{
+    if (!m_time_slice.enabled())
+    {
+        return false;
+    }
+
+    bool exhausted = (m_time_slice.max_items != 0 && ++m_slice_items >= m_time_slice.max_items);
+    if (!exhausted && m_time_slice.max_duration.count() != 0)
+    {
+        exhausted = (std::chrono::steady_clock::now() - m_slice_start >= m_time_slice.max_duration);
+    }
+
+    if (!exhausted)
+    {
+        return false;
+    }
+
+    ++m_forced_yields;
+    if (m_on_forced_yield)
+    {
+        m_on_forced_yield();
+    }
+    do_yield();
+    time_slice_reset();
+    return true;
+}
+
+void Context::time_slice_reset()
+{
+    m_slice_items = 0;
+    if (m_time_slice.max_duration.count() != 0)
+    {
+        m_slice_start = std::chrono::steady_clock::now();
+    }
+}
+
+bool Context::time_slice_enabled() const
+{
+    return m_time_slice.enabled();
+}
+
+std::size_t Context::forced_yields() const
+{
+    return m_forced_yields;
+}
+
 void Context::init(const Runner& runner)
 {
     auto& fiber_local = FiberLocalContext::get();
@@ -104,6 +152,14 @@ void Context::init(const Runner& runner)
     m_info = ss.str();
 
     m_runner = &runner;
+
+    time_slice_reset();
+}
+
+void Context::init_time_slice(TimeSliceOptions time_slice, std::function<void()> on_forced_yield)
+{
+    m_time_slice      = std::move(time_slice);
+    m_on_forced_yield = std::move(on_forced_yield);
 }
 
 void Context::finish()
@@ -140,6 +196,12 @@ Context& Context::get_runtime_context()
     return *fiber_local->m_context;
 }
 
+bool Context::has_runtime_context()
+{
+    auto& fiber_local = FiberLocalContext::get();
+    return (fiber_local.get() != nullptr && fiber_local->m_context != nullptr);
+}
+
 void Context::init_info(std::stringstream& ss)
 {
     ss << "rank: " << rank() << "; size: " << size();
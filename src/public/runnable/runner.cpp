@@ -107,6 +107,7 @@ void Runner::enqueue(std::shared_ptr<Engines> launcher, std::vector<std::shared_
             m_instances[i].m_live_future = m_instances[i].m_live_promise.get_future().share();
             m_instances[i].m_context     = contexts[i];
             m_instances[i].m_engine      = launcher->launchers()[i];
+            contexts[i]->init_time_slice(launcher->launch_options().time_slice, m_forced_yield_callback);
             update_state(contexts[i]->rank(), State::Queued);
         }
 
@@ -241,6 +242,12 @@ SharedFuture<void> Runner::Instance::join_future() const
     return m_join_future;
 }
 
+std::size_t Runner::Instance::forced_yields() const
+{
+    CHECK(m_context);
+    return m_context->forced_yields();
+}
+
 void Runner::on_instance_state_change_callback(on_instance_state_change_t callback)
 {
     CHECK(m_on_instance_state_change == nullptr);
@@ -258,4 +265,10 @@ void Runner::on_completion_callback(on_completion_callback_t callback)
     CHECK(m_completion_callback == nullptr);
     m_completion_callback = callback;
 }
+
+void Runner::on_forced_yield_callback(on_forced_yield_callback_t callback)
+{
+    CHECK(m_forced_yield_callback == nullptr);
+    m_forced_yield_callback = callback;
+}
 }  // namespace srf::runnable
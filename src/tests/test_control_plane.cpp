@@ -0,0 +1,457 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "internal/control_plane/assignment_oracle.hpp"
+
+#include <srf/protos/architect.pb.h>
+#include <srf/types.hpp>
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace srf;
+using namespace srf::internal;
+using namespace std::chrono_literals;
+
+namespace {
+
+protos::SegmentAssignment make_assignment(SegmentAddress address,
+                                          MachineID machine_id,
+                                          std::vector<SegmentAddress> egress_targets = {})
+{
+    protos::SegmentAssignment assignment;
+    assignment.set_address(address);
+    assignment.set_machine_id(machine_id);
+    assignment.set_instance_id(machine_id);
+    if (!egress_targets.empty())
+    {
+        auto& policy = (*assignment.mutable_egress_polices())[0];
+        for (const auto& target : egress_targets)
+        {
+            policy.add_segment_addresses(target);
+        }
+    }
+    return assignment;
+}
+
+/**
+ * @brief Stand-in for a machine's control plane client; applies each update and takes part in the update barrier from
+ * its own thread
+ */
+class InProcessClient
+{
+  public:
+    InProcessClient(MachineID machine_id, control_plane::AssignmentOracle& oracle) :
+      m_machine_id(machine_id),
+      m_oracle(oracle),
+      m_thread([this] { run(); })
+    {}
+
+    ~InProcessClient()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = false;
+            m_cv.notify_all();
+        }
+        m_thread.join();
+    }
+
+    void push(protos::UpdateAssignments&& update)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_updates.push(std::move(update));
+        m_cv.notify_all();
+    }
+
+    std::size_t updates_applied() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_updates_applied;
+    }
+
+    std::set<SegmentAddress> segments() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_segments;
+    }
+
+  private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_cv.wait(lock, [this] { return !m_running || !m_updates.empty(); });
+            if (m_updates.empty())
+            {
+                return;
+            }
+            auto update = std::move(m_updates.front());
+            m_updates.pop();
+            lock.unlock();
+
+            std::promise<void> started;
+            m_oracle.on_update_start(m_machine_id, [&started] { started.set_value(); });
+            started.get_future().get();
+
+            lock.lock();
+            for (const auto& address : update.removed_segment_addresses())
+            {
+                m_segments.erase(address);
+            }
+            for (const auto& assignment : update.assignments())
+            {
+                if (assignment.machine_id() == m_machine_id)
+                {
+                    m_segments.insert(assignment.address());
+                }
+            }
+            ++m_updates_applied;
+            lock.unlock();
+
+            std::promise<void> completed;
+            m_oracle.on_update_complete(m_machine_id, [&completed] { completed.set_value(); });
+            completed.get_future().get();
+
+            lock.lock();
+        }
+    }
+
+    const MachineID m_machine_id;
+    control_plane::AssignmentOracle& m_oracle;
+    std::queue<protos::UpdateAssignments> m_updates;
+    std::size_t m_updates_applied{0};
+    std::set<SegmentAddress> m_segments;
+    bool m_running{true};
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_thread;
+};
+
+}  // namespace
+
+class TestControlPlane : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_oracle = std::make_unique<control_plane::AssignmentOracle>(
+            [this]() -> std::optional<control_plane::SegmentAssignments> {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_evaluations;
+                return m_state;
+            },
+            [this](MachineID machine_id, protos::UpdateAssignments&& update) {
+                if (machine_id >= m_clients.size())
+                {
+                    return false;
+                }
+                m_clients[machine_id]->push(std::move(update));
+                return true;
+            },
+            control_plane::BatchingWindow(5ms, 80ms));
+
+        for (MachineID id = 0; id < 4; id++)
+        {
+            m_clients.push_back(std::make_unique<InProcessClient>(id, *m_oracle));
+        }
+    }
+
+    void TearDown() override
+    {
+        m_oracle->shutdown();
+        m_clients.clear();
+        m_oracle.reset();
+    }
+
+    void enqueue(std::function<void(control_plane::SegmentAssignments&)> mutation)
+    {
+        m_oracle->enqueue([this, mutation] {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            mutation(m_state);
+        });
+    }
+
+    // wait until the oracle has issued count updates and the last of them has completed
+    void await_updates(std::size_t count)
+    {
+        auto deadline = std::chrono::steady_clock::now() + 10s;
+        while (m_oracle->updates_issued() < count && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+        ASSERT_EQ(m_oracle->updates_issued(), count);
+
+        // the next evaluation only happens once the previous update completed
+        enqueue([](control_plane::SegmentAssignments&) {});
+        auto evaluations = current_evaluations();
+        while (current_evaluations() == evaluations && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+
+    std::size_t current_evaluations()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_evaluations;
+    }
+
+    std::mutex m_mutex;
+    control_plane::SegmentAssignments m_state;
+    std::size_t m_evaluations{0};
+    std::vector<std::unique_ptr<InProcessClient>> m_clients;
+    std::unique_ptr<control_plane::AssignmentOracle> m_oracle;
+};
+
+TEST_F(TestControlPlane, AssignmentDelta)
+{
+    control_plane::SegmentAssignments previous;
+    previous[1] = make_assignment(1, 0, {2});
+    previous[2] = make_assignment(2, 1);
+    previous[3] = make_assignment(3, 2);
+    previous[4] = make_assignment(4, 3);
+
+    // unchanged state issues no updates
+    EXPECT_TRUE(control_plane::compute_assignment_delta(previous, previous).updates.empty());
+
+    // segment 2 moves from machine 1 to machine 3; machine 0 egresses to segment 2; machine 2 is unaffected
+    auto current = previous;
+    current[2]   = make_assignment(2, 3);
+
+    auto delta = control_plane::compute_assignment_delta(previous, current);
+    EXPECT_EQ(delta.participants(), (std::set<MachineID>{0, 1, 3}));
+
+    ASSERT_EQ(delta.updates[0].assignments_size(), 1);
+    EXPECT_EQ(delta.updates[0].assignments(0).machine_id(), 3);
+    EXPECT_EQ(delta.updates[0].removed_segment_addresses_size(), 0);
+
+    ASSERT_EQ(delta.updates[1].removed_segment_addresses_size(), 1);
+    EXPECT_EQ(delta.updates[1].removed_segment_addresses(0), 2);
+    EXPECT_EQ(delta.updates[1].assignments_size(), 0);
+
+    ASSERT_EQ(delta.updates[3].assignments_size(), 1);
+    EXPECT_EQ(delta.updates[3].assignments(0).address(), 2);
+
+    // removing segment 4 only involves its owner
+    current.erase(4);
+    delta = control_plane::compute_assignment_delta(previous, current);
+    EXPECT_EQ(delta.participants(), (std::set<MachineID>{0, 1, 3}));
+    ASSERT_EQ(delta.updates[3].removed_segment_addresses_size(), 1);
+    EXPECT_EQ(delta.updates[3].removed_segment_addresses(0), 4);
+
+    // a new segment on machine 2 egresses to segment 3, which is unchanged; only machine 2 takes part and it learns the
+    // location of segment 3
+    current    = previous;
+    current[5] = make_assignment(5, 2, {3});
+    delta      = control_plane::compute_assignment_delta(previous, current);
+    EXPECT_EQ(delta.participants(), (std::set<MachineID>{2}));
+
+    std::set<SegmentAddress> addresses;
+    for (const auto& assignment : delta.updates[2].assignments())
+    {
+        addresses.insert(assignment.address());
+    }
+    EXPECT_EQ(addresses, (std::set<SegmentAddress>{3, 5}));
+    EXPECT_EQ(delta.updates[2].removed_segment_addresses_size(), 0);
+}
+
+TEST_F(TestControlPlane, BatchingWindow)
+{
+    control_plane::BatchingWindow window(10ms, 200ms);
+    EXPECT_EQ(window.window(), 10ms);
+
+    // churn grows the window up to the maximum
+    for (int i = 0; i < 10; i++)
+    {
+        window.on_batch(5);
+    }
+    EXPECT_EQ(window.window(), 200ms);
+
+    // isolated events shrink it
+    window.on_batch(1);
+    EXPECT_EQ(window.window(), 100ms);
+
+    // an idle period of at least the maximum window resets it
+    window.on_idle(50ms);
+    EXPECT_EQ(window.window(), 100ms);
+    window.on_idle(200ms);
+    EXPECT_EQ(window.window(), 10ms);
+
+    window.on_batch(0);
+    EXPECT_EQ(window.window(), 10ms);
+}
+
+TEST_F(TestControlPlane, OnlyAffectedMachinesJoinUpdates)
+{
+    enqueue([](auto& state) {
+        for (MachineID id = 0; id < 4; id++)
+        {
+            state[id] = make_assignment(id, id);
+        }
+    });
+    await_updates(1);
+
+    for (MachineID id = 0; id < 4; id++)
+    {
+        EXPECT_EQ(m_clients[id]->updates_applied(), 1);
+        EXPECT_EQ(m_clients[id]->segments(), (std::set<SegmentAddress>{id}));
+    }
+
+    // scale a segment onto machine 2; no other machine is disturbed
+    enqueue([](auto& state) { state[10] = make_assignment(10, 2); });
+    await_updates(2);
+
+    EXPECT_EQ(m_clients[0]->updates_applied(), 1);
+    EXPECT_EQ(m_clients[1]->updates_applied(), 1);
+    EXPECT_EQ(m_clients[2]->updates_applied(), 2);
+    EXPECT_EQ(m_clients[3]->updates_applied(), 1);
+    EXPECT_EQ(m_clients[2]->segments(), (std::set<SegmentAddress>{2, 10}));
+
+    // move the segment to machine 3 which machine 0 egresses to
+    enqueue([](auto& state) {
+        state[0]  = make_assignment(0, 0, {10});
+        state[10] = make_assignment(10, 3);
+    });
+    await_updates(3);
+
+    EXPECT_EQ(m_clients[0]->updates_applied(), 2);
+    EXPECT_EQ(m_clients[1]->updates_applied(), 1);
+    EXPECT_EQ(m_clients[2]->updates_applied(), 3);
+    EXPECT_EQ(m_clients[3]->updates_applied(), 2);
+    EXPECT_EQ(m_clients[2]->segments(), (std::set<SegmentAddress>{2}));
+    EXPECT_EQ(m_clients[3]->segments(), (std::set<SegmentAddress>{3, 10}));
+}
+
+TEST_F(TestControlPlane, ChurnIsBatched)
+{
+    constexpr SegmentAddress events = 64;
+
+    // a burst of scaling events is folded into far fewer updates
+    for (SegmentAddress address = 0; address < events; address++)
+    {
+        enqueue([address](auto& state) { state[address] = make_assignment(address, address % 4); });
+        std::this_thread::sleep_for(1ms);
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (m_clients[0]->segments().size() + m_clients[1]->segments().size() + m_clients[2]->segments().size() +
+                   m_clients[3]->segments().size() <
+               events &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    for (MachineID id = 0; id < 4; id++)
+    {
+        EXPECT_EQ(m_clients[id]->segments().size(), events / 4);
+    }
+
+    VLOG(1) << events << " events applied with " << m_oracle->updates_issued() << " updates";
+    EXPECT_LT(m_oracle->updates_issued(), events / 4);
+    EXPECT_GT(m_oracle->batching_window(), 5ms);
+}
+
+TEST_F(TestControlPlane, RemovedMachineReleasesBarrier)
+{
+    enqueue([](auto& state) {
+        for (MachineID id = 0; id < 5; id++)
+        {
+            state[id] = make_assignment(id, id);
+        }
+    });
+
+    // machine 4 has no client; its update cannot be issued and it must not block the others
+    await_updates(1);
+    for (MachineID id = 0; id < 4; id++)
+    {
+        EXPECT_EQ(m_clients[id]->updates_applied(), 1);
+    }
+}
+
+TEST_F(TestControlPlane, LateArrivalsAreIgnored)
+{
+    std::atomic<std::size_t> releases{0};
+    auto release = [&releases] { ++releases; };
+
+    // no update is in flight
+    m_oracle->on_update_start(0, release);
+    EXPECT_FALSE(m_oracle->on_update_complete(0, release));
+    EXPECT_EQ(releases, 0);
+
+    // machines 0 and 1 take part in an update; machine 1 never arrives and is dropped mid-barrier
+    std::promise<void> issued;
+    control_plane::AssignmentOracle oracle(
+        []() -> std::optional<control_plane::SegmentAssignments> {
+            control_plane::SegmentAssignments state;
+            state[0] = make_assignment(0, 0);
+            state[1] = make_assignment(1, 1);
+            return state;
+        },
+        [&issued](MachineID machine_id, protos::UpdateAssignments&& update) {
+            if (machine_id == 1)
+            {
+                issued.set_value();
+            }
+            return true;
+        },
+        control_plane::BatchingWindow(1ms, 10ms));
+
+    oracle.enqueue([] {});
+    issued.get_future().get();
+
+    oracle.on_update_start(0, release);
+    EXPECT_EQ(releases, 0);
+
+    // a complete before the start phase has been released is ignored
+    EXPECT_FALSE(oracle.on_update_complete(0, release));
+
+    oracle.remove_machine(1);
+    EXPECT_EQ(releases, 1);
+
+    // late arrivals from the dropped machine and a duplicate arrival from machine 0 are ignored
+    oracle.on_update_start(1, release);
+    oracle.on_update_start(0, release);
+    EXPECT_FALSE(oracle.on_update_complete(1, release));
+    EXPECT_EQ(releases, 1);
+
+    EXPECT_TRUE(oracle.on_update_complete(0, release));
+    EXPECT_EQ(releases, 2);
+
+    // the update is complete; a late complete from the dropped machine is ignored
+    EXPECT_FALSE(oracle.on_update_complete(1, release));
+    EXPECT_EQ(releases, 2);
+    EXPECT_EQ(oracle.updates_issued(), 1);
+}
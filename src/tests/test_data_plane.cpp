@@ -0,0 +1,319 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/data_plane/buffer_pool.hpp"
+#include "internal/data_plane/frame.hpp"
+#include "internal/data_plane/remote_descriptor_manager.hpp"
+#include "internal/ucx/all.hpp"
+
+#include <srf/protos/codable.pb.h>
+#include <srf/memory/blob.hpp>
+#include <srf/types.hpp>
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <ucp/api/ucp.h>
+#include <ucs/type/status.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace srf;
+using namespace srf::internal;
+
+class TestDataPlane : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_context = std::make_shared<ucx::Context>();
+    }
+    void TearDown() override {}
+
+    Handle<ucx::Context> m_context;
+};
+
+TEST_F(TestDataPlane, BufferPoolSizeClasses)
+{
+    auto pool = data_plane::BufferPool::create(nullptr, 256, 4096);
+
+    EXPECT_EQ(pool->size_class_count(), 5);
+    EXPECT_EQ(pool->size_class_for(0), 0);
+    EXPECT_EQ(pool->size_class_for(1), 0);
+    EXPECT_EQ(pool->size_class_for(256), 0);
+    EXPECT_EQ(pool->size_class_for(257), 1);
+    EXPECT_EQ(pool->size_class_for(4096), 4);
+    EXPECT_EQ(pool->size_class_for(4097), data_plane::BufferPool::unpooled);
+    EXPECT_EQ(pool->size_class_bytes(2), 1024);
+    EXPECT_FALSE(pool->is_registered());
+}
+
+TEST_F(TestDataPlane, BufferPoolRecycle)
+{
+    auto pool = data_plane::BufferPool::create(nullptr, 256, 4096, 4096);
+
+    auto buffer = pool->acquire(300);
+    EXPECT_TRUE(buffer);
+    EXPECT_EQ(buffer.bytes(), 300);
+    EXPECT_EQ(buffer.capacity(), 512);
+    EXPECT_EQ(pool->slab_count(), 1);
+
+    auto free_count = pool->free_count(1);
+    void* data      = buffer.data();
+    std::memset(data, 0xff, buffer.capacity());
+
+    buffer.release();
+    EXPECT_FALSE(buffer);
+    EXPECT_EQ(pool->free_count(1), free_count + 1);
+
+    // the most recently released buffer is reused first
+    auto reused = pool->acquire(400);
+    EXPECT_EQ(reused.data(), data);
+    EXPECT_EQ(pool->slab_count(), 1);
+}
+
+TEST_F(TestDataPlane, BufferPoolUnpooled)
+{
+    auto pool   = data_plane::BufferPool::create(nullptr, 256, 4096);
+    auto buffer = pool->acquire(1 << 20);
+    EXPECT_TRUE(buffer);
+    EXPECT_EQ(buffer.capacity(), 1 << 20);
+    EXPECT_EQ(pool->slab_count(), 0);
+}
+
+TEST_F(TestDataPlane, BufferPoolBlob)
+{
+    auto pool = data_plane::BufferPool::create(nullptr, 256, 4096, 4096);
+
+    auto buffer     = pool->acquire(128);
+    auto free_count = pool->free_count(0);
+    void* data      = buffer.data();
+
+    {
+        memory::blob blob(std::move(buffer));
+        auto copy = blob;
+        EXPECT_EQ(blob.data(), data);
+        EXPECT_EQ(blob.bytes(), 128);
+        EXPECT_EQ(blob.kind(), memory::memory_kind_type::host);
+        EXPECT_EQ(pool->free_count(0), free_count);
+    }
+
+    // last blob dropped - buffer returned to the pool
+    EXPECT_EQ(pool->free_count(0), free_count + 1);
+}
+
+TEST_F(TestDataPlane, FrameRoundTrip)
+{
+    auto pool = data_plane::BufferPool::create(nullptr, 256, 4096, 4096);
+
+    data_plane::FrameWriter writer(pool->acquire(1024));
+    for (std::uint8_t i = 0; i < 5; i++)
+    {
+        auto* payload = writer.append(100 + i, 13 + i);
+        std::memset(payload, i, 13 + i);
+    }
+    while (writer.can_append(40))
+    {
+        writer.append(7, 40);
+    }
+    EXPECT_LE(writer.bytes(), 1024);
+
+    auto record_count = writer.record_count();
+    auto frame        = writer.finalize();
+    EXPECT_FALSE(writer.can_append(0));
+
+    std::size_t count = 0;
+    auto valid        = data_plane::for_each_frame_record(
+        frame.data(), frame.bytes(), [&](PortAddress port_address, const void* data, std::size_t bytes) {
+            if (count < 5)
+            {
+                EXPECT_EQ(port_address, 100 + count);
+                EXPECT_EQ(bytes, 13 + count);
+                EXPECT_EQ(static_cast<const std::uint8_t*>(data)[bytes - 1], count);
+            }
+            else
+            {
+                EXPECT_EQ(port_address, 7);
+                EXPECT_EQ(bytes, 40);
+            }
+            count++;
+        });
+    EXPECT_TRUE(valid);
+    EXPECT_EQ(count, record_count);
+
+    // a truncated frame is rejected without dispatching the records preceding the truncated one
+    count = 0;
+    EXPECT_FALSE(data_plane::for_each_frame_record(
+        frame.data(), frame.bytes() - 8, [&](PortAddress, const void*, std::size_t) { count++; }));
+    EXPECT_EQ(count, 0);
+
+    // a corrupt record length which would overflow offset + length is rejected
+    data_plane::FrameRecordHeader corrupt{7, std::numeric_limits<std::uint64_t>::max() - 8};
+    std::memcpy(static_cast<std::byte*>(frame.data()) + sizeof(data_plane::FrameHeader), &corrupt, sizeof(corrupt));
+    count = 0;
+    EXPECT_FALSE(data_plane::for_each_frame_record(
+        frame.data(), frame.bytes(), [&](PortAddress, const void*, std::size_t) { count++; }));
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(TestDataPlane, FrameSliceBlob)
+{
+    auto pool = data_plane::BufferPool::create(nullptr, 256, 4096, 4096);
+
+    data_plane::FrameWriter writer(pool->acquire(1024));
+    writer.append(1, 64);
+    writer.append(2, 64);
+    auto frame      = std::make_shared<data_plane::PooledBuffer>(writer.finalize());
+    auto free_count = pool->free_count(2);
+
+    std::vector<memory::blob> blobs;
+    data_plane::for_each_frame_record(
+        frame->data(), frame->bytes(), [&](PortAddress port_address, const void* data, std::size_t bytes) {
+            blobs.emplace_back(data_plane::FrameSlice{frame, const_cast<void*>(data), bytes});
+        });
+    frame.reset();
+
+    ASSERT_EQ(blobs.size(), 2);
+    EXPECT_EQ(blobs[0].bytes(), 64);
+    EXPECT_EQ(static_cast<std::byte*>(blobs[1].data()) - static_cast<std::byte*>(blobs[0].data()),
+              data_plane::FrameWriter::record_bytes(64));
+
+    // the frame is recycled only after the last record is released
+    blobs.pop_back();
+    EXPECT_EQ(pool->free_count(2), free_count);
+    blobs.clear();
+    EXPECT_EQ(pool->free_count(2), free_count + 1);
+}
+
+TEST_F(TestDataPlane, BufferPoolTaggedLoopback)
+{
+    auto pool = data_plane::BufferPool::create(m_context);
+    EXPECT_TRUE(pool->is_registered());
+
+    auto recv_worker = std::make_shared<ucx::Worker>(m_context);
+    auto send_worker = std::make_shared<ucx::Worker>(m_context);
+    auto ep          = send_worker->create_endpoint(recv_worker->address());
+
+    std::vector<std::uint64_t> payload(512);
+    for (std::size_t i = 0; i < payload.size(); i++)
+    {
+        payload[i] = i;
+    }
+    const std::size_t bytes = payload.size() * sizeof(std::uint64_t);
+
+    ucp_request_param_t send_params;
+    std::memset(&send_params, 0, sizeof(send_params));
+    auto* send_request = ucp_tag_send_nbx(ep->handle(), payload.data(), bytes, 42, &send_params);
+    ASSERT_FALSE(UCS_PTR_IS_ERR(send_request));
+
+    ucp_tag_recv_info_t msg_info;
+    ucp_tag_message_h msg = nullptr;
+    while (msg == nullptr)
+    {
+        send_worker->progress();
+        recv_worker->progress();
+        msg = ucp_tag_probe_nb(recv_worker->handle(), 0, 0, 1, &msg_info);
+    }
+    EXPECT_EQ(msg_info.length, bytes);
+
+    auto buffer = pool->acquire(msg_info.length);
+
+    ucp_request_param_t recv_params;
+    std::memset(&recv_params, 0, sizeof(recv_params));
+    auto* recv_request = ucp_tag_msg_recv_nbx(recv_worker->handle(), buffer.data(), buffer.bytes(), msg, &recv_params);
+    ASSERT_FALSE(UCS_PTR_IS_ERR(recv_request));
+
+    while ((recv_request != nullptr && ucp_request_check_status(recv_request) == UCS_INPROGRESS) ||
+           (send_request != nullptr && ucp_request_check_status(send_request) == UCS_INPROGRESS))
+    {
+        send_worker->progress();
+        recv_worker->progress();
+    }
+
+    if (recv_request != nullptr)
+    {
+        ucp_request_free(recv_request);
+    }
+    if (send_request != nullptr)
+    {
+        ucp_request_free(send_request);
+    }
+
+    EXPECT_EQ(std::memcmp(buffer.data(), payload.data(), bytes), 0);
+}
+
+TEST_F(TestDataPlane, RemoteDescriptorRendezvousGet)
+{
+    auto manager = std::make_shared<data_plane::RemoteDescriptorManager>(42, m_context);
+
+    auto source = std::make_shared<std::vector<std::uint64_t>>(4096);
+    for (std::size_t i = 0; i < source->size(); i++)
+    {
+        (*source)[i] = i;
+    }
+    const std::size_t bytes = source->size() * sizeof(std::uint64_t);
+
+    codable::protos::RemoteDescriptor desc;
+    desc.set_remote_address(reinterpret_cast<std::uint64_t>(source->data()));
+    desc.set_remote_bytes(bytes);
+
+    std::weak_ptr<std::vector<std::uint64_t>> weak_source = source;
+    auto object_id                                        = manager->register_descriptor(desc, std::move(source));
+    EXPECT_EQ(desc.instance_id(), 42);
+    EXPECT_EQ(desc.object_id(), object_id);
+    EXPECT_FALSE(desc.remote_key().empty());
+    EXPECT_EQ(manager->size(), 1);
+
+    // the manager holds the owner until the descriptor is released
+    EXPECT_FALSE(weak_source.expired());
+
+    // pull the memory with an rdma get from a second worker
+    auto src_worker = std::make_shared<ucx::Worker>(m_context);
+    auto dst_worker = std::make_shared<ucx::Worker>(m_context);
+    auto ep         = dst_worker->create_endpoint(src_worker->address());
+
+    ucp_rkey_h rkey;
+    ASSERT_EQ(ucp_ep_rkey_unpack(ep->handle(), desc.remote_key().data(), &rkey), UCS_OK);
+
+    std::vector<std::uint64_t> destination(4096, 0);
+    ucp_request_param_t params;
+    std::memset(&params, 0, sizeof(params));
+    auto* request = ucp_get_nbx(ep->handle(), destination.data(), bytes, desc.remote_address(), rkey, &params);
+    ASSERT_FALSE(UCS_PTR_IS_ERR(request));
+    while (request != nullptr && ucp_request_check_status(request) == UCS_INPROGRESS)
+    {
+        dst_worker->progress();
+        src_worker->progress();
+    }
+    if (request != nullptr)
+    {
+        ucp_request_free(request);
+    }
+    ucp_rkey_destroy(rkey);
+
+    EXPECT_EQ(std::memcmp(destination.data(), weak_source.lock()->data(), bytes), 0);
+
+    EXPECT_TRUE(manager->release(object_id));
+    EXPECT_EQ(manager->size(), 0);
+    EXPECT_TRUE(weak_source.expired());
+
+    // a duplicate release is dropped
+    EXPECT_FALSE(manager->release(object_id));
+}
@@ -0,0 +1,513 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "srf/memory/blob.hpp"
+#include "srf/memory/blob_storage.hpp"
+#include "srf/memory/buffer_pool.hpp"
+#include "srf/memory/literals.hpp"
+#include "srf/memory/resources/arena_resource.hpp"
+#include "srf/memory/resources/budget_resource.hpp"
+#include "srf/memory/resources/host/hugepage_memory_resource.hpp"
+#include "srf/memory/resources/host/malloc_memory_resource.hpp"
+#include "srf/memory/resources/statistics_resource.hpp"
+#include "srf/metrics/registry.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <map>
+#include <memory>
+#include <new>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace srf;
+using namespace srf::memory::literals;
+
+namespace {
+
+class CountingStorage final : public memory::IBlobStorage
+{
+  public:
+    CountingStorage(std::size_t bytes) : m_bytes(bytes), m_data(std::make_unique<std::byte[]>(bytes)) {}
+
+    mutable std::size_t calls{0};
+
+  private:
+    void* do_data() final
+    {
+        ++calls;
+        return m_data.get();
+    }
+
+    const void* do_data() const final
+    {
+        ++calls;
+        return m_data.get();
+    }
+
+    std::size_t do_bytes() const final
+    {
+        ++calls;
+        return m_bytes;
+    }
+
+    memory::memory_kind_type do_kind() const final
+    {
+        ++calls;
+        return memory::memory_kind_type::host;
+    }
+
+    std::shared_ptr<memory::IBlobStorage> do_allocate(std::size_t bytes, cudaStream_t stream) const final
+    {
+        return std::make_shared<CountingStorage>(bytes);
+    }
+
+    std::size_t m_bytes;
+    std::unique_ptr<std::byte[]> m_data;
+};
+
+}  // namespace
+
+class TestMemory : public ::testing::Test
+{};
+
+TEST_F(TestMemory, HugePageTransparent)
+{
+    memory::hugepage_memory_resource mr(memory::hugepage_memory_resource::policy::transparent, true);
+
+    void* ptr = mr.allocate(3_MiB);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % memory::hugepage_memory_resource::huge_page_size, 0);
+
+    // pre-faulted memory is zeroed and writable
+    auto* bytes = static_cast<unsigned char*>(ptr);
+    EXPECT_EQ(bytes[0], 0);
+    EXPECT_EQ(bytes[3_MiB - 1], 0);
+    std::memset(ptr, 0xff, 3_MiB);
+    EXPECT_EQ(bytes[3_MiB - 1], 0xff);
+
+    EXPECT_EQ(mr.hugetlb_bytes(), 0);
+    mr.deallocate(ptr, 3_MiB);
+}
+
+TEST_F(TestMemory, HugePageHugeTLB)
+{
+    // succeeds whether or not the host has reserved huge pages; without them, the allocation falls back
+    memory::hugepage_memory_resource mr(memory::hugepage_memory_resource::policy::hugetlb);
+
+    void* ptr = mr.allocate(1_MiB);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % memory::hugepage_memory_resource::huge_page_size, 0);
+    EXPECT_TRUE(mr.hugetlb_bytes() == 0 || mr.hugetlb_bytes() == 2_MiB);
+    std::memset(ptr, 0xff, 1_MiB);
+
+    mr.deallocate(ptr, 1_MiB);
+    EXPECT_EQ(mr.hugetlb_bytes(), 0);
+}
+
+TEST_F(TestMemory, HugePageArenaUpstream)
+{
+    auto hugepage = std::make_unique<memory::hugepage_memory_resource>(
+        memory::hugepage_memory_resource::policy::transparent, true);
+    auto arena = memory::make_shared_resource<memory::arena_resource>(std::move(hugepage), 64_MiB, 128_MiB);
+
+    void* ptr = arena->allocate(1_MiB);
+    ASSERT_NE(ptr, nullptr);
+    std::memset(ptr, 0xff, 1_MiB);
+    arena->deallocate(ptr, 1_MiB);
+}
+
+TEST_F(TestMemory, StatisticsResource)
+{
+    auto malloc = std::make_unique<memory::malloc_memory_resource>();
+    auto stats  = memory::make_shared_resource<memory::statistics_resource>(std::move(malloc), 1);
+
+    std::vector<void*> small;
+    for (int i = 0; i < 4; ++i)
+    {
+        small.push_back(stats->allocate(100));
+    }
+    void* large = stats->allocate(4_KiB);
+
+    auto snapshot = stats->statistics();
+    EXPECT_EQ(snapshot.allocations, 5);
+    EXPECT_EQ(snapshot.allocated_bytes, 4 * 100 + 4_KiB);
+    EXPECT_EQ(snapshot.live_bytes, 4 * 100 + 4_KiB);
+    EXPECT_EQ(snapshot.size_histogram[6], 4);
+    EXPECT_EQ(snapshot.size_histogram[12], 1);
+
+    stats->deallocate(large, 4_KiB);
+    for (auto* ptr : small)
+    {
+        stats->deallocate(ptr, 100);
+    }
+
+    snapshot = stats->statistics();
+    EXPECT_EQ(snapshot.deallocations, 5);
+    EXPECT_EQ(snapshot.live_bytes, 0);
+    EXPECT_EQ(snapshot.peak_bytes, 4 * 100 + 4_KiB);
+
+    // a sample rate of 1 samples every allocation
+    EXPECT_EQ(snapshot.sampled_lifetimes, 5);
+}
+
+TEST_F(TestMemory, StatisticsResourceConcurrent)
+{
+    auto malloc = std::make_unique<memory::malloc_memory_resource>();
+    auto stats  = memory::make_shared_resource<memory::statistics_resource>(std::move(malloc));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&stats] {
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto* ptr = stats->allocate(64);
+                stats->deallocate(ptr, 64);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto snapshot = stats->statistics();
+    EXPECT_EQ(snapshot.allocations, 4000);
+    EXPECT_EQ(snapshot.deallocations, 4000);
+    EXPECT_EQ(snapshot.size_histogram[6], 4000);
+    EXPECT_EQ(snapshot.live_bytes, 0);
+    EXPECT_GE(snapshot.peak_bytes, 64);
+    EXPECT_LE(snapshot.peak_bytes, 4 * 64);
+}
+
+TEST_F(TestMemory, StatisticsResourceMetrics)
+{
+    metrics::Registry registry;
+    auto malloc = std::make_unique<memory::malloc_memory_resource>();
+    auto stats  = memory::make_shared_resource<memory::statistics_resource>(std::move(malloc));
+    stats->register_metrics(registry);
+
+    void* ptr = stats->allocate(1_KiB);
+    stats->update_metrics();
+
+    const std::map<std::string, std::string> labels{{"resource", stats->tag()}};
+    EXPECT_EQ(registry.make_gauge("srf_memory_allocations", labels).value(), 1);
+    EXPECT_EQ(registry.make_gauge("srf_memory_live_bytes", labels).value(), 1_KiB);
+    EXPECT_EQ(
+        registry.make_gauge("srf_memory_size_class_allocations", {{"resource", stats->tag()}, {"size_class", "1024"}})
+            .value(),
+        1);
+
+    stats->deallocate(ptr, 1_KiB);
+    stats->update_metrics();
+    EXPECT_EQ(registry.make_gauge("srf_memory_live_bytes", labels).value(), 0);
+    EXPECT_EQ(registry.make_gauge("srf_memory_peak_bytes", labels).value(), 1_KiB);
+}
+
+TEST_F(TestMemory, BudgetResourceShed)
+{
+    using budget_t = memory::budget_resource<std::unique_ptr<memory::malloc_memory_resource>>;
+
+    auto malloc = std::make_unique<memory::malloc_memory_resource>();
+    auto budget = memory::make_shared_resource<memory::budget_resource>(
+        std::move(malloc), 1_MiB, budget_t::overflow_policy::shed);
+
+    void* a = budget->allocate(512_KiB);
+    void* b = budget->allocate(512_KiB);
+    EXPECT_EQ(budget->outstanding_bytes(), 1_MiB);
+    EXPECT_TRUE(budget->above_high_watermark());
+
+    EXPECT_THROW(budget->allocate(1), std::bad_alloc);
+    EXPECT_EQ(budget->shed_allocations(), 1);
+
+    budget->deallocate(a, 512_KiB);
+    void* c = budget->allocate(256_KiB);
+    EXPECT_EQ(budget->outstanding_bytes(), 768_KiB);
+
+    budget->deallocate(b, 512_KiB);
+    budget->deallocate(c, 256_KiB);
+    EXPECT_EQ(budget->outstanding_bytes(), 0);
+    EXPECT_FALSE(budget->above_high_watermark());
+}
+
+TEST_F(TestMemory, BudgetResourceBlock)
+{
+    using budget_t = memory::budget_resource<std::unique_ptr<memory::malloc_memory_resource>>;
+
+    auto malloc = std::make_unique<memory::malloc_memory_resource>();
+    auto budget = memory::make_shared_resource<memory::budget_resource>(std::move(malloc), 1_MiB);
+
+    void* a = budget->allocate(1_MiB);
+
+    // an allocation which can never fit is shed rather than blocking forever
+    EXPECT_THROW(budget->allocate(2_MiB), std::bad_alloc);
+
+    std::atomic<bool> allocated{false};
+    std::thread waiter([&] {
+        void* b = budget->allocate(512_KiB);
+        allocated = true;
+        budget->deallocate(b, 512_KiB);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(allocated);
+
+    budget->deallocate(a, 1_MiB);
+    waiter.join();
+
+    EXPECT_TRUE(allocated);
+    EXPECT_EQ(budget->blocked_allocations(), 1);
+    EXPECT_EQ(budget->outstanding_bytes(), 0);
+
+    // with a timeout, a blocked allocation is shed once the timeout expires
+    malloc     = std::make_unique<memory::malloc_memory_resource>();
+    auto timed = memory::make_shared_resource<memory::budget_resource>(
+        std::move(malloc), 1_MiB, budget_t::overflow_policy::block, std::chrono::milliseconds(10));
+    void* c = timed->allocate(1_MiB);
+    EXPECT_THROW(timed->allocate(1_KiB), std::bad_alloc);
+    EXPECT_EQ(timed->blocked_allocations(), 1);
+    EXPECT_EQ(timed->shed_allocations(), 1);
+    timed->deallocate(c, 1_MiB);
+}
+
+TEST_F(TestMemory, BlobCachesStorage)
+{
+    auto storage = std::make_shared<CountingStorage>(1_KiB);
+    memory::blob blob(std::static_pointer_cast<memory::IBlobStorage>(storage));
+
+    auto calls = storage->calls;
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_NE(blob.data(), nullptr);
+        EXPECT_EQ(blob.bytes(), 1_KiB);
+        EXPECT_EQ(blob.kind(), memory::memory_kind_type::host);
+        EXPECT_TRUE(blob);
+    }
+
+    // accessors are served from the handle, not the storage
+    EXPECT_EQ(storage->calls, calls);
+
+    auto copy = blob;
+    EXPECT_EQ(copy.data(), blob.data());
+    EXPECT_EQ(blob.use_count(), 3);
+
+    auto moved = std::move(blob);
+    EXPECT_EQ(moved.data(), copy.data());
+    EXPECT_TRUE(blob.empty());  // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(blob.data(), nullptr);
+    EXPECT_EQ(blob.bytes(), 0);
+    EXPECT_EQ(blob.kind(), memory::memory_kind_type::none);
+
+    auto other = moved.allocate(2_KiB);
+    EXPECT_EQ(other.bytes(), 2_KiB);
+    EXPECT_NE(other.data(), moved.data());
+}
+
+TEST_F(TestMemory, BlobStoragePoolAllocator)
+{
+    using node_t      = std::array<std::byte, 232>;
+    using free_list_t = memory::detail::node_free_list<sizeof(node_t)>;
+    memory::detail::storage_pool_allocator<node_t> allocator;
+
+    auto* a = allocator.allocate(1);
+    allocator.deallocate(a, 1);
+
+    // a freed node is reused by the next allocation on the same thread
+    auto* b = allocator.allocate(1);
+    EXPECT_EQ(a, b);
+
+    allocator.deallocate(b, 1);
+
+    // nodes allocated on this thread and freed on another are returned to the shared depot, from which this thread
+    // refills; the freeing thread retains at most max_local_cached nodes
+    constexpr std::size_t nodes = 4 * free_list_t::max_local_cached;
+
+    std::set<void*> allocated;
+    std::vector<node_t*> ptrs;
+    for (std::size_t i = 0; i < nodes; i++)
+    {
+        ptrs.push_back(allocator.allocate(1));
+        allocated.insert(ptrs.back());
+    }
+
+    auto shared_before   = free_list_t::shared_cached();
+    std::size_t retained = 0;
+    std::thread([&allocator, &ptrs, &retained] {
+        for (auto* ptr : ptrs)
+        {
+            allocator.deallocate(ptr, 1);
+        }
+        retained = free_list_t::local_cached();
+    }).join();
+
+    EXPECT_LE(retained, free_list_t::max_local_cached);
+    EXPECT_GT(free_list_t::shared_cached(), shared_before);
+    EXPECT_LE(free_list_t::shared_cached(), free_list_t::max_shared_cached);
+
+    // drain this thread's list, then the next allocations are served with nodes freed by the other thread
+    while (free_list_t::local_cached() != 0)
+    {
+        ::operator delete(free_list_t::acquire());
+    }
+    auto* c = allocator.allocate(1);
+    EXPECT_EQ(allocated.count(c), 1);
+    allocator.deallocate(c, 1);
+}
+
+TEST_F(TestMemory, BufferPool)
+{
+    using pool_t = memory::buffer_pool<::cuda::memory_kind::host>;
+
+    auto malloc = std::make_shared<memory::malloc_memory_resource>();
+    auto pool   = pool_t::create(malloc, 4_KiB, 2, 4, 4);
+    EXPECT_EQ(pool->size(), 2);
+    EXPECT_EQ(pool->max_size(), 4);
+
+    auto a = pool->acquire();
+    ASSERT_TRUE(a);
+    EXPECT_EQ(a.bytes(), 4_KiB);
+    EXPECT_EQ(a.kind(), memory::memory_kind_type::host);
+    std::memset(a.data(), 0xff, a.bytes());
+
+    // released buffers are handed back out on the same thread
+    void* ptr = a.data();
+    a.release();
+    EXPECT_FALSE(a);
+    auto b = pool->acquire();
+    EXPECT_EQ(b.data(), ptr);
+
+    // the pool grows elastically up to max_buffers
+    auto c = pool->acquire();
+    auto d = pool->acquire();
+    auto e = pool->acquire();
+    EXPECT_EQ(pool->size(), 4);
+    EXPECT_FALSE(pool->try_acquire());
+    EXPECT_THROW(pool->acquire(), std::bad_alloc);
+
+    // handles keep the pool alive
+    std::weak_ptr<pool_t> weak = pool;
+    pool.reset();
+    EXPECT_FALSE(weak.expired());
+    b.release();
+    c.release();
+    d.release();
+    e.release();
+    EXPECT_TRUE(weak.expired());
+
+    // buffers idle in the cache of another thread are reclaimed before the pool reports exhaustion
+    pool = pool_t::create(malloc, 4_KiB, 0, 4, 64);
+
+    std::promise<void> cached;
+    std::promise<void> done;
+    std::thread holder([&pool, &cached, exit = done.get_future()]() mutable {
+        std::vector<pool_t::handle_type> held;
+        for (int i = 0; i < 4; ++i)
+        {
+            held.push_back(pool->acquire());
+        }
+        held.clear();
+        cached.set_value();
+        exit.wait();
+    });
+    cached.get_future().wait();
+
+    EXPECT_EQ(pool->size(), 4);
+    EXPECT_EQ(pool->depot_size(), 0);
+
+    std::vector<pool_t::handle_type> reclaimed;
+    for (int i = 0; i < 4; ++i)
+    {
+        reclaimed.push_back(pool->acquire());
+    }
+    EXPECT_EQ(pool->size(), 4);
+    EXPECT_FALSE(pool->try_acquire());
+
+    done.set_value();
+    holder.join();
+}
+
+TEST_F(TestMemory, BufferPoolBlob)
+{
+    using pool_t = memory::buffer_pool<::cuda::memory_kind::host>;
+
+    auto malloc = std::make_shared<memory::malloc_memory_resource>();
+    auto pool   = pool_t::create(malloc, 4_KiB, 1, 2, 0);
+
+    auto buffer = pool->acquire();
+    void* ptr   = buffer.data();
+
+    memory::blob blob(std::move(buffer));
+    EXPECT_EQ(blob.data(), ptr);
+    EXPECT_EQ(blob.bytes(), 4_KiB);
+
+    auto copy = blob;
+    blob      = memory::blob();
+    EXPECT_EQ(pool->depot_size(), 0);
+
+    // the buffer returns to the pool when the last blob is dropped
+    copy = memory::blob();
+    EXPECT_EQ(pool->depot_size(), 1);
+
+    // pool-sized allocations are served from the pool, other sizes from its resource
+    memory::blob pooled(pool->acquire());
+    auto same = pooled.allocate(4_KiB);
+    EXPECT_EQ(pool->size(), 2);
+    auto other = pooled.allocate(1_KiB);
+    EXPECT_EQ(other.bytes(), 1_KiB);
+    EXPECT_EQ(pool->size(), 2);
+}
+
+TEST_F(TestMemory, BufferPoolConcurrent)
+{
+    using pool_t = memory::buffer_pool<::cuda::memory_kind::host>;
+
+    auto malloc = std::make_shared<memory::malloc_memory_resource>();
+    auto pool   = pool_t::create(malloc, 4_KiB, 0, 256, 16);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([pool] {
+            std::vector<memory::blob> held;
+            for (int i = 0; i < 10000; ++i)
+            {
+                held.emplace_back(pool->acquire());
+                if (held.size() == 8)
+                {
+                    held.clear();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // exited threads return their cached buffers to the depot
+    EXPECT_LE(pool->size(), 256);
+    EXPECT_EQ(pool->depot_size(), pool->size());
+}
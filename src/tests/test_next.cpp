@@ -29,6 +29,7 @@
 #include "srf/segment/object.hpp"
 #include "srf/utils/macros.hpp"
 
+#include <srf/channel/channel.hpp>
 #include <srf/channel/egress.hpp>
 #include <srf/channel/ingress.hpp>
 #include <srf/channel/status.hpp>
@@ -443,6 +444,59 @@ TEST_F(TestNext, SourceNodeSink)
     runner_sink->await_join();
 };
 
+TEST_F(TestNext, HotRxSourceYields)
+{
+    // a source which never blocks on its channel must yield to the fibers co-scheduled on its thread once its
+    // time-slice budget is exhausted
+    constexpr int count = 4096;
+
+    auto channel_size = channel::default_channel_size();
+    channel::set_default_channel_size(2 * count);
+
+    std::atomic<bool> running{true};
+    std::atomic<std::size_t> ticks{0};
+    std::size_t ticks_at_first = 0;
+    std::size_t ticks_at_last  = 0;
+
+    auto source = std::make_unique<node::RxSource<int>>(
+        rxcpp::observable<>::range(1, count).tap([&](const int& i) {
+            if (i == 1)
+            {
+                ticks_at_first = ticks;
+            }
+            if (i == count)
+            {
+                ticks_at_last = ticks;
+            }
+        }));
+    ExampleSinkChannel<int> sink;
+    node::make_edge(*source, sink);
+    channel::set_default_channel_size(channel_size);
+
+    // the co-scheduled fiber runs on the main task queue, which is the thread of the main engine factory
+    auto ticker = m_resources->partition(0).host().main().enqueue([&running, &ticks] {
+        while (running)
+        {
+            ++ticks;
+            boost::this_fiber::yield();
+        }
+    });
+
+    runnable::LaunchOptions options;
+    options.engine_factory_name  = "main";
+    options.time_slice.max_items = 64;
+
+    auto runner =
+        m_resources->partition(0).host().launch_control().prepare_launcher(options, std::move(source))->ignition();
+    runner->await_join();
+
+    running = false;
+    ticker.get();
+
+    EXPECT_GT(runner->instances().at(0).forced_yields(), 0);
+    EXPECT_GT(ticks_at_last, ticks_at_first);
+}
+
 template <typename T, typename = void>
 struct is_srf_value : std::false_type
 {};
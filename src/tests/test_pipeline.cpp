@@ -20,6 +20,8 @@
 #include "internal/pipeline/manager.hpp"
 #include "internal/pipeline/pipeline.hpp"
 #include "internal/pipeline/types.hpp"
+#include "internal/resources/host_resources.hpp"
+#include "internal/resources/partition_resources.hpp"
 #include "internal/resources/resource_partitions.hpp"
 #include "internal/system/system.hpp"
 #include "internal/utils/collision_detector.hpp"
@@ -31,9 +33,12 @@
 #include "srf/core/executor.hpp"
 #include "srf/internal/pipeline/ipipeline.hpp"
 #include "srf/internal/segment/idefinition.hpp"
+#include "srf/manifold/load_balancer.hpp"
 #include "srf/node/rx_sink.hpp"
 #include "srf/node/rx_source.hpp"
+#include "srf/node/sink_channel.hpp"
 #include "srf/node/sink_properties.hpp"
+#include "srf/node/source_channel.hpp"
 #include "srf/node/source_properties.hpp"
 #include "srf/options/options.hpp"
 #include "srf/options/topology.hpp"
@@ -77,6 +82,13 @@ using namespace srf;
 class TestPipeline : public ::testing::Test
 {};
 
+template <typename T>
+class ReadableSinkChannel : public node::SinkChannel<T>
+{
+  public:
+    using node::SinkChannel<T>::egress;
+};
+
 static std::shared_ptr<internal::system::System> make_system(std::function<void(Options&)> updater = nullptr)
 {
     auto options = std::make_shared<Options>();
@@ -279,3 +291,75 @@ TEST_F(TestPipeline, MultiSegmentLoadBalancer)
     EXPECT_EQ(ranks.size(), count);
     EXPECT_EQ(count_by_rank.size(), 2);
 }
+
+TEST_F(TestPipeline, MultiSegmentDirectBinding)
+{
+    // one copy of the source segment (seg_1) and one copy of the sink segment (seg_2) on the same partition; the
+    // manifold binds the egress port directly to the ingress port, which preserves the order of the data
+
+    auto pipeline = srf::make_pipeline();
+
+    int count = 1000;
+    std::vector<int> values;
+
+    pipeline->make_segment("seg_1", segment::EgressPorts<int>({"i"}), [count](segment::Builder& s) {
+        auto src    = s.make_object("src", test::nodes::finite_int_rx_source(count));
+        auto egress = s.get_egress<int>("i");
+        s.make_edge(src, egress);
+    });
+
+    pipeline->make_segment("seg_2", segment::IngressPorts<int>({"i"}), [&values](segment::Builder& s) mutable {
+        auto sink    = s.make_sink<int>("sink", [&](int x) { values.push_back(x); });
+        auto ingress = s.get_ingress<int>("i");
+        s.make_edge(ingress, sink);
+    });
+
+    internal::pipeline::SegmentAddresses update;
+    update[segment_address_encode(segment_name_hash("seg_1"), 0)] = 0;
+    update[segment_address_encode(segment_name_hash("seg_2"), 0)] = 0;
+
+    run_custom_manager(std::move(pipeline), std::move(update));
+
+    ASSERT_EQ(values.size(), count);
+    for (int i = 1; i < count; i++)
+    {
+        EXPECT_LT(values[i - 1], values[i]);
+    }
+
+    // the same topology on a standalone manifold: the input is bound directly to the output and the balancer is never
+    // launched; the output is released once the input completes
+    auto resources = internal::resources::make_resource_partitions(make_system([](Options& options) {
+        options.topology().user_cpuset("0-1");
+        options.topology().restrict_gpus(true);
+    }));
+
+    auto source = std::make_unique<node::SourceChannelWriteable<int>>();
+    ReadableSinkChannel<int> sink;
+
+    auto load_balancer = std::make_shared<manifold::LoadBalancer<int>>("i", resources->partition(0).host());
+    load_balancer->add_input(segment_address_encode(segment_name_hash("seg_1"), 0), source.get());
+    load_balancer->add_output(segment_address_encode(segment_name_hash("seg_2"), 0), &sink);
+    load_balancer->permit_direct_binding(true);
+    load_balancer->update_inputs();
+    load_balancer->update_outputs();
+    load_balancer->start();
+
+    EXPECT_TRUE(load_balancer->is_direct_bound());
+    EXPECT_FALSE(load_balancer->is_balancer_launched());
+
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(source->await_write(int(i)), channel::Status::success);
+    }
+    source.reset();
+    load_balancer->join();
+
+    EXPECT_FALSE(load_balancer->is_balancer_launched());
+    int value = -1;
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(sink.egress().await_read(value), channel::Status::success);
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(sink.egress().await_read(value), channel::Status::closed);
+}
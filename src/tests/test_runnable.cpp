@@ -49,6 +49,7 @@
 #include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 using namespace srf;
 
@@ -135,6 +136,46 @@ class TestThreadRunnable final : public runnable::ThreadRunnable<>
     }
 };
 
+class TestTimeSliceRunnable final : public runnable::FiberRunnable<>
+{
+    void run(ContextType& ctx) final
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            ctx.time_slice_tick();
+        }
+    }
+};
+
+struct CollectiveResults
+{
+    std::size_t reduce{0};
+    std::size_t all_reduce{0};
+    std::size_t broadcast{0};
+    std::size_t scan{0};
+};
+
+class TestCollectiveRunnable final : public runnable::RunnableWithContext<>
+{
+  public:
+    TestCollectiveRunnable(std::vector<CollectiveResults>& results) : m_results(results) {}
+
+  private:
+    void run(ContextType& ctx) final
+    {
+        auto plus  = [](std::size_t a, std::size_t b) { return a + b; };
+        auto value = ctx.rank() + 1;
+
+        auto& results      = m_results.at(ctx.rank());
+        results.reduce     = ctx.reduce_to_rank0(value, plus);
+        results.all_reduce = ctx.all_reduce(value, plus);
+        results.broadcast  = ctx.broadcast_from_rank0(value);
+        results.scan       = ctx.scan(value, plus);
+    }
+
+    std::vector<CollectiveResults>& m_results;
+};
+
 TEST_F(TestRunnable, TypeTraitsGeneric)
 {
     using ctx_t = runnable::runnable_context_t<TestGenericRunnable>;
@@ -267,6 +308,65 @@ TEST_F(TestRunnable, RunnerOutOfScope)
     runner->await_live();
 }
 
+TEST_F(TestRunnable, FiberRunnableTimeSlice)
+{
+    runnable::LaunchOptions factory;
+    factory.engine_factory_name = "default";
+
+    // without a budget, no yields are forced
+    auto runner = m_resources->partition(0)
+                      .host()
+                      .launch_control()
+                      .prepare_launcher(factory, std::make_unique<TestTimeSliceRunnable>())
+                      ->ignition();
+    runner->await_join();
+    EXPECT_EQ(runner->instances().at(0).forced_yields(), 0);
+
+    std::atomic<std::size_t> callback_count = 0;
+    factory.time_slice.max_items            = 4;
+
+    auto launcher = m_resources->partition(0).host().launch_control().prepare_launcher(
+        factory, std::make_unique<TestTimeSliceRunnable>());
+    launcher->apply([&callback_count](runnable::Runner& runner) {
+        runner.on_forced_yield_callback([&callback_count] { ++callback_count; });
+    });
+    runner = launcher->ignition();
+    runner->await_join();
+
+    EXPECT_EQ(runner->instances().at(0).forced_yields(), 25);
+    EXPECT_EQ(callback_count, 25);
+}
+
+TEST_F(TestRunnable, Collectives)
+{
+    for (const auto* factory_name : {"default", "thread_pool"})
+    {
+        runnable::LaunchOptions options;
+        options.engine_factory_name = factory_name;
+        options.pe_count            = 2;
+        options.engines_per_pe      = 3;
+
+        const std::size_t size = options.pe_count * options.engines_per_pe;
+        std::vector<CollectiveResults> results(size);
+
+        auto runner = m_resources->partition(0)
+                          .host()
+                          .launch_control()
+                          .prepare_launcher(options, std::make_unique<TestCollectiveRunnable>(results))
+                          ->ignition();
+        runner->await_join();
+
+        const std::size_t total = size * (size + 1) / 2;
+        EXPECT_EQ(results[0].reduce, total);
+        for (std::size_t rank = 0; rank < size; ++rank)
+        {
+            EXPECT_EQ(results[rank].all_reduce, total);
+            EXPECT_EQ(results[rank].broadcast, 1);
+            EXPECT_EQ(results[rank].scan, (rank + 1) * (rank + 2) / 2);
+        }
+    }
+}
+
 // Move the remaining tests to TestNode
 
 // TEST_F(TestRunnable, ThreadRunnable)
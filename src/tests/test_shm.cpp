@@ -0,0 +1,194 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/shm/channel.hpp"
+
+#include <srf/protos/codable.pb.h>
+#include <srf/memory/blob.hpp>
+#include <srf/memory/block.hpp>
+#include <srf/types.hpp>
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace srf;
+using namespace srf::internal;
+
+class TestShm : public ::testing::Test
+{
+  protected:
+    // attach a receiver in this process; the receiver takes ownership of duplicates of the sender's fds
+    static std::unique_ptr<shm::Receiver> attach(const shm::Sender& sender)
+    {
+        auto fds = sender.fds();
+        return std::make_unique<shm::Receiver>(
+            shm::ChannelFds{::dup(fds.region), ::dup(fds.data_efd), ::dup(fds.release_efd)});
+    }
+};
+
+TEST_F(TestShm, BlockRoundTrip)
+{
+    shm::Sender sender(shm::ChannelOptions{4096, 4});
+    auto receiver = attach(sender);
+
+    EXPECT_FALSE(receiver->try_receive());
+
+    std::vector<std::uint64_t> values{1, 2, 3, 4, 5, 6, 7, 8};
+    auto bytes = values.size() * sizeof(std::uint64_t);
+    sender.send(42, memory::const_block(values.data(), bytes, memory::memory_kind_type::host));
+
+    auto message = receiver->try_receive();
+    ASSERT_TRUE(message);
+    EXPECT_EQ(message->port_address, 42);
+    EXPECT_EQ(message->kind, shm::RecordKind::Block);
+    ASSERT_EQ(message->payload.bytes(), bytes);
+    EXPECT_EQ(std::memcmp(message->payload.data(), values.data(), message->payload.bytes()), 0);
+    EXPECT_FALSE(receiver->try_receive());
+}
+
+TEST_F(TestShm, SlotsReturnedOnRelease)
+{
+    shm::Sender sender(shm::ChannelOptions{4096, 2});
+    auto receiver = attach(sender);
+
+    // payloads are written in place; only the slot crosses the ring
+    for (std::uint64_t i = 0; i < 2; i++)
+    {
+        auto buffer = sender.acquire(sizeof(i));
+        std::memcpy(buffer.data(), &i, sizeof(i));
+        sender.send(i, std::move(buffer));
+    }
+    EXPECT_FALSE(sender.try_acquire(16));
+
+    auto first  = receiver->await_receive(std::chrono::milliseconds(100));
+    auto second = receiver->await_receive(std::chrono::milliseconds(100));
+    ASSERT_TRUE(first && second);
+    EXPECT_EQ(*static_cast<const std::uint64_t*>(first->payload.data()), 0);
+    EXPECT_EQ(*static_cast<const std::uint64_t*>(second->payload.data()), 1);
+
+    // both slots are held by the receiver until its payloads are released
+    EXPECT_FALSE(sender.try_acquire(16));
+    first.reset();
+    auto buffer = sender.try_acquire(16);
+    EXPECT_TRUE(buffer);
+
+    // an unsent buffer returns its slot to the sender
+    buffer.reset();
+    second.reset();
+    EXPECT_TRUE(sender.try_acquire(16));
+    EXPECT_EQ(sender.free_slots(), 2);
+
+    EXPECT_THROW(sender.try_acquire(sender.slot_bytes() + 1), std::length_error);
+}
+
+TEST_F(TestShm, EncodedObjectRoundTrip)
+{
+    shm::Sender sender;
+    auto receiver = attach(sender);
+
+    std::vector<std::uint32_t> first(100, 7);
+    std::vector<std::uint32_t> second(33, 9);
+
+    codable::protos::EncodedObject proto;
+    for (auto* data : {&first, &second})
+    {
+        auto* remote_desc = proto.add_descriptors()->mutable_remote_desc();
+        remote_desc->set_remote_address(reinterpret_cast<std::uint64_t>(data->data()));
+        remote_desc->set_remote_bytes(data->size() * sizeof(std::uint32_t));
+        remote_desc->set_memory_kind(codable::protos::MemoryKind::Host);
+    }
+    proto.add_descriptors()->mutable_eager_desc()->set_data("eager");
+
+    sender.send(7, proto);
+
+    auto message = receiver->await_receive(std::chrono::milliseconds(100));
+    ASSERT_TRUE(message);
+    EXPECT_EQ(message->kind, shm::RecordKind::EncodedObject);
+
+    auto decoded = shm::decode(*message);
+    ASSERT_EQ(decoded.descriptors_size(), 3);
+    EXPECT_EQ(decoded.descriptors(2).eager_desc().data(), "eager");
+
+    for (int i = 0; i < 2; i++)
+    {
+        const auto& remote_desc = decoded.descriptors(i).remote_desc();
+        const auto& expected    = (i == 0 ? first : second);
+        auto* address           = reinterpret_cast<const std::byte*>(remote_desc.remote_address());
+
+        // the decoded descriptors reference the shared slot, not the sender's memory
+        EXPECT_GE(address, static_cast<const std::byte*>(message->payload.data()));
+        EXPECT_NE(remote_desc.remote_address(), reinterpret_cast<std::uint64_t>(expected.data()));
+        ASSERT_EQ(remote_desc.remote_bytes(), expected.size() * sizeof(std::uint32_t));
+        EXPECT_EQ(std::memcmp(address, expected.data(), remote_desc.remote_bytes()), 0);
+    }
+}
+
+TEST_F(TestShm, ForkedReceiver)
+{
+    constexpr std::uint64_t count = 10000;
+    const std::string socket_path = "/tmp/srf_test_shm_" + std::to_string(::getpid());
+
+    // fewer slots than messages so the sender must wait for the receiver to release slots
+    shm::Sender sender(shm::ChannelOptions{256, 8});
+
+    auto pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0)
+    {
+        // wait for the parent to listen on the socket
+        while (::access(socket_path.c_str(), F_OK) != 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto receiver = shm::Receiver::connect(socket_path);
+
+        for (std::uint64_t i = 0; i < count; i++)
+        {
+            auto message = receiver->await_receive(std::chrono::seconds(10));
+            if (!message || message->port_address != i ||
+                *static_cast<const std::uint64_t*>(message->payload.data()) != i)
+            {
+                ::_exit(1);
+            }
+        }
+        ::_exit(0);
+    }
+
+    sender.export_fds(socket_path);
+    for (std::uint64_t i = 0; i < count; i++)
+    {
+        sender.send(i, memory::const_block(&i, sizeof(i), memory::memory_kind_type::host));
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
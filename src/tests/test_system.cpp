@@ -19,6 +19,7 @@
 #include <srf/types.hpp>
 #include "internal/system/fiber_pool.hpp"
 #include "internal/system/fiber_task_queue.hpp"
+#include "internal/system/pinned_thread_pool.hpp"
 #include "internal/system/system.hpp"
 #include "internal/system/thread_pool.hpp"
 #include "internal/system/topology.hpp"
@@ -38,6 +39,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
 #include <ostream>
 #include <set>
@@ -48,6 +50,7 @@ using namespace srf;
 using namespace internal;
 
 using system::System;
+using system::PinnedThreadPool;
 using system::ThreadPool;
 
 // iwyu is getting confused between std::uint32_t and boost::uint32_t
@@ -277,3 +280,70 @@ TEST_F(TestSystem, ThreadPool)
     EXPECT_EQ(counter, 3);
     EXPECT_EQ(ids.size(), 2);
 }
+
+TEST_F(TestSystem, PinnedThreadPool)
+{
+    auto system = System::make_system(make_options([](Options& options) {
+        options.topology().user_cpuset("0-3");
+        options.topology().restrict_gpus(true);
+    }));
+
+    auto pool = std::make_unique<PinnedThreadPool>(system);
+
+    auto launch = [&pool](const CpuSet& cpu_set, std::function<std::thread::id()> f) {
+        std::packaged_task<std::thread::id()> task(std::move(f));
+        auto future = task.get_future();
+        pool->launch(cpu_set, std::packaged_task<void()>([t = std::move(task)]() mutable { t(); }));
+        return future;
+    };
+
+    auto get_id = [] { return std::this_thread::get_id(); };
+
+    auto wait_idle = [&pool](std::size_t count) {
+        while (pool->idle_count() != count)
+        {
+            std::this_thread::yield();
+        }
+    };
+
+    // sequential launches on the same cpu_set reuse the same thread
+    auto first = launch(CpuSet("2"), get_id).get();
+    wait_idle(1);
+    auto second = launch(CpuSet("2"), get_id).get();
+    wait_idle(1);
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(pool->thread_count(), 1);
+
+    // an idle thread with a different affinity is not reused
+    auto third = launch(CpuSet("3"), get_id).get();
+    wait_idle(2);
+
+    EXPECT_NE(first, third);
+    EXPECT_EQ(pool->thread_count(), 2);
+
+    // concurrent launches each get a dedicated thread
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto blocking = [released] {
+        released.wait();
+        return std::this_thread::get_id();
+    };
+
+    auto f1 = launch(CpuSet("2"), blocking);
+    auto f2 = launch(CpuSet("2"), blocking);
+    release.set_value();
+
+    EXPECT_NE(f1.get(), f2.get());
+    EXPECT_EQ(pool->thread_count(), 3);
+
+    // the pool may be destroyed by a task running on one of its own threads
+    wait_idle(3);
+    std::promise<void> destroyed;
+    pool->launch(CpuSet("2"), std::packaged_task<void()>([&pool, &destroyed] {
+                     pool.reset();
+                     destroyed.set_value();
+                 }));
+    destroyed.get_future().get();
+    EXPECT_EQ(pool, nullptr);
+}
@@ -17,7 +17,12 @@
 
 #include "internal/ucx/all.hpp"
 #include "internal/ucx/endpoint.hpp"
+#include "internal/ucx/progress.hpp"
 #include "srf/channel/forward.hpp"
+#include "srf/memory/literals.hpp"
+#include "srf/memory/resources/arena_resource.hpp"
+#include "srf/memory/resources/host/malloc_memory_resource.hpp"
+#include "srf/memory/resources/ucx_registered_resource.hpp"
 #include "srf/types.hpp"
 
 #include <glog/logging.h>
@@ -36,9 +41,12 @@
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace srf;
 using namespace internal::ucx;
+using namespace srf::memory::literals;
 
 class TestUCX : public ::testing::Test
 {
@@ -82,6 +90,110 @@ TEST_F(TestUCX, EndpointsInProcess)
     worker_1->progress();
     worker_2->progress();
 }
+TEST_F(TestUCX, AdaptiveProgressWakeup)
+{
+    auto recv_worker = std::make_shared<Worker>(m_context);
+    auto send_worker = std::make_shared<Worker>(m_context);
+    auto ep          = send_worker->create_endpoint(recv_worker->address());
+
+    // no busy poll window; every idle call arms the worker and suspends on its event fd
+    AdaptiveProgress progress(recv_worker, std::chrono::microseconds(0));
+
+    std::uint64_t value = 42;
+    std::thread sender([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        ucp_request_param_t params;
+        std::memset(&params, 0, sizeof(params));
+
+        auto request = ucp_tag_send_nbx(ep->handle(), &value, sizeof(value), 42, &params);
+        ASSERT_FALSE(UCS_PTR_IS_ERR(request));
+        if (request != nullptr)
+        {
+            while (ucp_request_check_status(request) == UCS_INPROGRESS)
+            {
+                send_worker->progress();
+            }
+            ucp_request_free(request);
+        }
+    });
+
+    ucp_tag_recv_info_t msg_info;
+    while (ucp_tag_probe_nb(recv_worker->handle(), 42, ~0ULL, 0, &msg_info) == nullptr)
+    {
+        if (!progress.progress())
+        {
+            progress.idle();
+        }
+    }
+    sender.join();
+
+    EXPECT_EQ(msg_info.length, sizeof(value));
+    EXPECT_GT(progress.suspensions(), 0);
+}
+
+TEST_F(TestUCX, SerializedWorkerPerPartition)
+{
+    constexpr std::size_t partitions = 4;
+
+    // one serialized worker per partition; each worker is only accessed by the thread which drives its partition
+    std::vector<Handle<Worker>> workers;
+    for (std::size_t i = 0; i < partitions; i++)
+    {
+        workers.push_back(std::make_shared<Worker>(m_context, UCS_THREAD_MODE_SERIALIZED));
+        EXPECT_EQ(workers.back()->thread_mode(), UCS_THREAD_MODE_SERIALIZED);
+    }
+
+    // endpoints are formed between pairs of partition workers; each partition sends to the next
+    std::vector<Handle<Endpoint>> endpoints;
+    for (std::size_t i = 0; i < partitions; i++)
+    {
+        endpoints.push_back(workers[i]->create_endpoint(workers[(i + 1) % partitions]->address()));
+    }
+
+    std::vector<std::uint64_t> received(partitions, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < partitions; i++)
+    {
+        threads.emplace_back([&, i] {
+            auto& worker        = *workers[i];
+            std::uint64_t value = i;
+
+            ucp_request_param_t params;
+            std::memset(&params, 0, sizeof(params));
+
+            auto send = ucp_tag_send_nbx(endpoints[i]->handle(), &value, sizeof(value), 42, &params);
+            ASSERT_FALSE(UCS_PTR_IS_ERR(send));
+
+            auto recv = ucp_tag_recv_nbx(worker.handle(), &received[i], sizeof(std::uint64_t), 42, ~0ULL, &params);
+            ASSERT_FALSE(UCS_PTR_IS_ERR(recv));
+
+            for (auto* request : {send, recv})
+            {
+                if (request != nullptr)
+                {
+                    while (ucp_request_check_status(request) == UCS_INPROGRESS)
+                    {
+                        worker.progress();
+                    }
+                    ucp_request_free(request);
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // each partition received from the previous partition's worker
+    for (std::size_t i = 0; i < partitions; i++)
+    {
+        EXPECT_EQ(received[i], (i + partitions - 1) % partitions);
+    }
+}
+
 /*
 TEST_F(TestUCX, ReceiveManager)
 {
@@ -200,3 +312,57 @@ TEST_F(TestUCX, Get)
     }
     future.get();
 }
+
+TEST_F(TestUCX, RegisteredResource)
+{
+    auto malloc = std::make_unique<memory::malloc_memory_resource>();
+    auto ucx    = memory::make_shared_resource<memory::ucx_registered_resource>(std::move(malloc), m_context);
+
+    void* ptr = ucx->allocate(1_MiB);
+    EXPECT_EQ(ucx->size(), 1);
+
+    auto block = ucx->lookup(ptr);
+    EXPECT_EQ(block.data(), ptr);
+    EXPECT_EQ(block.bytes(), 1_MiB);
+    EXPECT_NE(block.local_handle(), nullptr);
+    EXPECT_NE(block.remote_handle(), nullptr);
+    EXPECT_GT(block.remote_handle_size(), 0);
+
+    // interior addresses resolve to the same registration
+    auto interior = ucx->find(static_cast<std::byte*>(ptr) + 4096);
+    ASSERT_TRUE(interior);
+    EXPECT_EQ(interior->local_handle(), block.local_handle());
+
+    int on_stack = 0;
+    EXPECT_FALSE(ucx->find(&on_stack));
+    EXPECT_ANY_THROW(ucx->lookup(&on_stack));
+
+    ucx->deallocate(ptr, 1_MiB);
+    EXPECT_EQ(ucx->size(), 0);
+    EXPECT_FALSE(ucx->find(ptr));
+}
+
+TEST_F(TestUCX, RegisteredResourceArena)
+{
+    auto malloc = std::make_unique<memory::malloc_memory_resource>();
+    auto ucx    = memory::make_shared_resource<memory::ucx_registered_resource>(std::move(malloc), m_context);
+    auto arena  = memory::make_shared_resource<memory::arena_resource>(ucx, 64_MiB, 128_MiB);
+
+    // each arena superblock is registered once; suballocations share its registration
+    void* a = arena->allocate(64_KiB);
+    void* b = arena->allocate(1_MiB);
+    auto registrations = ucx->size();
+    EXPECT_GE(registrations, 1);
+
+    auto block_a = ucx->lookup(a);
+    auto block_b = ucx->lookup(b);
+    EXPECT_TRUE(block_a.contains(static_cast<std::byte*>(a) + 64_KiB - 1));
+    EXPECT_TRUE(block_b.contains(static_cast<std::byte*>(b) + 1_MiB - 1));
+
+    void* c = arena->allocate(64_KiB);
+    EXPECT_EQ(ucx->size(), registrations);
+
+    arena->deallocate(c, 64_KiB);
+    arena->deallocate(b, 1_MiB);
+    arena->deallocate(a, 64_KiB);
+}
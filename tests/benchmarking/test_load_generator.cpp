@@ -0,0 +1,203 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <srf/benchmarking/latency_histogram.hpp>
+#include <srf/benchmarking/load_generator.hpp>
+#include <srf/benchmarking/util.hpp>
+#include <srf/core/executor.hpp>
+#include <srf/node/rx_node.hpp>
+#include <srf/node/rx_sink.hpp>
+#include <srf/node/rx_source.hpp>
+#include <srf/pipeline/pipeline.hpp>
+#include <srf/segment/builder.hpp>
+#include <srf/segment/object.hpp>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace srf;
+using namespace srf::benchmarking;
+using namespace std::literals::chrono_literals;
+
+class LoadGeneratorTests : public ::testing::Test
+{};
+
+TEST_F(LoadGeneratorTests, HistogramPercentiles)
+{
+    LatencyHistogram histogram;
+    for (std::uint64_t i = 1; i <= 10000; ++i)
+    {
+        histogram.record(i * 1000);
+    }
+
+    EXPECT_EQ(histogram.count(), 10000);
+    EXPECT_EQ(histogram.min(), 1000);
+    EXPECT_EQ(histogram.max(), 10000000);
+    EXPECT_NEAR(histogram.mean(), 5000500.0, 1.0);
+
+    // values are reported within the histogram's relative precision and never below the true percentile
+    for (double p : {50.0, 90.0, 99.0, 99.9})
+    {
+        auto expected = static_cast<std::uint64_t>(p * 100) * 1000;
+        auto value    = histogram.value_at_percentile(p);
+        EXPECT_GE(value, expected);
+        EXPECT_LE(value, expected + expected / 1000);
+    }
+    EXPECT_EQ(histogram.value_at_percentile(100.0), 10000000);
+
+    auto json = histogram.to_json();
+    EXPECT_EQ(json["count"], 10000);
+    EXPECT_TRUE(json.contains("p99_9_seconds"));
+}
+
+TEST_F(LoadGeneratorTests, HistogramMergeAndOverflow)
+{
+    LatencyHistogram lhs(1'000'000);
+    LatencyHistogram rhs(1'000'000);
+
+    lhs.record(10ns);
+    rhs.record(100);
+    rhs.record(5'000'000);
+
+    EXPECT_EQ(rhs.overflow_count(), 1);
+    EXPECT_EQ(rhs.max(), 1'000'000);
+
+    lhs.merge(rhs);
+    EXPECT_EQ(lhs.count(), 3);
+    EXPECT_EQ(lhs.min(), 10);
+    EXPECT_EQ(lhs.max(), 1'000'000);
+    EXPECT_EQ(lhs.overflow_count(), 1);
+
+    lhs.reset();
+    EXPECT_EQ(lhs.count(), 0);
+    EXPECT_EQ(lhs.value_at_percentile(99.0), 0);
+}
+
+TEST_F(LoadGeneratorTests, ArrivalSchedule)
+{
+    ArrivalSchedule constant(LoadProfile{1000.0, ArrivalProcess::Constant});
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(constant.next(), std::chrono::milliseconds(i));
+    }
+
+    constexpr std::size_t count = 100000;
+    ArrivalSchedule poisson(LoadProfile{1000.0, ArrivalProcess::Poisson});
+    std::chrono::nanoseconds last{0};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto next = poisson.next();
+        EXPECT_GE(next, last);
+        last = next;
+    }
+    // mean inter-arrival time converges on 1ms
+    EXPECT_NEAR(static_cast<double>(last.count()) / count, 1e6, 2e4);
+}
+
+TEST_F(LoadGeneratorTests, OpenLoopSource)
+{
+    LoadProfile profile{20000.0, ArrivalProcess::Constant, 100};
+    LatencyRecorder recorder;
+    std::size_t completed = 0;
+
+    auto source = create_open_loop_source(profile);
+    source(rxcpp::make_subscriber<OpenLoopSample>([&](OpenLoopSample sample) { recorder.record(sample); },
+                                                  [&] { ++completed; }));
+
+    EXPECT_EQ(completed, 1);
+    EXPECT_EQ(recorder.count(), 100);
+    // 100 samples at 20k/s are spaced over ~5ms
+    EXPECT_GE(recorder.elapsed_seconds(), 0.00495);
+}
+
+TEST_F(LoadGeneratorTests, SweepCapturesQueueingDelay)
+{
+    LoadProfile base{10000.0, ArrivalProcess::Constant, 1000};
+
+    // system under test: a single server which stalls for 20ms on the first sample, then keeps up
+    auto run = [](const LoadProfile& profile, LatencyRecorder& recorder) {
+        ArrivalSchedule schedule(profile);
+        auto start = TimeUtil::get_current_time_point();
+        for (std::size_t i = 0; i < profile.count; ++i)
+        {
+            auto intended = start + schedule.next();
+            wait_until(intended);
+            if (i == 0)
+            {
+                std::this_thread::sleep_for(20ms);
+            }
+            recorder.record(intended);
+        }
+    };
+
+    auto curve = sweep_offered_load(base, {1000.0, 10000.0}, run);
+    ASSERT_EQ(curve.size(), 2);
+    EXPECT_EQ(curve[0].offered_rate, 1000.0);
+    EXPECT_EQ(curve[1].histogram.count(), 1000);
+
+    // a closed-loop measurement would only see the one 20ms sample; open-loop timing also charges the ~200 samples
+    // that were due during the stall with the time they spent waiting
+    EXPECT_GT(curve[1].histogram.value_at_percentile(90.0), 1'000'000);
+    EXPECT_GT(curve[1].achieved_rate, 0.0);
+
+    auto json = to_json(curve);
+    ASSERT_EQ(json.size(), 2);
+    EXPECT_EQ(json[1]["offered_rate"], 10000.0);
+}
+
+TEST_F(LoadGeneratorTests, SegmentLatencyAtLowRate)
+{
+    // src->n1->sink with the open-loop source on the default fiber engine; wall-clock latency bounds are left to the
+    // segment_open_loop_latency benchmark, here every sample must reach the sink and be recorded
+    auto run = [](const LoadProfile& profile, LatencyRecorder& recorder) {
+        auto init = [&profile, &recorder](segment::Builder& segment) {
+            auto src = segment.make_source<OpenLoopSample>("nsrc", create_open_loop_source(profile));
+
+            auto internal = segment.make_node<OpenLoopSample, OpenLoopSample>(
+                "n1", rxcpp::operators::map([](OpenLoopSample sample) { return sample; }));
+            segment.make_edge(src, internal);
+
+            auto sink = segment.make_sink<OpenLoopSample>(
+                "nsink", [&recorder](OpenLoopSample sample) { recorder.record(sample); }, []() {});
+            segment.make_edge(internal, sink);
+        };
+
+        auto pipeline = pipeline::make_pipeline();
+        auto segment  = pipeline->make_segment("open_loop_segment", init);
+
+        Executor executor;
+        executor.register_pipeline(std::move(pipeline));
+        executor.start();
+        executor.join();
+    };
+
+    auto curve = sweep_offered_load(LoadProfile{500.0, ArrivalProcess::Constant, 250}, {500.0}, run);
+    ASSERT_EQ(curve.size(), 1);
+    EXPECT_EQ(curve[0].histogram.count(), 250);
+
+    EXPECT_LE(curve[0].histogram.value_at_percentile(50.0), curve[0].histogram.value_at_percentile(99.0));
+    EXPECT_LE(curve[0].histogram.value_at_percentile(99.0), curve[0].histogram.max());
+    EXPECT_GT(curve[0].achieved_rate, 0.0);
+}
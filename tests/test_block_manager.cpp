@@ -0,0 +1,138 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_srf.hpp"  // IWYU pragma: associated
+
+#include <srf/memory/core/block_manager.hpp>
+#include <srf/memory/core/concurrent_block_manager.hpp>
+#include <srf/memory/core/memory_block.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace srf;
+using namespace srf::memory;
+
+TEST_CLASS(BlockManager);
+
+TEST_F(TestBlockManager, FindBlock)
+{
+    std::vector<std::byte> arena(1024);
+    auto* base = arena.data();
+
+    block_manager<memory_block> blocks;
+    EXPECT_EQ(blocks.find_block(base), nullptr);
+
+    // insert out of order with a gap between [256, 512)
+    blocks.add_block(memory_block(base + 512, 512));
+    blocks.add_block(memory_block(base, 128));
+    blocks.add_block(memory_block(base + 128, 128));
+    EXPECT_EQ(blocks.size(), 3);
+
+    EXPECT_EQ(blocks.find_block(base)->data(), base);
+    EXPECT_EQ(blocks.find_block(base + 127)->data(), base);
+    EXPECT_EQ(blocks.find_block(base + 128)->data(), base + 128);
+    EXPECT_EQ(blocks.find_block(base + 255)->data(), base + 128);
+    EXPECT_EQ(blocks.find_block(base + 256), nullptr);
+    EXPECT_EQ(blocks.find_block(base + 511), nullptr);
+    EXPECT_EQ(blocks.find_block(base + 512)->data(), base + 512);
+    EXPECT_EQ(blocks.find_block(base + 1023)->data(), base + 512);
+    EXPECT_EQ(blocks.find_block(base + 1024), nullptr);
+
+    // blocks are sorted by address
+    const auto& sorted = blocks.blocks();
+    ASSERT_EQ(sorted.size(), 3);
+    EXPECT_EQ(sorted[0].data(), base);
+    EXPECT_EQ(sorted[1].data(), base + 128);
+    EXPECT_EQ(sorted[2].data(), base + 512);
+
+    // dropping by an interior address removes the containing block
+    blocks.drop_block(base + 200);
+    EXPECT_EQ(blocks.size(), 2);
+    EXPECT_EQ(blocks.find_block(base + 128), nullptr);
+    EXPECT_TRUE(blocks.owns(base + 600));
+
+    blocks.clear();
+    EXPECT_EQ(blocks.size(), 0);
+    EXPECT_FALSE(blocks.owns(base));
+}
+
+TEST_F(TestBlockManager, ConcurrentLookups)
+{
+    constexpr std::size_t block_bytes = 64;
+    constexpr std::size_t block_count = 1024;
+
+    std::vector<std::byte> arena(block_bytes * block_count);
+    auto* base = arena.data();
+
+    // even blocks are always present; odd blocks are added and dropped while readers are searching
+    concurrent_block_manager<memory_block> blocks;
+    for (std::size_t i = 0; i < block_count; i += 2)
+    {
+        blocks.add_block(memory_block(base + i * block_bytes, block_bytes));
+    }
+
+    std::atomic<bool> running{true};
+    std::atomic<std::size_t> failures{0};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++)
+    {
+        readers.emplace_back([&] {
+            while (running)
+            {
+                for (std::size_t i = 0; i < block_count; i += 2)
+                {
+                    auto block = blocks.find_block(base + i * block_bytes + block_bytes / 2);
+                    if (!block || block->data() != base + i * block_bytes)
+                    {
+                        ++failures;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int round = 0; round < 4; round++)
+    {
+        for (std::size_t i = 1; i < block_count; i += 2)
+        {
+            blocks.add_block(memory_block(base + i * block_bytes, block_bytes));
+        }
+        EXPECT_EQ(blocks.size(), block_count);
+        for (std::size_t i = 1; i < block_count; i += 2)
+        {
+            auto dropped = blocks.drop_block(base + i * block_bytes);
+            EXPECT_TRUE(dropped);
+        }
+        EXPECT_EQ(blocks.size(), block_count / 2);
+    }
+
+    running = false;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(failures, 0);
+    EXPECT_FALSE(blocks.drop_block(base + block_bytes));
+    EXPECT_FALSE(blocks.find_block(base + block_bytes));
+}
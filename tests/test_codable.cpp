@@ -19,18 +19,27 @@
 
 #include <srf/protos/codable.pb.h>
 #include <srf/codable/codable_protocol.hpp>
+#include <srf/codable/codec_registry.hpp>
 #include <srf/codable/decode.hpp>
 #include <srf/codable/encode.hpp>
 #include <srf/codable/encoded_object.hpp>
 #include <srf/codable/encoding_options.hpp>
 #include <srf/codable/fundamental_types.hpp>
+#include <srf/codable/memory_resources.hpp>
+#include <srf/codable/protobuf_arena.hpp>
 #include <srf/codable/protobuf_message.hpp>
 #include <srf/codable/type_traits.hpp>
+#include <srf/memory/resources/host/malloc_memory_resource.hpp>
+#include <srf/utils/thread_local_shared_pointer.hpp>
 
+#include <any>
 #include <cstdint>
 #include <memory>
+#include <random>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 using namespace codable;
 
@@ -80,6 +89,48 @@ namespace srf::codable {}
 struct NotCodableObject
 {};
 
+class HostMemoryResources final : public MemoryResources
+{
+  public:
+    HostMemoryResources() : m_host_view(std::make_shared<memory::malloc_memory_resource>()) {}
+
+    host_view_t host_resource_view() final
+    {
+        return m_host_view;
+    }
+
+    device_view_t device_resource_view() final
+    {
+        throw std::runtime_error("device memory is not available");
+    }
+
+  private:
+    host_view_t m_host_view;
+};
+
+static std::string compressible_string(std::size_t bytes)
+{
+    std::string str;
+    while (str.size() < bytes)
+    {
+        str += R"({"level":"info","msg":"request complete","status":200,"path":"/api/v1/items"})";
+        str += std::to_string(str.size());
+    }
+    str.resize(bytes);
+    return str;
+}
+
+static std::string random_string(std::size_t bytes)
+{
+    std::mt19937_64 rng(42);
+    std::string str(bytes, '\0');
+    for (auto& c : str)
+    {
+        c = static_cast<char>(rng());
+    }
+    return str;
+}
+
 TEST_CLASS(Codable);
 
 TEST_F(TestCodable, Objects)
@@ -155,3 +206,173 @@ TEST_F(TestCodable, EncodedObjectProto)
     static_assert(codable::is_decodable<protos::EncodedObject>::value, "should be decodable");
     static_assert(is_codable<protos::EncodedObject>::value, "should be codable");
 }
+
+TEST_F(TestCodable, EncodedObjectArena)
+{
+    // by default the descriptor tree is built on a recycled thread local arena
+    EncodedObject recycled;
+    EXPECT_NE(recycled.arena(), nullptr);
+
+    EncodedObject heap(std::shared_ptr<google::protobuf::Arena>(nullptr));
+    EXPECT_EQ(heap.arena(), nullptr);
+
+    google::protobuf::Arena arena;
+    EncodedObject borrowed(arena);
+    EXPECT_EQ(borrowed.arena(), &arena);
+
+    double pi = 3.14159;
+    for (auto* encoding : {&recycled, &heap, &borrowed})
+    {
+        encode(pi, *encoding);
+        EXPECT_EQ(encoding->object_count(), 1);
+        EXPECT_DOUBLE_EQ(decode<double>(*encoding), pi);
+    }
+
+    EncodedObject moved(std::move(borrowed));
+    EXPECT_EQ(moved.arena(), &arena);
+    EXPECT_DOUBLE_EQ(decode<double>(moved), pi);
+}
+
+TEST_F(TestCodable, RecycledArena)
+{
+    auto arena = acquire_arena();
+    auto* ptr  = arena.get();
+    google::protobuf::Arena::CreateMessage<protos::EncodedObject>(ptr)->add_objects()->set_desc_id(42);
+    arena.reset();
+
+    // the released arena is reset and handed back out on the same thread
+    arena = acquire_arena();
+    EXPECT_EQ(arena.get(), ptr);
+    auto* msg = google::protobuf::Arena::CreateMessage<protos::EncodedObject>(arena.get());
+    EXPECT_EQ(msg->objects_size(), 0);
+}
+
+TEST_F(TestCodable, CompressionRoundTrip)
+{
+    utils::ThreadLocalSharedPointer<MemoryResources>::set(std::make_shared<HostMemoryResources>());
+
+    auto str = compressible_string(256 * 1024);
+    for (auto algorithm : {CompressionAlgorithm::lz4, CompressionAlgorithm::zstd})
+    {
+        EncodingOptions opts;
+        opts.set_compression(CompressionPolicy(algorithm));
+
+        auto encoding     = encode(str, opts);
+        const auto& proto = encoding->proto().descriptors(0);
+        EXPECT_NE(proto.compression(), protos::Compression::Uncompressed);
+        EXPECT_EQ(proto.uncompressed_bytes(), str.size());
+        EXPECT_LT(proto.remote_desc().remote_bytes() * 3, str.size());
+
+        EXPECT_EQ(encoding->memory_block(0).bytes(), str.size());
+        EXPECT_EQ(decode<std::string>(*encoding), str);
+    }
+
+    utils::ThreadLocalSharedPointer<MemoryResources>::set(nullptr);
+}
+
+TEST_F(TestCodable, CompressionRejectsCorruptDescriptors)
+{
+    utils::ThreadLocalSharedPointer<MemoryResources>::set(std::make_shared<HostMemoryResources>());
+
+    auto str = compressible_string(64 * 1024);
+    for (auto algorithm : {CompressionAlgorithm::lz4, CompressionAlgorithm::zstd})
+    {
+        EncodingOptions opts;
+        opts.set_compression(CompressionPolicy(algorithm));
+
+        // descriptors received off the wire may claim any uncompressed size; none is trusted for the allocation
+        for (std::uint64_t forged : {std::uint64_t(str.size() + 1), std::uint64_t(1) << 40})
+        {
+            auto encoding = encode(str, opts);
+            auto& proto   = const_cast<protos::EncodedObject&>(encoding->proto());
+            proto.mutable_descriptors(0)->set_uncompressed_bytes(forged);
+            EXPECT_THROW(encoding->memory_block(0), exceptions::SrfRuntimeError);
+        }
+
+        // an unknown compression algorithm
+        auto encoding = encode(str, opts);
+        auto& proto   = const_cast<protos::EncodedObject&>(encoding->proto());
+        proto.mutable_descriptors(0)->set_compression(static_cast<protos::Compression>(42));
+        EXPECT_THROW(encoding->memory_block(0), exceptions::SrfRuntimeError);
+    }
+
+    utils::ThreadLocalSharedPointer<MemoryResources>::set(nullptr);
+}
+
+TEST_F(TestCodable, CompressionThreshold)
+{
+    utils::ThreadLocalSharedPointer<MemoryResources>::set(std::make_shared<HostMemoryResources>());
+
+    EncodingOptions opts;
+    opts.set_compression(CompressionPolicy(CompressionAlgorithm::lz4, 0, 4096));
+
+    // below the threshold
+    auto small = compressible_string(1024);
+    auto a     = encode(small, opts);
+    EXPECT_EQ(a->proto().descriptors(0).compression(), protos::Compression::Uncompressed);
+    EXPECT_EQ(decode<std::string>(*a), small);
+
+    // incompressible blocks are sent as-is
+    auto noise = random_string(64 * 1024);
+    auto b     = encode(noise, opts);
+    EXPECT_EQ(b->proto().descriptors(0).compression(), protos::Compression::Uncompressed);
+    EXPECT_EQ(decode<std::string>(*b), noise);
+
+    utils::ThreadLocalSharedPointer<MemoryResources>::set(nullptr);
+}
+
+TEST_F(TestCodable, CompressionAutoDisable)
+{
+    utils::ThreadLocalSharedPointer<MemoryResources>::set(std::make_shared<HostMemoryResources>());
+
+    CompressionPolicy policy(CompressionAlgorithm::zstd, 1, 4096, 2.0, 4, 8);
+    EncodingOptions opts;
+    opts.set_compression(policy);
+
+    // a window of poorly compressing payloads disables compression
+    auto noise = random_string(16 * 1024);
+    for (int i = 0; i < 4; i++)
+    {
+        encode(noise, opts);
+    }
+    EXPECT_FALSE(policy.active());
+
+    // while disabled, compressible payloads are only sampled every probe_interval blocks
+    auto str = compressible_string(16 * 1024);
+    for (int i = 0; i < 7; i++)
+    {
+        auto encoding = encode(str, opts);
+        EXPECT_EQ(encoding->proto().descriptors(0).compression(), protos::Compression::Uncompressed);
+    }
+
+    // the probe achieves the minimum ratio and re-enables compression
+    auto probe = encode(str, opts);
+    EXPECT_EQ(probe->proto().descriptors(0).compression(), protos::Compression::ZSTD);
+    EXPECT_TRUE(policy.active());
+    EXPECT_EQ(decode<std::string>(*probe), str);
+
+    utils::ThreadLocalSharedPointer<MemoryResources>::set(nullptr);
+}
+
+TEST_F(TestCodable, CodecRegistry)
+{
+    register_codec<double>();
+    register_codec<std::string>();
+    register_codec<double>();
+
+    EXPECT_TRUE(CodecRegistry::has_codec(std::type_index(typeid(double)).hash_code()));
+    EXPECT_FALSE(CodecRegistry::has_codec(std::type_index(typeid(CodableObject)).hash_code()));
+
+    EncodedObject encoded;
+    encode(3.14, encoded);
+    CodecRegistry::encode(std::any(std::string("srf")), encoded);
+    EXPECT_EQ(encoded.object_count(), 2);
+
+    auto pi = CodecRegistry::decode(encoded, 0);
+    auto str = CodecRegistry::decode(encoded, 1);
+    EXPECT_EQ(std::any_cast<double>(pi), 3.14);
+    EXPECT_EQ(std::any_cast<std::string>(str), "srf");
+
+    EXPECT_THROW(CodecRegistry::encode(std::any(std::uint8_t(1)), encoded), exceptions::SrfRuntimeError);
+    EXPECT_THROW(CodecRegistry::encode(std::any{}, encoded), exceptions::SrfRuntimeError);
+}
@@ -18,6 +18,7 @@
 #include "./test_srf.hpp"  // IWYU pragma: associated
 
 #include <srf/metrics/counter.hpp>
+#include <srf/metrics/gauge.hpp>
 #include <srf/metrics/registry.hpp>
 
 #include <gtest/gtest.h>  // for AssertionResult, SuiteApiResolver, TestInfo, EXPECT_TRUE, Message, TEST_F, Test, TestFactoryImpl, TestPartResult
@@ -52,3 +53,15 @@ TEST_F(TestMetrics, ThroughputCounter)
     EXPECT_EQ(report[0].name, "test_counter");
     EXPECT_EQ(report[0].count, 43);
 }
+
+TEST_F(TestMetrics, Gauge)
+{
+    auto gauge = m_registry->make_gauge("srf_test_gauge", {{"name", "test_gauge"}});
+    gauge.set(42);
+    EXPECT_EQ(gauge.value(), 42);
+
+    // the same name and labels resolve to the same gauge
+    auto alias = m_registry->make_gauge("srf_test_gauge", {{"name", "test_gauge"}});
+    alias.set(7);
+    EXPECT_EQ(gauge.value(), 7);
+}